@@ -0,0 +1,30 @@
+#version 450
+
+// Depth pre-pass (see renderer::DeferredScreenData::DepthPrePass): position only vertex input, the rest of the vertex
+// isn't fetched. gl_Position is computed as the geometry pass' (invariant) for its EQUAL depth test
+
+layout (location = 0) in vec4 inPos;	// vk::Model::Vertex vec3 (w: 1) or PackedVertex snorm16 (model bounds)
+
+layout (binding = 0) uniform UBO
+{
+	mat4 projection;
+	mat4 view;
+} ubo;
+
+// per instance world matrices, position dequantization folded in (vk::Model::Data::instances, per frame),
+// indexed through the draws' firstInstance
+layout (std430, binding = 5) readonly buffer Instances
+{
+	mat4 world[];
+} instances;
+
+invariant gl_Position;
+
+void main()
+{
+	mat4 model = instances.world[gl_InstanceIndex];
+
+	vec4 worldPos = model * vec4(inPos.xyz, 1.0);
+
+	gl_Position = ubo.projection * ubo.view * worldPos;
+}
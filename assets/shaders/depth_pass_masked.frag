@@ -0,0 +1,18 @@
+#version 450
+
+// Depth pre-pass of the alpha masked materials (geometry pass vertex shader): alpha test only (vertex color
+// alpha is 1), no color output
+
+layout (binding = 1) uniform sampler2D samplerColor;
+
+layout (constant_id = 0) const bool ALPHA_MASK = false;
+layout (constant_id = 1) const float ALPHA_MASK_CUTOFF = 0.0;
+
+layout (location = 1) in vec2 inUV;
+
+void main()
+{
+	float alpha = texture(samplerColor, inUV).a;
+
+	if(ALPHA_MASK && alpha < ALPHA_MASK_CUTOFF) { discard; }
+}
@@ -0,0 +1,45 @@
+#version 450
+
+// Depth pre-pass, vk::Model::PackedVertex pulled from the geometry arena (see vk::Model::VertexFetch::PULLING): only
+// the position words are read. gl_Position is computed as the geometry pass' (invariant) for its EQUAL depth test
+
+#define PACKED_VERTEX_WORDS	6	// 24 bytes
+#define POSITION_WORDS			2	// split streams: stream 0 stride
+
+// split vertex streams (see vk::Model::VertexStreams::SPLIT): word offset of the attribute stream, 0: interleaved
+layout (constant_id = 0) const uint ATTRIBUTE_WORD_OFFSET = 0;
+
+layout (binding = 0) uniform UBO
+{
+	mat4 projection;
+	mat4 view;
+} ubo;
+
+// per instance world matrices, position dequantization folded in (vk::Model::Data::instances, per frame),
+// indexed through the draws' firstInstance
+layout (std430, binding = 5) readonly buffer Instances
+{
+	mat4 world[];
+} instances;
+
+// arena vertex buffer: position (snorm16 x4), normal & tangent (octahedral snorm16 x2), uv (half x2), color (unorm8 x4),
+// interleaved or split in a position (contiguous positions) & an attribute region
+layout (std430, binding = 6) readonly buffer Vertices
+{
+	uint words[];
+} vertices;
+
+invariant gl_Position;
+
+void main()
+{
+	uint base = uint(gl_VertexIndex) * (ATTRIBUTE_WORD_OFFSET != 0 ? POSITION_WORDS : PACKED_VERTEX_WORDS);
+
+	vec4 inPos = vec4(unpackSnorm2x16(vertices.words[base]), unpackSnorm2x16(vertices.words[base + 1]));
+
+	mat4 model = instances.world[gl_InstanceIndex];
+
+	vec4 worldPos = model * vec4(inPos.xyz, 1.0);
+
+	gl_Position = ubo.projection * ubo.view * worldPos;
+}
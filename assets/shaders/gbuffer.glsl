@@ -0,0 +1,73 @@
+// G-buffer access & lighting UBO shared by the lighting passes (#include "gbuffer.glsl", not compiled on its own)
+// GBUFFER_SUBPASS_INPUT: the g-buffer is read as input attachments of the current pixel (lighting subpass) instead of
+// sampled (see renderer::DeferredScreenData::PassLayout)
+
+layout (constant_id = 1) const bool COMPACT_GBUFFER = false;	// see renderer::DeferredScreenData::GBufferLayout
+
+#ifdef GBUFFER_SUBPASS_INPUT
+layout (input_attachment_index = 0, binding = 12) uniform subpassInput inputPosition;	// depth if compact
+layout (input_attachment_index = 1, binding = 13) uniform subpassInput inputNormal;
+layout (input_attachment_index = 2, binding = 14) uniform subpassInput inputAlbedo;
+#else
+layout (binding = 1) uniform sampler2D samplerPosition;	// depth if compact
+layout (binding = 2) uniform sampler2D samplerNormal;
+layout (binding = 3) uniform sampler2D samplerAlbedo;
+#endif
+
+layout (binding = 4) uniform UBO
+{
+	vec4	viewPos;
+	mat4	view;
+	mat4	invProjection;
+	uvec4	clusterGrid;		// xyz: cluster counts, w: light count
+	vec4	clusterParams;	// near, far, slice = log(depth) * z + w
+	vec2	screenSize;
+	uint	isHeatmap;
+	uint	tileCount;		// per bucket tile list stride
+	mat4	viewProjection;
+	mat4	invViewProjection;	// compact g-buffer: world position from depth
+} ubo;
+
+vec3 decodeOctahedral(vec2 _oct)
+{
+	vec3 dir = vec3(_oct, 1.0 - abs(_oct.x) - abs(_oct.y));
+	float t = max(-dir.z, 0.0);
+
+	dir.xy += mix(vec2(t), vec2(-t), greaterThanEqual(dir.xy, vec2(0.0)));
+
+	return normalize(dir);
+}
+
+// world position & normal (zero: background) from the raw position (depth if compact) & normal texels
+void decodeGBuffer(vec2 _fragCoord, vec4 _position, vec4 _normal, out vec3 _outPosition, out vec3 _outNormal)
+{
+	if(COMPACT_GBUFFER)
+	{
+		float depth = _position.r;
+		vec4 position = ubo.invViewProjection * vec4(_fragCoord / ubo.screenSize * 2.0 - 1.0, depth, 1.0);
+
+		_outPosition	= position.xyz / position.w;
+		_outNormal		= depth < 1.0 ? decodeOctahedral(_normal.xy * 2.0 - 1.0) : vec3(0.0);
+		return;
+	}
+
+	_outPosition	= _position.xyz;
+	_outNormal		= _normal.xyz;
+}
+
+#ifdef GBUFFER_SUBPASS_INPUT
+// current pixel
+void loadGBuffer(out vec3 _position, out vec3 _normal)
+{
+	decodeGBuffer(gl_FragCoord.xy, subpassLoad(inputPosition), subpassLoad(inputNormal), _position, _normal);
+}
+#else
+void loadGBuffer(ivec2 _pixel, out vec3 _position, out vec3 _normal)
+{
+	decodeGBuffer(
+		vec2(_pixel) + 0.5,
+		texelFetch(samplerPosition, _pixel, 0), texelFetch(samplerNormal, _pixel, 0),
+		_position, _normal
+	);
+}
+#endif
@@ -0,0 +1,49 @@
+#version 450
+
+// Compact g-buffer (see renderer::DeferredScreenData::GBufferLayout::COMPACT): no position target (reconstructed
+// from depth by the lighting), octahedral normal + roughness + metalness (RGB10A2), albedo (RGBA8, a: specular)
+
+layout (binding = 1) uniform sampler2D samplerColor;
+layout (binding = 2) uniform sampler2D samplerNormalMap;
+
+layout (constant_id = 0) const bool ALPHA_MASK = false;
+layout (constant_id = 1) const float ALPHA_MASK_CUTOFF = 0.0;
+layout (constant_id = 2) const float ROUGHNESS = 1.0;
+layout (constant_id = 3) const float METALNESS = 1.0;
+
+layout (location = 0) in vec3 inNormal;
+layout (location = 1) in vec2 inUV;
+layout (location = 2) in vec3 inColor;
+layout (location = 3) in vec3 inWorldPos;
+layout (location = 4) in vec4 inTangent;
+
+layout (location = 0) out vec4 outNormal;
+layout (location = 1) out vec4 outAlbedo;
+
+vec2 encodeOctahedral(vec3 _dir)
+{
+	vec2 oct = _dir.xy / (abs(_dir.x) + abs(_dir.y) + abs(_dir.z));
+
+	if(_dir.z < 0.0)
+	{
+		oct = (1.0 - abs(oct.yx)) * mix(vec2(-1.0), vec2(1.0), greaterThanEqual(oct, vec2(0.0)));
+	}
+
+	return oct;
+}
+
+void main()
+{
+	vec4 color = texture(samplerColor, inUV) * vec4(inColor, 1.0);
+
+	if(ALPHA_MASK && color.a < ALPHA_MASK_CUTOFF) { discard; }
+
+	// normal map (tangent space)
+	vec3 N = normalize(inNormal);
+	vec3 T = normalize(inTangent.xyz);
+	vec3 B = cross(N, T) * inTangent.w;
+	vec3 normal = normalize(mat3(T, B, N) * (texture(samplerNormalMap, inUV).xyz * 2.0 - 1.0));
+
+	outNormal = vec4(encodeOctahedral(normal) * 0.5 + 0.5, ROUGHNESS, METALNESS);
+	outAlbedo = color;
+}
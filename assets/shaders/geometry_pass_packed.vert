@@ -0,0 +1,57 @@
+#version 450
+
+// vk::Model::PackedVertex input (see vk::Model::VertexLayout::PACKED)
+
+layout (location = 0) in vec4 inPos;		// snorm16 (model bounds), w: tangent handedness
+layout (location = 1) in vec2 inUV;			// half
+layout (location = 2) in vec4 inColor;	// unorm8
+layout (location = 3) in vec2 inNormal;	// octahedral snorm16
+layout (location = 4) in vec2 inTangent;	// octahedral snorm16
+
+layout (binding = 0) uniform UBO
+{
+	mat4 projection;
+	mat4 view;
+} ubo;
+
+// per instance world matrices, position dequantization folded in (vk::Model::Data::instances, per frame),
+// indexed through the draws' firstInstance
+layout (std430, binding = 5) readonly buffer Instances
+{
+	mat4 world[];
+} instances;
+
+layout (location = 0) out vec3 outNormal;
+layout (location = 1) out vec2 outUV;
+layout (location = 2) out vec3 outColor;
+layout (location = 3) out vec3 outWorldPos;
+layout (location = 4) out vec4 outTangent;
+
+// bit identical to the depth pre-pass' (EQUAL depth test, see depth_pass.vert)
+invariant gl_Position;
+
+vec3 decodeOctahedral(vec2 _oct)
+{
+	vec3 dir = vec3(_oct, 1.0 - abs(_oct.x) - abs(_oct.y));
+	float t = max(-dir.z, 0.0);
+
+	dir.xy += mix(vec2(t), vec2(-t), greaterThanEqual(dir.xy, vec2(0.0)));
+
+	return normalize(dir);
+}
+
+void main()
+{
+	mat4 model = instances.world[gl_InstanceIndex];
+
+	vec4 worldPos = model * vec4(inPos.xyz, 1.0);
+	mat3 normalMtx = transpose(inverse(mat3(model)));
+
+	gl_Position = ubo.projection * ubo.view * worldPos;
+
+	outWorldPos	= worldPos.xyz;
+	outUV				= inUV;
+	outColor		= inColor.rgb;
+	outNormal		= normalMtx * decodeOctahedral(inNormal);
+	outTangent	= vec4(normalize(mat3(model) * decodeOctahedral(inTangent)), inPos.w < 0.0 ? -1.0 : 1.0);
+}
@@ -0,0 +1,77 @@
+#version 450
+
+// vk::Model::PackedVertex pulled from the geometry arena (see vk::Model::VertexFetch::PULLING): no vertex input
+// state, gl_VertexIndex already includes the draw's (arena wide) vertex offset
+
+#define PACKED_VERTEX_WORDS	6	// 24 bytes
+#define POSITION_WORDS			2	// split streams: stream 0 stride
+#define ATTRIBUTE_WORDS			4	// split streams: stream 1 stride
+
+// split vertex streams (see vk::Model::VertexStreams::SPLIT): word offset of the attribute stream, 0: interleaved
+layout (constant_id = 0) const uint ATTRIBUTE_WORD_OFFSET = 0;
+
+layout (binding = 0) uniform UBO
+{
+	mat4 projection;
+	mat4 view;
+} ubo;
+
+// per instance world matrices, position dequantization folded in (vk::Model::Data::instances, per frame),
+// indexed through the draws' firstInstance
+layout (std430, binding = 5) readonly buffer Instances
+{
+	mat4 world[];
+} instances;
+
+// arena vertex buffer: position (snorm16 x4), normal & tangent (octahedral snorm16 x2), uv (half x2), color (unorm8 x4),
+// interleaved or split in a position & an attribute region
+layout (std430, binding = 6) readonly buffer Vertices
+{
+	uint words[];
+} vertices;
+
+layout (location = 0) out vec3 outNormal;
+layout (location = 1) out vec2 outUV;
+layout (location = 2) out vec3 outColor;
+layout (location = 3) out vec3 outWorldPos;
+layout (location = 4) out vec4 outTangent;
+
+// bit identical to the depth pre-pass' (EQUAL depth test, see depth_pass.vert)
+invariant gl_Position;
+
+vec3 decodeOctahedral(vec2 _oct)
+{
+	vec3 dir = vec3(_oct, 1.0 - abs(_oct.x) - abs(_oct.y));
+	float t = max(-dir.z, 0.0);
+
+	dir.xy += mix(vec2(t), vec2(-t), greaterThanEqual(dir.xy, vec2(0.0)));
+
+	return normalize(dir);
+}
+
+void main()
+{
+	const bool isSplit = ATTRIBUTE_WORD_OFFSET != 0;
+
+	uint posBase	= uint(gl_VertexIndex) * (isSplit ? POSITION_WORDS : PACKED_VERTEX_WORDS);
+	uint attrBase	= isSplit ? ATTRIBUTE_WORD_OFFSET + uint(gl_VertexIndex) * ATTRIBUTE_WORDS : posBase + POSITION_WORDS;
+
+	vec4 inPos			= vec4(unpackSnorm2x16(vertices.words[posBase]), unpackSnorm2x16(vertices.words[posBase + 1]));
+	vec2 inNormal		= unpackSnorm2x16(vertices.words[attrBase]);
+	vec2 inTangent	= unpackSnorm2x16(vertices.words[attrBase + 1]);
+	vec2 inUV				= unpackHalf2x16(vertices.words[attrBase + 2]);
+	vec4 inColor		= unpackUnorm4x8(vertices.words[attrBase + 3]);
+
+	mat4 model = instances.world[gl_InstanceIndex];
+
+	vec4 worldPos = model * vec4(inPos.xyz, 1.0);
+	mat3 normalMtx = transpose(inverse(mat3(model)));
+
+	gl_Position = ubo.projection * ubo.view * worldPos;
+
+	outWorldPos	= worldPos.xyz;
+	outUV				= inUV;
+	outColor		= inColor.rgb;
+	outNormal		= normalMtx * decodeOctahedral(inNormal);
+	outTangent	= vec4(normalize(mat3(model) * decodeOctahedral(inTangent)), inPos.w < 0.0 ? -1.0 : 1.0);
+}
@@ -0,0 +1,60 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Light volume: shades the covered pixels with a single light, blended additively
+
+#include "gbuffer.glsl"
+
+struct Light
+{
+	vec4 position;	// w: radius
+	vec4 color;			// w: intensity
+};
+
+layout (std430, binding = 7) readonly buffer Lights
+{
+	Light lights[];
+};
+
+layout (location = 0) flat in uint inLightIndex;
+
+layout (location = 0) out vec4 outFragcolor;
+
+void main()
+{
+	const ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+	Light light = lights[inLightIndex];
+
+	vec3 fragPos, normal;
+	loadGBuffer(pixel, fragPos, normal);
+
+	// Vector to light
+	vec3 L = light.position.xyz - fragPos;
+	// Distance from light to fragment position
+	float dist = length(L);
+
+	// out of the light's range (in front of / behind the volume)
+	if(dist >= light.position.w) { discard; }
+
+	vec4 albedo = texelFetch(samplerAlbedo, pixel, 0);
+
+	vec3 N = normalize(normal);
+	vec3 V = normalize(ubo.viewPos.xyz - fragPos);
+	L = normalize(L);
+
+	// Attenuation, windowed to 0 at the radius
+	float window = clamp(1.0 - pow(dist / light.position.w, 4.0), 0.0, 1.0);
+	float atten = light.color.w / (pow(dist, 2.0) + 1.0) * window * window;
+
+	// Diffuse part
+	float NdotL = max(0.0, dot(N, L));
+	vec3 diff = light.color.rgb * albedo.rgb * NdotL * atten;
+
+	// Specular part
+	vec3 R = reflect(-L, N);
+	float NdotR = max(0.0, dot(R, V));
+	vec3 spec = light.color.rgb * albedo.a * pow(NdotR, 16.0) * atten;
+
+	outFragcolor = vec4(diff + spec, 0.0);
+}
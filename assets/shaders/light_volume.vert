@@ -0,0 +1,40 @@
+#version 450
+
+// Light volume: unit sphere (circumscribed mesh) instanced per light, scaled by its radius
+
+layout (location = 0) in vec3 inPos;
+
+layout (binding = 4) uniform UBO
+{
+	vec4	viewPos;
+	mat4	view;
+	mat4	invProjection;
+	uvec4	clusterGrid;		// xyz: cluster counts, w: light count
+	vec4	clusterParams;	// near, far, slice = log(depth) * z + w
+	vec2	screenSize;
+	uint	isHeatmap;
+	uint	tileCount;		// per bucket tile list stride
+	mat4	viewProjection;
+} ubo;
+
+struct Light
+{
+	vec4 position;	// w: radius
+	vec4 color;			// w: intensity
+};
+
+layout (std430, binding = 7) readonly buffer Lights
+{
+	Light lights[];
+};
+
+layout (location = 0) flat out uint outLightIndex;
+
+void main()
+{
+	Light light = lights[gl_InstanceIndex];
+
+	outLightIndex = uint(gl_InstanceIndex);
+
+	gl_Position = ubo.viewProjection * vec4(light.position.xyz + inPos * light.position.w, 1.0);
+}
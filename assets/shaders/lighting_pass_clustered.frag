@@ -0,0 +1,97 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Deferred lighting pass: shades each pixel with the light list of its cluster only
+// (written by light_culling.comp)
+
+#define MAX_CLUSTER_LIGHTS 128u
+
+#include "gbuffer.glsl"
+
+struct Light
+{
+	vec4 position;	// w: radius
+	vec4 color;			// w: intensity
+};
+
+layout (std430, binding = 7) readonly buffer Lights
+{
+	Light lights[];
+};
+
+layout (std430, binding = 8) readonly buffer Clusters
+{
+	uint data[];
+} clusters;
+
+layout (location = 0) in vec2 inUV;
+
+layout (location = 0) out vec4 outFragcolor;
+
+vec3 getHeatmap(float _t)
+{
+	return clamp(vec3(_t * 3.0, _t * 3.0 - 1.0, _t * 3.0 - 2.0), 0.0, 1.0);
+}
+
+void main()
+{
+	const ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+	vec3 fragPos, normal;
+	loadGBuffer(pixel, fragPos, normal);
+	vec4 albedo = texelFetch(samplerAlbedo, pixel, 0);
+
+	// cluster of the pixel
+	const uvec3 grid = ubo.clusterGrid.xyz;
+	const uint clusterCount = grid.x * grid.y * grid.z;
+
+	float depth = max(-(ubo.view * vec4(fragPos, 1.0)).z, ubo.clusterParams.x);
+	uint slice = uint(clamp(log(depth) * ubo.clusterParams.z + ubo.clusterParams.w, 0.0, float(grid.z - 1)));
+	uvec2 tile = min(uvec2(gl_FragCoord.xy / ubo.screenSize * vec2(grid.xy)), grid.xy - 1u);
+
+	uint cluster = tile.x + grid.x * (tile.y + grid.y * slice);
+	uint count = min(clusters.data[cluster], MAX_CLUSTER_LIGHTS);
+	uint listOffset = clusterCount + cluster * MAX_CLUSTER_LIGHTS;
+
+	if(ubo.isHeatmap != 0)
+	{
+		outFragcolor = vec4(getHeatmap(float(count) / float(MAX_CLUSTER_LIGHTS / 4)), 1.0);
+		return;
+	}
+
+	#define ambient 0.0
+
+	// Ambient part
+	vec3 fragcolor = albedo.rgb * ambient;
+
+	vec3 N = normalize(normal);
+	vec3 V = normalize(ubo.viewPos.xyz - fragPos);
+
+	for(uint i = 0; i < count; ++i)
+	{
+		Light light = lights[clusters.data[listOffset + i]];
+
+		// Vector to light
+		vec3 L = light.position.xyz - fragPos;
+		// Distance from light to fragment position
+		float dist = length(L);
+		L = normalize(L);
+
+		// Attenuation, windowed to 0 at the radius (the culling range)
+		float window = clamp(1.0 - pow(dist / light.position.w, 4.0), 0.0, 1.0);
+		float atten = light.color.w / (pow(dist, 2.0) + 1.0) * window * window;
+
+		// Diffuse part
+		float NdotL = max(0.0, dot(N, L));
+		vec3 diff = light.color.rgb * albedo.rgb * NdotL * atten;
+
+		// Specular part
+		vec3 R = reflect(-L, N);
+		float NdotR = max(0.0, dot(R, V));
+		vec3 spec = light.color.rgb * albedo.a * pow(NdotR, 16.0) * atten;
+
+		fragcolor += diff + spec;
+	}
+
+	outFragcolor = vec4(fragcolor, 1.0);
+}
@@ -0,0 +1,14 @@
+#version 450
+
+// Compute lighting resolve: copies the lit image (written by lighting_pass.comp) to the swapchain
+
+layout (binding = 11) uniform sampler2D samplerLit;
+
+layout (location = 0) in vec2 inUV;
+
+layout (location = 0) out vec4 outFragcolor;
+
+void main()
+{
+	outFragcolor = vec4(texture(samplerLit, inUV).rgb, 1.0);
+}
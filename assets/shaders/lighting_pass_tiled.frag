@@ -0,0 +1,105 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Deferred lighting pass, specialized per tile bucket (see tile_classification.comp):
+// UNLIT: ambient only, SIMPLE: diffuse only, COMPLEX: background test + diffuse & specular
+
+#define UNLIT		1
+#define SIMPLE	2
+#define COMPLEX	3
+
+#define MAX_CLUSTER_LIGHTS 128u
+
+layout (constant_id = 0) const uint TILE_BUCKET = COMPLEX;
+
+#include "gbuffer.glsl"
+
+struct Light
+{
+	vec4 position;	// w: radius
+	vec4 color;			// w: intensity
+};
+
+layout (std430, binding = 7) readonly buffer Lights
+{
+	Light lights[];
+};
+
+layout (std430, binding = 8) readonly buffer Clusters
+{
+	uint data[];
+} clusters;
+
+layout (location = 0) in vec2 inUV;
+
+layout (location = 0) out vec4 outFragcolor;
+
+const vec3 bucketColors[4] = vec3[](
+	vec3(0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 1.0, 0.0), vec3(1.0, 0.0, 0.0)
+);
+
+void main()
+{
+	const ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+	vec3 fragPos, normal;
+	loadGBuffer(pixel, fragPos, normal);
+	vec4 albedo = texelFetch(samplerAlbedo, pixel, 0);
+
+	// background pixel of a partially covered tile
+	if(TILE_BUCKET == COMPLEX && dot(normal, normal) <= 0.25) { discard; }
+
+	#define ambient 0.0
+
+	// Ambient part
+	vec3 fragcolor = albedo.rgb * ambient;
+
+	if(TILE_BUCKET != UNLIT)
+	{
+		// cluster of the pixel
+		const uvec3 grid = ubo.clusterGrid.xyz;
+		const uint clusterCount = grid.x * grid.y * grid.z;
+
+		float depth = max(-(ubo.view * vec4(fragPos, 1.0)).z, ubo.clusterParams.x);
+		uint slice = uint(clamp(log(depth) * ubo.clusterParams.z + ubo.clusterParams.w, 0.0, float(grid.z - 1)));
+		uvec2 tile = min(uvec2(gl_FragCoord.xy / ubo.screenSize * vec2(grid.xy)), grid.xy - 1u);
+
+		uint cluster = tile.x + grid.x * (tile.y + grid.y * slice);
+		uint count = min(clusters.data[cluster], MAX_CLUSTER_LIGHTS);
+		uint listOffset = clusterCount + cluster * MAX_CLUSTER_LIGHTS;
+
+		vec3 N = normalize(normal);
+		vec3 V = normalize(ubo.viewPos.xyz - fragPos);
+
+		for(uint i = 0; i < count; ++i)
+		{
+			Light light = lights[clusters.data[listOffset + i]];
+
+			// Vector to light
+			vec3 L = light.position.xyz - fragPos;
+			// Distance from light to fragment position
+			float dist = length(L);
+			L = normalize(L);
+
+			// Attenuation, windowed to 0 at the radius (the culling range)
+			float window = clamp(1.0 - pow(dist / light.position.w, 4.0), 0.0, 1.0);
+			float atten = light.color.w / (pow(dist, 2.0) + 1.0) * window * window;
+
+			// Diffuse part
+			float NdotL = max(0.0, dot(N, L));
+			fragcolor += light.color.rgb * albedo.rgb * NdotL * atten;
+
+			// Specular part
+			if(TILE_BUCKET == COMPLEX)
+			{
+				vec3 R = reflect(-L, N);
+				float NdotR = max(0.0, dot(R, V));
+				fragcolor += light.color.rgb * albedo.a * pow(NdotR, 16.0) * atten;
+			}
+		}
+	}
+
+	if(ubo.isHeatmap != 0) { fragcolor = mix(fragcolor, bucketColors[TILE_BUCKET], 0.5); }
+
+	outFragcolor = vec4(fragcolor, 1.0);
+}
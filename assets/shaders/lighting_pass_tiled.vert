@@ -0,0 +1,44 @@
+#version 450
+
+// Classified tile quads: 6 vertices per instance, one instance per tile of the bucket's list
+// (written by tile_classification.comp)
+
+#define TILE_SIZE			16
+#define BUCKET_COUNT	4
+
+layout (constant_id = 0) const uint TILE_BUCKET = 3;
+
+layout (binding = 4) uniform UBO
+{
+	vec4	viewPos;
+	mat4	view;
+	mat4	invProjection;
+	uvec4	clusterGrid;		// xyz: cluster counts, w: light count
+	vec4	clusterParams;	// near, far, slice = log(depth) * z + w
+	vec2	screenSize;
+	uint	isHeatmap;
+	uint	tileCount;		// per bucket tile list stride
+} ubo;
+
+layout (std430, binding = 9) readonly buffer Tiles
+{
+	uvec4	draws[BUCKET_COUNT];
+	uint	lists[];
+} tiles;
+
+layout (location = 0) out vec2 outUV;
+
+const vec2 corners[6] = vec2[](
+	vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(0.0, 1.0),
+	vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
+void main()
+{
+	uint tile = tiles.lists[TILE_BUCKET * ubo.tileCount + gl_InstanceIndex];
+
+	vec2 pixel = min((vec2(tile & 0xFFFF, tile >> 16) + corners[gl_VertexIndex]) * TILE_SIZE, ubo.screenSize);
+
+	outUV = pixel / ubo.screenSize;
+	gl_Position = vec4(outUV * 2.0 - 1.0, 0.0, 1.0);
+}
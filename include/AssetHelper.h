@@ -4,6 +4,10 @@
 
 #include "vk/vk.h"
 #include "_constants.h"
+#include "SceneCache.h"
+#include "MeshOptimizer.h"
+#include "PvsBaker.h"
+#include "StaticBatcher.h"
 
 class AssetHelper
 {
@@ -28,6 +32,13 @@ class AssetHelper
 
 	using NodePtr					= std::shared_ptr<Node>;
 
+	// glTF mesh index -> first node loading it, (instance node, source node) for the nodes reusing it
+	struct MeshNodes
+	{
+		std::vector<NodePtr>									sources;
+		std::vector<std::pair<NodePtr, NodePtr>>	instances;
+	};
+
 	enum class IdxComponentType : int
 	{
 		UNSIGNED_INT		= TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT,
@@ -45,24 +56,43 @@ class AssetHelper
 			const std::string &_textureDir	= constants::TEXTURES_PATH
 		) noexcept;
 
+		// device-free part of the load (glTF -> flattened geometry, nodes & materials), also used by the asset cooker
+		static void loadScene(
+			const std::string					&_fileName,
+			float 										_scale,
+			vk::Model::Data						&_modelData,
+			std::vector<std::string>	&_textureUris,
+			std::vector<std::string>	&_dependencies
+		) noexcept;
+
 	private:
 		static void loadModel(
 			const std::string	&_fileName,
 			gltfModel					&_model
 		) noexcept;
 
+		static void getUris(
+			const gltfModel						&_model,
+			std::vector<std::string>	&_textureUris,
+			std::vector<std::string>	&_dependencies
+		) noexcept;
+
 		static void loadTextures	(
-			const DevicePtr		&_device,
-			const gltfModel		&_model,
-			const std::string	&_textureDir,
-			vk::Texture::Data	&_textureData
+			const DevicePtr									&_device,
+			const std::vector<std::string>	&_textureUris,
+			const std::string								&_textureDir,
+			vk::Texture::Data								&_textureData
 		)	noexcept;
 
 		static void loadMaterials	(
 			gltfModel								&_model,
-			const vk::Texture::Data	&_textureData,
 			vk::Model::Data					&_data
 		)	noexcept;
+		static void dedupMaterials(vk::Model::Data &_data) noexcept;
+		static void setMaterialDescriptors(
+			const vk::Texture::Data	&_textureData,
+			vk::Model::Data					&_data
+		) noexcept;
 		static void loadNodes(
 
 		) noexcept;
@@ -71,8 +101,10 @@ class AssetHelper
 			const gltfModel				&_model,
 			float 								_scale,
 			vk::Model::Data				&_data,
+			MeshNodes							&_meshNodes,
 			const NodePtr					&_parent = nullptr
 		) noexcept;
+		static void shareMeshes(const MeshNodes &_meshNodes) noexcept;
 		static std::shared_ptr<Node> createNode(
 			const gltfNode	&_node,
 			const NodePtr		&_parent,
@@ -63,6 +63,8 @@ class Camera
 
 	public:
 		inline Data getData()		const noexcept { return m_data; }
+		inline float getZNear()	const noexcept { return m_data.m_zNear; }
+		inline float getZFar()	const noexcept { return m_data.m_zFar; }
 		inline bool isUpdated() const noexcept { return m_data.isUpdated; }
 		inline bool isMoving(bool _isKeyOnly = false)	const noexcept
 		{
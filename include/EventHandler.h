@@ -35,7 +35,13 @@ class EventHandler
 				int _key, int _scanCode, int _action, int _mods
 			)
 			{
-				auto &camera = static_cast<TRenderer*>(glfwGetWindowUserPointer(_window))->getCamera();
+				auto *renderer = static_cast<TRenderer*>(glfwGetWindowUserPointer(_window));
+				auto &camera = renderer->getCamera();
+
+				// lights per cluster heatmap
+				if(_key == GLFW_KEY_H && _action == GLFW_PRESS) { renderer->toggleLightHeatmap(); }
+				// culling stats
+				if(_key == GLFW_KEY_C && _action == GLFW_PRESS) { renderer->toggleCullingStats(); }
 
 				switch (_action)
 				{
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "vk/vk.h"
+
+// Load/cook time index & vertex reordering (per primitive):
+// Tipsify vertex cache optimization, cluster based overdraw reordering & vertex fetch reordering,
+// plus LOD chain generation (quadric error edge collapse) & meshlet (cluster) decomposition
+
+class MeshOptimizer
+{
+	using Vertex		= vk::Model::Vertex;
+	using Primitive	= vk::Model::Primitive;
+	using NodePtr		= vk::Model::NodePtr;
+
+	public:
+		inline static const uint32_t	s_cacheSize				= 16;		// post-transform FIFO cache size (simulated & targeted)
+		inline static const float		s_lodReduction		= 0.5f;	// target index count ratio between consecutive LODs
+		inline static const uint32_t	s_lodMinIdxCount	= 96;		// primitives (or LODs) below this aren't simplified further
+
+		struct CacheStats
+		{
+			uint32_t	triangleCount	= 0;
+			uint32_t	vertexCount		= 0;
+			uint32_t	missCount			= 0;
+
+			float getACMR() const noexcept { return triangleCount	? float(missCount) / float(triangleCount)	: 0.0f; }
+			float getATVR() const noexcept { return vertexCount		? float(missCount) / float(vertexCount)		: 0.0f; }
+
+			CacheStats &operator+=(const CacheStats &_stats) noexcept
+			{
+				triangleCount	+= _stats.triangleCount;
+				vertexCount		+= _stats.vertexCount;
+				missCount			+= _stats.missCount;
+
+				return *this;
+			}
+		};
+
+	public:
+		static void optimize(vk::Model::Data &_data) noexcept;
+		static void generateLods(vk::Model::Data &_data) noexcept;
+		static void buildMeshlets(vk::Model::Data &_data) noexcept;
+
+		// returns the max. (model space) deviation of the simplified surface
+		static float simplify(
+			const uint32_t				*_indices,
+			size_t								_idxCount,
+			const Vertex					*_vertices,
+			uint32_t							_vtxCount,
+			size_t								_targetIdxCount,
+			std::vector<uint32_t>	&_outIndices
+		) noexcept;
+
+		static void optimizeVertexCache(
+			uint32_t							*_indices,
+			size_t								_idxCount,
+			uint32_t							_vtxCount,
+			std::vector<uint32_t>	&_clusters,	// first triangle of each cluster (Tipsify hard boundaries)
+			uint32_t							_cacheSize = s_cacheSize
+		) noexcept;
+
+		static void optimizeOverdraw(
+			uint32_t										*_indices,
+			size_t											_idxCount,
+			const Vertex								*_vertices,
+			const std::vector<uint32_t>	&_clusters
+		) noexcept;
+
+		static void optimizeVertexFetch(
+			uint32_t	*_indices,
+			size_t		_idxCount,
+			Vertex		*_vertices,
+			uint32_t	_vtxCount
+		) noexcept;
+
+		static CacheStats analyzeVertexCache(
+			const uint32_t	*_indices,
+			size_t					_idxCount,
+			uint32_t				_vtxCount,
+			uint32_t				_cacheSize = s_cacheSize
+		) noexcept;
+
+	private:
+		// area weighted plane quadric (Garland & Heckbert)
+		struct Quadric
+		{
+			float a00 = 0.0f, a11 = 0.0f, a22 = 0.0f;
+			float a10 = 0.0f, a20 = 0.0f, a21 = 0.0f;
+			float b0	= 0.0f, b1	= 0.0f, b2	= 0.0f;
+			float c		= 0.0f;
+			float w		= 0.0f;
+
+			static Quadric fromPlane(const glm::vec3 &_normal, float _distance, float _weight) noexcept;
+
+			Quadric &operator+=(const Quadric &_quadric) noexcept;
+
+			float getError(const glm::vec3 &_pos) const noexcept; // squared distance (weight normalized)
+		};
+
+		static int32_t getNextVertex(
+			const std::vector<uint32_t>	&_candidates,
+			const std::vector<uint32_t>	&_cacheTimes,
+			const std::vector<uint32_t>	&_liveTriCounts,
+			std::vector<uint32_t>				&_deadEnds,
+			uint32_t										&_cursor,
+			uint32_t										_timeStamp,
+			uint32_t										_cacheSize,
+			bool												&_isDeadEnd
+		) noexcept;
+};
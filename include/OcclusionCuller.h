@@ -0,0 +1,88 @@
+#pragma once
+
+#include "SceneBvh.h"
+
+// CPU (software) occlusion culling:
+// the largest opaque primitives (LOD0, pre-transformed) are rasterized into a low resolution depth buffer (tile binned,
+// tiles rasterized in parallel, 4 pixels per SSE op), then the BVH visible primitives' world AABBs are tested against
+// its per block max. depth (conservative: anything touching the near plane is visible).
+// Static occluders only: their world space triangles are baked by addOccluders, like the BVH's bounds (see SceneBvh).
+
+class OcclusionCuller
+{
+	using Aabb = SceneBvh::Aabb;
+
+	public:
+		inline static const uint32_t	s_width				= 320;
+		inline static const uint32_t	s_height			= 192;
+		inline static const uint32_t	s_tileWidth		= 64;
+		inline static const uint32_t	s_tileHeight	= 32;
+		inline static const uint32_t	s_blockSize		= 8;	// max. depth (HiZ) block
+		inline static const uint32_t	s_tileCountX	= s_width		/ s_tileWidth;
+		inline static const uint32_t	s_tileCountY	= s_height	/ s_tileHeight;
+
+		inline static const uint32_t	s_maxOccluders				= 64;		// per model
+		inline static const uint32_t	s_maxOccluderTriangles	= 2048;	// per occluder (LOD0 above this: skipped)
+		inline static const uint32_t	s_maxThreads						= 4;		// tile rasterization
+
+		static_assert(s_width % s_tileWidth == 0 && s_height % s_tileHeight == 0, "Tiles should cover the depth buffer");
+		static_assert(s_tileWidth % s_blockSize == 0 && s_tileHeight % s_blockSize == 0, "Blocks should cover the tiles");
+		static_assert(s_tileWidth % 4 == 0, "Tile rows are rasterized 4 pixels at a time");
+
+		struct Stats
+		{
+			uint32_t	occluderTriangleCount	= 0;
+			uint32_t	testedCount						= 0;
+			uint32_t	culledCount						= 0;
+			float			rasterTime						= 0.0f;	// ms
+			float			testTime							= 0.0f;	// ms
+		};
+
+		bool isEnabled = true;
+
+	public:
+		// ONLY before Model::setup (primitive index ranges are still the CPU side ones)
+		void addOccluders(const vk::Model::Data &_data) noexcept;
+
+		void render(const glm::mat4 &_viewProj) noexcept;
+
+		// moves the occluded refs from _visible to (the end of) _occluded
+		void cull(
+			const SceneBvh				&_bvh,
+			std::vector<uint32_t>	&_visible,
+			std::vector<uint32_t>	&_occluded
+		) noexcept;
+
+		bool isOccluded(const Aabb &_bounds) const noexcept;
+
+		inline const Stats &getStats() const noexcept { return m_stats; }
+
+	private:
+		struct Occluder
+		{
+			std::vector<glm::vec3>	positions;	// world space triangle list
+			Aabb										bounds;
+		};
+
+		struct ScreenTriangle
+		{
+			glm::vec2		v0, v1, v2;		// pixels, counter clockwise
+			glm::vec3		depthPlane;		// depth = x * a + y * b + c
+			glm::ivec4	rect;					// pixel bounds [min, max)
+		};
+
+	private:
+		void setupTriangles() noexcept;
+		void rasterizeTile(uint32_t _tile) noexcept;
+
+	private:
+		std::vector<Occluder>								m_occluders;
+		std::vector<ScreenTriangle>					m_triangles;
+		std::vector<std::vector<uint32_t>>	m_tileBins;
+
+		std::vector<float>									m_depth;
+		std::vector<float>									m_blockMaxDepth;
+
+		glm::mat4														m_viewProj = glm::mat4(1.0f);
+		Stats																m_stats;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "vk/vk.h"
+
+// Cook time potentially visible set bake (static scenes):
+// the scene bounds are split into cells, then per cell & primitive, segments from sample points inside the cell to
+// random points on the primitive are cast against the opaque geometry (uniform grid, any hit); the primitive is
+// potentially visible from the cell as soon as one segment is unblocked.
+
+class PvsBaker
+{
+	using Vertex		= vk::Model::Vertex;
+	using Primitive	= vk::Model::Primitive;
+	using NodePtr		= vk::Model::NodePtr;
+
+	public:
+		inline static const uint32_t	s_maxCellCount		= 1024;	// cells over the scene bounds (cubic-ish cells)
+		inline static const uint32_t	s_originsPerCell	= 16;		// segment origins per cell (8 corners + jittered)
+		inline static const uint32_t	s_raysPerOrigin		= 4;		// segments per origin & primitive
+		inline static const uint32_t	s_maxGridRes			= 128;	// ray casting grid (per axis)
+
+	public:
+		static void bake(vk::Model::Data &_data) noexcept;
+
+	private:
+		struct Bounds
+		{
+			glm::vec3 min = glm::vec3( std::numeric_limits<float>::max());
+			glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+		};
+
+		struct Triangle
+		{
+			glm::vec3	v0, e1, e2;	// world space (v0, v1 - v0, v2 - v0)
+			uint32_t	primitive;
+		};
+
+		// uniform grid over the opaque triangles (CSR cell lists)
+		struct TriangleGrid
+		{
+			glm::vec3							origin;
+			glm::vec3							cellSize;
+			glm::ivec3						cellCounts;
+			std::vector<uint32_t>	cellStarts;
+			std::vector<uint32_t>	triangles;
+		};
+
+	private:
+		static void buildGrid(
+			const std::vector<Triangle>	&_triangles,
+			const std::vector<uint8_t>	&_isOccluder,	// per primitive
+			const glm::vec3							&_min,
+			const glm::vec3							&_max,
+			TriangleGrid								&_grid
+		) noexcept;
+
+		// any triangle of another primitive than _ignore in (_from, _to)?
+		static bool isBlocked(
+			const std::vector<Triangle>	&_triangles,
+			const TriangleGrid					&_grid,
+			const glm::vec3							&_from,
+			const glm::vec3							&_to,
+			uint32_t										_ignore
+		) noexcept;
+};
@@ -38,11 +38,16 @@ namespace renderer
 			void beginFrame()								noexcept;
 			void endFrame()									noexcept;
 
+			// _drawCallback: replaces the full-screen triangle (pipeline & sets bound), _renderPass & _framebuffers (per
+			// swapchain image): replace the swapchain ones (same attachments & clear values, e.g. another depth)
 			void setupCommands(
-				const VkPipeline				&_pipeline,
-				const VkPipelineLayout	&_pipelineLayout,
-				const VkDescriptorSet		*_descSets,
-				uint32_t								_descSetCount = 1
+				const VkPipeline															&_pipeline,
+				const VkPipelineLayout												&_pipelineLayout,
+				const VkDescriptorSet													*_descSets,
+				uint32_t																			_descSetCount = 1,
+				const std::function<void(const VkCommandBuffer&)>	&_drawCallback = nullptr,
+				const VkRenderPass														&_renderPass = VK_NULL_HANDLE,
+				const std::vector<VkFramebuffer>							*_framebuffers = nullptr
 			) noexcept;
 
 			template<
@@ -52,6 +57,7 @@ namespace renderer
 			>
 			void loadAsset(
 				vk::Buffer::Data<type, bufferCount>	&_bufferData,
+				vk::GeometryArena::Data							&_arena,
 				float 															_scale = 1.0f
 			) noexcept
 			{
@@ -66,7 +72,8 @@ namespace renderer
 					model, modelTextures,
 					_scale, constants::TEXTURES_PATH + modelTexDir + "/"
 				);
-				vk::Model::setup(m_device, model, _bufferData);
+				m_screenData.occlusionCuller.addOccluders(model);	// CPU index ranges: before the GPU upload
+				vk::Model::setup(m_device, model, _bufferData, _arena);
 			}
 
 			template<typename TScreenData>
@@ -100,16 +107,18 @@ namespace renderer
 			virtual void setupBaseCommands()  noexcept = 0;
 			virtual void setupCommands()			noexcept = 0;
 			virtual void onWindowResize()			noexcept {};
+			virtual void onSwapchainRecreate()	noexcept {};	// screen sized resources, before the commands are re-recorded
 			virtual void draw()								noexcept;
 			virtual void submitSceneToQueue()	noexcept;
 
 		private:
 			void setupRenderPassCommands(
-				const VkCommandBuffer		&_cmdBuffer,
-				const VkPipeline				&_pipeline,
-				const VkPipelineLayout	&_pipelineLayout,
-				const VkDescriptorSet		*_descSets,
-				uint32_t								_descSetCount = 1
+				const VkCommandBuffer													&_cmdBuffer,
+				const VkPipeline															&_pipeline,
+				const VkPipelineLayout												&_pipelineLayout,
+				const VkDescriptorSet													*_descSets,
+				uint32_t																			_descSetCount = 1,
+				const std::function<void(const VkCommandBuffer&)>	&_drawCallback = nullptr
 			)	noexcept;
 
 		private:
@@ -123,6 +132,9 @@ namespace renderer
 		public:
 			Camera &getCamera() noexcept { return m_screenData.camera; }
 
+			void toggleLightHeatmap() noexcept { m_screenData.isLightHeatmap = !m_screenData.isLightHeatmap; }
+			void toggleCullingStats() noexcept { m_screenData.isCullingStats = !m_screenData.isCullingStats; }
+
 		protected:
 			ScreenData m_screenData;
 
@@ -22,12 +22,21 @@ namespace renderer
 		private:
 			void initCmdBuffer()				noexcept;
 			void initSyncPrimitive()		noexcept;
+			void initStatsQuery()				noexcept;
 
 			void setupRenderPass()			noexcept;
+			void setupVolumeRenderPass()	noexcept;
 			void setupFramebuffer()			noexcept;
+			vk::Array<VkImageView, DeferredScreenData::s_fbAttCount> getGBufferViews() const noexcept;
+			void setupSwapchainFramebuffers()	noexcept;
+			void setupTiles()						noexcept;
+			void setupFrameGraph()			noexcept;
 			void setupUBOs()						noexcept;
+			void setupLights()					noexcept;
+			void setupLightVolumes()		noexcept;
 
 			void setupDescriptors()			noexcept;
+			void updateCompositionDescriptors()	noexcept;
 			void setupDescPool(
 				uint32_t _materialCount,
 				uint32_t _maxSetCount
@@ -38,7 +47,27 @@ namespace renderer
 			void setupRenderPassCommands(
 				const VkCommandBuffer &_cmdBuffer
 			)	noexcept;
+			void recordOffscreenCommands()	noexcept;
+			void recordMeshletCulling(
+				const VkCommandBuffer &_cmdBuffer
+			)	noexcept;
+			void recordSubpassCommands()		noexcept;
+			void recordLightCulling(
+				const VkCommandBuffer &_cmdBuffer
+			)	noexcept;
+			void recordTileClassification(
+				const VkCommandBuffer &_cmdBuffer
+			)	noexcept;
+			void recordComputeLighting(
+				const VkCommandBuffer &_cmdBuffer
+			)	noexcept;
+			void resetStatsQuery(
+				const VkCommandBuffer &_cmdBuffer
+			)	noexcept;
+			void updateVisibility()					noexcept;
+			void logOverdrawStats()					noexcept;
 			void submitOffscreenToQueue() noexcept;
+			void destroyScreenTargets()		noexcept;
 
 			void setOffscreenUBOData(DeferredScreenData::OffScreenUBO &_data) 		noexcept;
 			void setCompositionUBOData(DeferredScreenData::CompositionUBO &_data)	noexcept;
@@ -49,6 +78,7 @@ namespace renderer
 			void setupBaseCommands()	noexcept override;
 			void setupCommands()			noexcept override;
 			void onWindowResize()			noexcept override;
+			void onSwapchainRecreate()	noexcept override;
 			void submitSceneToQueue()	noexcept override;
 			void draw()								noexcept override;
 
@@ -91,9 +121,13 @@ namespace renderer
 					? vk::toInt(type)
 					: _index;
 				auto &pipelineData = m_deferredScreenData.pipelineData;
-				const auto &renderPass = isComposition
-					? getRenderPass(m_screenData)
-					: getRenderPass(m_deferredScreenData);
+				// subpasses: the composition is the second subpass of the g-buffer render pass, light volumes: depth tested
+				const auto isBasePass = isComposition && !DeferredScreenData::isSubpassLayout();
+				const auto &renderPass = !isBasePass
+					? getRenderPass(m_deferredScreenData)
+					: DeferredScreenData::s_lightingMode == DeferredScreenData::LightingMode::LIGHT_VOLUMES
+					? m_deferredScreenData.volumeRenderPass
+					: getRenderPass(m_screenData);
 
 				vk::Pipeline::createGraphicsPipeline(
 					m_device->getData().logicalDevice,
@@ -101,7 +135,8 @@ namespace renderer
 					pipelineData.cache, pipelineData.layouts[0],
 					_shaderStages,
 					_psoData,
-					pipelineData.pipelines[index]
+					pipelineData.pipelines[index],
+					isComposition && !isBasePass ? 1 : 0
 				);
 			}
 
@@ -109,5 +144,6 @@ namespace renderer
 			DeferredScreenData m_deferredScreenData;
 
 			USE_DESC_SET_LAYOUT_BINDING_STRUCT(DeferredScreenData, DEFERRED_SHADING)
+			USE_DESC_SET_LAYOUT_BINDING_STRUCT(DeferredScreenData, MESHLET_CULLING)
 	};
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "VkData.h"
 #include "../Camera.h"
+#include "../SceneBvh.h"
+#include "../OcclusionCuller.h"
 
 // CPU / GAPI Data
 
@@ -21,10 +23,14 @@ namespace renderer
 		Camera													camera;
 		ModelDataList										modelsData;
 		TextureDataList									texturesData;
+		SceneBvh												bvh;	// over all modelsData primitives
+		OcclusionCuller									occlusionCuller;
 
 		bool														isInited 	= false;
 		bool														isPaused	= false;
 		bool														isResized	= false;
+		bool														isLightHeatmap	= false;	// lights per cluster instead of the shading
+		bool														isCullingStats	= false;	// per frame culling stats (trace log)
 
 		private:
 			using FramebufferData = vk::Framebuffer::Data<
@@ -44,14 +50,118 @@ namespace renderer
 		using Desc					= vk::Descriptor;
 		using AttTag				= vk::Attachment::Tag;
 
-		inline static const uint16_t s_fbAttCount		= vk::toInt(AttTag::Color::_count_) + 1;
+		using AttColor			= AttTag::Color;
+
+		// g-buffer targets (compile time)
+		enum class GBufferLayout : uint16_t
+		{
+			FULL		= 0,	// position RGBA16F, normal RGBA16F, albedo RGBA8 (20 bytes per pixel + depth)
+			COMPACT	= 1		// position from depth, octahedral normal + roughness + metalness RGB10A2, albedo RGBA8
+										// (8 bytes per pixel + depth)
+		};
+
+		inline static const GBufferLayout s_gBufferLayout = GBufferLayout::FULL;
+
+		inline static constexpr bool isCompactGBuffer() noexcept { return s_gBufferLayout == GBufferLayout::COMPACT; }
+
+		// geometry & lighting passes (compile time)
+		enum class PassLayout : uint16_t
+		{
+			SEPARATE	= 0,	// g-buffer render pass & submission, then the composition in the swapchain pass (Base)
+			SUBPASSES	= 1		// one render pass on the swapchain image: g-buffer subpass, then the lighting subpass reading
+										// it as input attachments (transient: may never leave tile memory), clustered lighting only
+		};
+
+		inline static const PassLayout s_passLayout = PassLayout::SEPARATE;
+
+		inline static constexpr bool isSubpassLayout() noexcept { return s_passLayout == PassLayout::SUBPASSES; }
+
+		// frame submission of the SEPARATE pass layout (compile time)
+		enum class SubmitMode : uint16_t
+		{
+			SEPARATE	= 0,	// offscreen then composition vkQueueSubmit, chained by a semaphore
+			SINGLE		= 1		// both command buffers in one vkQueueSubmit, chained by a pipeline barrier
+		};
+
+		inline static const SubmitMode s_submitMode = SubmitMode::SEPARATE;
+
+		inline static constexpr bool isSingleSubmit() noexcept { return s_submitMode == SubmitMode::SINGLE; }
+
+		// depth only draws ahead of the g-buffer draws, in the same subpass (compile time)
+		enum class DepthPrePass : uint16_t
+		{
+			OFF	= 0,
+			ON	= 1		// position only depth pipelines (alpha tested for masked materials), then the g-buffer pipelines test
+								// EQUAL without depth writes: the g-buffer targets are written once per pixel, not per overdraw
+		};
+
+		inline static const DepthPrePass s_depthPrePass = DepthPrePass::OFF;
+
+		inline static constexpr bool isDepthPrePass() noexcept { return s_depthPrePass == DepthPrePass::ON; }
+
+		// fragment shader invocations of the geometry draws (overdraw), if pipelineStatisticsQuery is supported
+		enum class StatsQuery : uint16_t
+		{
+			G_BUFFER				= 0,
+			DEPTH_PRE_PASS	= 1,	// alpha masked materials only (no fragment shader otherwise), DepthPrePass::ON
+			_count_ = 2
+		};
+
+		// COMPACT: no POSITION target (the depth attachment is sampled instead), SUBPASSES: + swapchain image (last)
+		inline static const uint16_t s_gBufferColorCount	= vk::toInt(AttColor::_count_) - (isCompactGBuffer() ? 1 : 0);
+		inline static const uint16_t s_fbAttCount					= s_gBufferColorCount + 1 + (isSubpassLayout() ? 1 : 0);
+		inline static const uint16_t s_subpassCount				= isSubpassLayout() ? 2 : vk::RenderPass::s_subpassCount;
+		inline static const uint16_t s_spDepCount					= isSubpassLayout() ? 4 : vk::RenderPass::s_spDepCount;
+
+		// framebuffer attachment index of a g-buffer target
+		inline static constexpr uint16_t getGBufferIndex(AttColor _color) noexcept
+		{ return vk::toInt(_color) - (isCompactGBuffer() ? 1 : 0); }
+
+		inline static const uint32_t s_meshletCullGroupSize = 64;	// meshlet_culling.comp local size
+
+		// clustered shading: view frustum split in screen tiles x exponential depth slices, each with its light list
+		inline static const glm::uvec3	s_clusterGridSize				= { 16, 9, 24 };
+		inline static const uint32_t		s_clusterCount					= s_clusterGridSize.x * s_clusterGridSize.y * s_clusterGridSize.z;
+		inline static const uint32_t		s_maxLightsPerCluster		= 128;
+		inline static const uint32_t		s_clusterCullGroupSize	= 64;	// light_culling.comp local size
+
+		enum class LightingMode : uint16_t
+		{
+			CLUSTERED				= 0,	// full-screen triangle, per cluster light lists (light_culling.comp)
+			LIGHT_VOLUMES		= 1,	// instanced low-poly light spheres, additive: only the pixels a light covers are shaded
+			TILE_CLASSIFIED	= 2,	// clustered, screen tiles bucketed by content (tile_classification.comp), one
+														// indirect draw of tile quads per bucket with its specialized shader
+			COMPUTE					= 3		// tiled compute shading (per tile light lists in shared memory, lighting_pass.comp) into
+														// the lit image, sampled by the composition pass
+		};
+
+		// screen tiles of the classification, per content
+		enum class TileBucket : uint16_t
+		{
+			EMPTY		= 0,	// no geometry: not drawn
+			UNLIT		= 1,	// no light reaches it: ambient only
+			SIMPLE	= 2,	// fully covered, diffuse only
+			COMPLEX	= 3,	// partially covered (per pixel background test) or specular
+			_count_ = 4
+		};
+
+		inline static const LightingMode	s_lightingMode						= LightingMode::CLUSTERED;
+		inline static const uint32_t			s_lightCount							= 1024;	// one fixed, then random (scene bounds)
+		inline static const uint32_t			s_lightSeed								= 1337;	// random lights' (same set every run)
+		inline static const uint32_t			s_lightVolumeSubdivisions	= 3;	// octahedron edge splits
+		inline static const uint32_t			s_tileSize								= 16;	// pixels, tile_classification.comp & lighting_pass.comp local size
+		inline static const uint32_t			s_tileBucketCount					= vk::toInt(TileBucket::_count_);
+		inline static const VkFormat			s_litFormat								= VK_FORMAT_R16G16B16A16_SFLOAT;
+
+		inline static bool isClusteredLighting() noexcept
+		{ return s_lightingMode == LightingMode::CLUSTERED || s_lightingMode == LightingMode::TILE_CLASSIFIED; }
 
 		using DescriptorData	= Desc::Data<Desc::s_setLayoutCount>;
 		using FramebufferData	= vk::Framebuffer::Data<s_fbAttCount>;
 		using RenderPassData	= vk::RenderPass::Data<
 			s_fbAttCount,
-			vk::RenderPass::s_subpassCount,
-			vk::RenderPass::s_spDepCount
+			s_subpassCount,
+			s_spDepCount
 		>;
 		using PipelineData		= vk::Pipeline::Data<
 			constants::shaders::_count_,
@@ -67,15 +177,22 @@ namespace renderer
 		{
 			STACK_ONLY(CompositionUBO)
 
-			struct Light
-			{
-				glm::vec4	position;
-				glm::vec3	color;
-				float			radius;
-			};
-
-			Light			lights[6];
-			glm::vec4	viewPos;
+			glm::vec4		viewPos;
+			glm::mat4		view;
+			glm::mat4		invProjection;
+			glm::uvec4	clusterGrid;		// xyz: cluster counts, w: light count
+			glm::vec4		clusterParams;	// near, far, slice = log(depth) * z + w
+			glm::vec2		screenSize;
+			uint32_t		isHeatmap;
+			uint32_t		tileCount;			// tile list stride (see tileBuffer)
+			glm::mat4		viewProjection;	// light volumes
+			glm::mat4		invViewProjection;	// world position from depth (compact g-buffer)
+		};
+		// std430 (LIGHT_SSBO)
+		struct Light
+		{
+			glm::vec4	position;	// w: radius (culling range)
+			glm::vec4	color;		// w: intensity
 		};
 		struct OffScreenUBO
 		{
@@ -86,20 +203,77 @@ namespace renderer
 		};
 
 		FramebufferData	framebufferData;
+		std::vector<VkFramebuffer>	swapchainFramebuffers;	// SUBPASSES, LIGHT_VOLUMES (volumeRenderPass): per swapchain image
+		VkRenderPass		volumeRenderPass	= VK_NULL_HANDLE;	// LIGHT_VOLUMES composition: Base's + the g-buffer depth (read only)
+		VkImageView			depthView	= VK_NULL_HANDLE;	// depth aspect of the g-buffer depth (compact g-buffer position)
 		PipelineData		pipelineData;
+		uint16_t				prePassFirstPipeIdx	= 0;	// depth pre-pass pipelines, per material
+		VkQueryPool			statsQueryPool			= VK_NULL_HANDLE;	// per StatsQuery
 		DescriptorData	descriptorData;
-		BufferData			bufferData; // Inclusive for both UBOs & Model buffers
+		BufferData			bufferData; // Inclusive for both UBOs & Model buffers (the geometry arena's)
+
+		vk::GeometryArena::Data	geometryArena;
+
+		vk::Vector<VkDescriptorSet>	meshletCullSets;	// MESHLET_CULLING, one per model
+		VkPipeline									meshletCullingPipeline = VK_NULL_HANDLE;
+
+		VkBuffer				lightBuffer		= VK_NULL_HANDLE;	// host visible, s_lightCount lights
+		VkDeviceMemory	lightMemory		= VK_NULL_HANDLE;
+		Light						*lights				= nullptr;
+		VkBuffer				clusterBuffer	= VK_NULL_HANDLE;	// per cluster light counts, then s_maxLightsPerCluster indices per cluster
+		VkDeviceMemory	clusterMemory	= VK_NULL_HANDLE;
+
+		VkPipeline			lightCullingPipeline = VK_NULL_HANDLE;
+
+		VkBuffer				lightVolumeBuffer		= VK_NULL_HANDLE;	// unit sphere (circumscribed) triangle list
+		VkDeviceMemory	lightVolumeMemory		= VK_NULL_HANDLE;
+		uint32_t				lightVolumeVtxCount	= 0;
+
+		VkBuffer				tileBuffer		= VK_NULL_HANDLE;	// per bucket draw commands, then per bucket tile lists (x | y << 16)
+		VkDeviceMemory	tileMemory		= VK_NULL_HANDLE;
+		uint32_t				tileCount			= 0;
+
+		VkPipeline																				tileClassificationPipeline = VK_NULL_HANDLE;
+		vk::Array<VkPipeline, s_tileBucketCount>	tilePipelines = {};	// composition, per bucket (EMPTY unused, COMPLEX: the composition pipeline)
+
+		vk::FrameGraph::Data	frameGraph;	// offscreen passes (SEPARATE pass layout), see Deferred::setupFrameGraph
+		vk::Array<uint16_t, s_gBufferColorCount + 1>	gBufferResources	= {};	// g-buffer attachments (owned by the graph)
+		uint16_t							gBufferPass				= 0;	// its render pass' external dependencies (see setupRenderPass)
+		uint16_t							litResource				= vk::FrameGraph::s_invalidResource;	// compute lighting output
+		VkPipeline						lightingPipeline	= VK_NULL_HANDLE;
 
 		VkCommandBuffer	cmdBuffer	= VK_NULL_HANDLE;
 		VkSemaphore			semaphore	= VK_NULL_HANDLE;
 
+		std::vector<uint32_t>	visibleRefs;	// scene BVH refs (per frame scratch)
+		std::vector<uint32_t>	hiddenRefs;
+		std::vector<uint32_t>	occludedRefs;	// PVS & software occlusion culled
+
 		BEGIN_DESC_SET_LAYOUT_BINDING_STRUCT(DEFERRED_SHADING)
 
 			LAYOUT_BINDING_UNIFORM_BUFFER(GEOM_VS_UBO, StageFlag::VERTEX)					// VS uniform buffer
-			LAYOUT_BINDING_COMBINED_IMAGE_SAMPLER(POSITION, StageFlag::FRAGMENT)	// Position / Color map
-			LAYOUT_BINDING_COMBINED_IMAGE_SAMPLER(NORMAL, StageFlag::FRAGMENT)		// Normals  / Normal Map
-			LAYOUT_BINDING_COMBINED_IMAGE_SAMPLER(ALBEDO, StageFlag::FRAGMENT)		// Albedo
-			LAYOUT_BINDING_UNIFORM_BUFFER(LIGHT_FS_UBO, StageFlag::FRAGMENT)			// FS uniform buffer
+			LAYOUT_BINDING_COMBINED_IMAGE_SAMPLER(POSITION, StageFlag::FRAGMENT | StageFlag::COMPUTE)	// Position (depth if compact) / Color map
+			LAYOUT_BINDING_COMBINED_IMAGE_SAMPLER(NORMAL, StageFlag::FRAGMENT | StageFlag::COMPUTE)		// Normals  / Normal Map
+			LAYOUT_BINDING_COMBINED_IMAGE_SAMPLER(ALBEDO, StageFlag::FRAGMENT | StageFlag::COMPUTE)		// Albedo
+			LAYOUT_BINDING_UNIFORM_BUFFER(LIGHT_FS_UBO, StageFlag::FRAGMENT | StageFlag::COMPUTE)		// FS uniform buffer (+ light culling)
+			LAYOUT_BINDING_STORAGE_BUFFER(INSTANCE_SSBO, StageFlag::VERTEX)				// Per instance world matrices
+			LAYOUT_BINDING_STORAGE_BUFFER(VERTEX_SSBO, StageFlag::VERTEX)					// Packed vertices (vertex pulling)
+			LAYOUT_BINDING_STORAGE_BUFFER(LIGHT_SSBO, StageFlag::VERTEX | StageFlag::FRAGMENT | StageFlag::COMPUTE)	// Lights
+			LAYOUT_BINDING_STORAGE_BUFFER(CLUSTER_SSBO, StageFlag::FRAGMENT | StageFlag::COMPUTE)		// Per cluster light lists
+			LAYOUT_BINDING_STORAGE_BUFFER(TILE_SSBO, StageFlag::VERTEX | StageFlag::COMPUTE)					// Tile classification
+			LAYOUT_BINDING_STORAGE_IMAGE(LIT_IMAGE, StageFlag::COMPUTE)															// Compute lighting output
+			LAYOUT_BINDING_COMBINED_IMAGE_SAMPLER(LIT_MAP, StageFlag::FRAGMENT)											// Compute lighting output (resolve)
+			LAYOUT_BINDING_INPUT_ATTACHMENT(POSITION_INPUT, StageFlag::FRAGMENT)										// Position (depth if compact), subpasses
+			LAYOUT_BINDING_INPUT_ATTACHMENT(NORMAL_INPUT, StageFlag::FRAGMENT)											// Normals, subpasses
+			LAYOUT_BINDING_INPUT_ATTACHMENT(ALBEDO_INPUT, StageFlag::FRAGMENT)											// Albedo, subpasses
+
+		END_DESC_SET_LAYOUT_BINDING_STRUCT()
+
+		BEGIN_DESC_SET_LAYOUT_BINDING_STRUCT(MESHLET_CULLING)
+
+			LAYOUT_BINDING_STORAGE_BUFFER(MESHLET_SSBO, StageFlag::COMPUTE)	// Meshlet bounds
+			LAYOUT_BINDING_STORAGE_BUFFER(CULL_SSBO, StageFlag::COMPUTE)		// Cull view & per primitive cull records
+			LAYOUT_BINDING_STORAGE_BUFFER(DRAW_SSBO, StageFlag::COMPUTE)		// Indirect draw commands
 
 		END_DESC_SET_LAYOUT_BINDING_STRUCT()
 	};
@@ -15,8 +15,9 @@ enum class vk::Attachment::Tag::Color : uint16_t
 
 enum class vk::Descriptor::LayoutCategory : uint16_t
 {
-	DEFERRED_SHADING = 0,
-	_count_ = 1
+	DEFERRED_SHADING	= 0,
+	MESHLET_CULLING		= 1,	// compute: meshlet bounds, cull records -> indirect draw commands (per model)
+	_count_ = 2
 };
 
 enum class vk::Pipeline::Type : uint16_t
@@ -44,7 +45,8 @@ enum class vk::Shader::Stage : uint16_t
 {
 	VERTEX		= 0,
 	FRAGMENT	= 1,
-	_count_ = 2
+	COMPUTE		= 2,	// separate (compute) pipelines: the graphics stages come first
+	_count_ = 3
 };
 
 enum class vk::Model::ID : uint16_t
@@ -62,7 +64,12 @@ inline const uint16_t vk::Descriptor::s_setLayoutCount	= vk::toInt(vk::Descripto
 inline const uint16_t vk::Model			::s_modelCount			= vk::toInt(vk::Model			::ID						::_count_);
 inline const uint16_t vk::Buffer		::s_bufferCount			= vk::Buffer::s_mbtCount + vk::Buffer::s_ubcCount;
 inline const uint16_t vk::Pipeline	::s_layoutCount			= 1;
-inline const uint16_t vk::Pipeline	::s_pushConstCount	= 1;
+inline const uint16_t vk::Pipeline	::s_pushConstCount	= 0;
+
+inline const vk::Model::VertexLayout vk::Model::s_vertexLayout = vk::Model::VertexLayout::PACKED;
+inline const vk::Model::VertexFetch	vk::Model::s_vertexFetch	= vk::Model::VertexFetch::INPUT_ASSEMBLY;
+inline const vk::Model::VertexStreams	vk::Model::s_vertexStreams	= vk::Model::VertexStreams::INTERLEAVED;
+inline const float vk::Model::s_lodErrorThreshold = 1.0f;
 
 static_assert(
 	vk::Model::s_modelCount == constants::models.size(),
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "vk/vk.h"
+
+// Scene wide BVH over the primitives' world AABBs (all models):
+// binned SAH build, collapsed to 4-wide nodes (SIMD child frustum tests). Static scenes only: the node transforms are
+// baked at build (as are the occluders, see OcclusionCuller), a transform change needs a rebuild
+
+class SceneBvh
+{
+	using Model			= vk::Model;
+	using ModelNode	= vk::Model::Node;
+	using Frustum		= vk::Model::Frustum;
+
+	public:
+		inline static const uint32_t	s_binCount		= 16;
+		inline static const uint32_t	s_maxLeafSize	= 4;		// refs per leaf (forced split above)
+		inline static const float			s_empty				= 1e30f;	// inverted bounds of empty child slots
+
+		struct Aabb
+		{
+			glm::vec3 min = glm::vec3( s_empty);
+			glm::vec3 max = glm::vec3(-s_empty);
+
+			inline void grow(const glm::vec3 &_point) noexcept { min = glm::min(min, _point); max = glm::max(max, _point); }
+			inline void grow(const Aabb &_aabb)				noexcept { min = glm::min(min, _aabb.min); max = glm::max(max, _aabb.max); }
+
+			inline float getArea() const noexcept
+			{
+				const auto extent = glm::max(max - min, glm::vec3(0.0f));
+
+				return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+			}
+		};
+
+		struct Ref
+		{
+			uint32_t		modelIndex			= 0;
+			ModelNode		*node						= nullptr;
+			uint32_t		primitiveIndex	= 0;
+			uint32_t		pvsIndex				= 0;	// model wide primitive index (see Model::Pvs)
+			glm::mat4		worldMtx				= glm::mat4(1.0f);
+			Aabb				bounds;
+		};
+
+		// SoA child bounds, so one SIMD lane tests one child
+		struct alignas(16) Node4
+		{
+			float			minX[4], minY[4], minZ[4];
+			float			maxX[4], maxY[4], maxZ[4];
+
+			int32_t		children[4];	// >= 0: inner node, s_leaf: refs [firstRef, firstRef + refCount) (empty if 0)
+			uint32_t	firstRef[4];
+			uint32_t	refCount[4];
+		};
+
+		inline static const int32_t s_leaf = -1;
+
+	public:
+		void build(const vk::Vector<Model::Data> &_modelsData) noexcept;
+
+		// visible: refs passing the frustum (this frame), hidden: refs visible last time but not anymore
+		void cull(
+			const Frustum					&_frustum,
+			std::vector<uint32_t>	&_visible,
+			std::vector<uint32_t>	&_hidden
+		) noexcept;
+
+		inline const Ref &getRef(uint32_t _ref) const noexcept	{ return m_refs[_ref]; }
+		inline size_t			getRefCount()					const noexcept	{ return m_refs.size(); }
+
+		static uint32_t testNode(
+			const Node4		&_node,
+			const Frustum	&_frustum,
+			uint32_t			&_insideMask
+		) noexcept;
+
+	private:
+		struct BuildNode
+		{
+			Aabb			bounds;
+			int32_t		left		= -1;
+			int32_t		right		= -1;
+			uint32_t	first		= 0;
+			uint32_t	count		= 0;
+
+			inline bool isLeaf() const noexcept { return left < 0; }
+		};
+
+	private:
+		int32_t buildBinary(
+			std::vector<BuildNode>	&_nodes,
+			uint32_t								_first,
+			uint32_t								_count
+		) noexcept;
+
+		int32_t collapse(
+			const std::vector<BuildNode>	&_nodes,
+			int32_t												_binaryNode
+		) noexcept;
+
+		void updateRef(uint32_t _ref) noexcept;
+		void setSlotBounds(Node4 &_node, uint32_t _slot, const Aabb &_bounds) noexcept;
+		void collectRefs(uint32_t _node, std::vector<uint32_t> &_refs) const noexcept;
+
+	private:
+		std::vector<Ref>				m_refs;
+		std::vector<Node4>			m_nodes;
+
+		std::vector<uint32_t>		m_visibleStamps;
+		std::vector<uint32_t>		m_prevVisible;
+		uint32_t								m_frame = 0;
+};
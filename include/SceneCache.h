@@ -0,0 +1,177 @@
+#pragma once
+
+#include "vk/vk.h"
+#include "_constants.h"
+
+// Pre-cooked binary scene (GPU-ready flattened geometry, primitive tables, node transforms & material records)
+
+class SceneCache
+{
+	using Vertex		= vk::Model::Vertex;
+	using Lod				= vk::Model::Lod;
+	using Meshlet		= vk::Model::Meshlet;
+	using PvsGrid		= vk::Model::Pvs::Grid;
+	using Node			= vk::Model::Node;
+	using NodePtr		= vk::Model::NodePtr;
+	using Material	= vk::Material;
+
+	public:
+		inline static const uint32_t s_magic		= 0x43535244; // "DRSC"
+		inline static const uint32_t s_version	= 10;
+
+		enum class Section : uint16_t
+		{
+			DEPENDENCIES	= 0, // source files (besides the model file itself) the hash is keyed by
+			TEXTURES			= 1, // texture uris
+			MATERIALS			= 2,
+			NODES					= 3,
+			PRIMITIVES		= 4,
+			VERTICES			= 5,
+			INDICES				= 6,
+			MESHLETS			= 7,
+			PVS_GRID			= 8, // vk::Model::Pvs::Grid (none if not baked)
+			PVS_BITS			= 9,
+
+			_count_ = 10
+		};
+
+		struct SectionInfo
+		{
+			uint64_t offset	= 0;
+			uint64_t size		= 0;	// in bytes
+			uint64_t count	= 0;	// in entries
+		};
+
+		struct Header
+		{
+			uint32_t	magic					= s_magic;
+			uint32_t	version				= s_version;
+			uint64_t	sourceHash		= 0;
+			float			scale					= 1.0f;
+			uint32_t	sectionCount	= vk::toInt(Section::_count_);
+
+			SectionInfo sections[vk::toInt(Section::_count_)];
+		};
+
+		struct MaterialRecord
+		{
+			uint16_t	alphaMode		= 0;
+			uint16_t	doubleSided	= 0;
+			float			alphaCutoff	= 1.0f;
+
+			int32_t		textureIndices	[Material::descCount];
+			int32_t		texCoordSets		[vk::toInt(Material::TexCoordSet::_count_)];
+			float			factors					[vk::toInt(Material::FactorParam::_count_)];
+			glm::vec4	colorFactors		[vk::toInt(Material::ColorFactorParam::_count_)];
+		};
+
+		struct NodeRecord
+		{
+			int32_t		parent					= -1;	// flattened (pre-order) node index
+			uint32_t	firstPrimitive	= 0;
+			uint32_t	primitiveCount	= 0;
+			int32_t		skinIndex				= -1;
+			glm::mat4	matrix;
+		};
+
+		// the baked Primitive fields only (no upload/per frame state: index type, instancing, LOD selection, cull record)
+		struct PrimitiveRecord
+		{
+			uint32_t	firstIndex		= 0;
+			int32_t		vtxOffset			= 0;
+			uint32_t	firstVertex		= 0;
+			uint32_t	idxCount			= 0;
+			uint32_t	vtxCount			= 0;
+			int32_t		matIndex			= 0;
+			uint32_t	firstMeshlet	= 0;
+			uint32_t	meshletCount	= 0;
+			uint32_t	lodCount			= 0;
+			glm::vec3	center				= glm::vec3(0.0f);
+			float			radius				= 0.0f;
+			glm::vec3	extent				= glm::vec3(0.0f);
+
+			Lod				lods[vk::Model::s_lodCount - 1];
+		};
+
+		static_assert(std::is_trivially_copyable_v<PrimitiveRecord>, "PrimitiveRecord should be trivially copyable");
+		static_assert(
+			sizeof(PrimitiveRecord) == 16 * sizeof(uint32_t) + sizeof(Lod) * (vk::Model::s_lodCount - 1),
+			"PrimitiveRecord should have no padding"
+		);
+
+	public:
+		static bool load(
+			const std::string					&_fileName,
+			float											_scale,
+			vk::Model::Data						&_modelData,
+			std::vector<std::string>	&_textureUris
+		) noexcept;
+
+		static void save(
+			const std::string								&_fileName,
+			float														_scale,
+			const std::vector<std::string>	&_dependencies,
+			const std::vector<std::string>	&_textureUris,
+			const vk::Model::Data						&_modelData
+		) noexcept;
+
+		static bool isValid(
+			const std::string	&_fileName,
+			float							_scale
+		) noexcept;
+
+		static uint64_t hashSources(
+			const std::string								&_fileName,
+			const std::vector<std::string>	&_dependencies
+		) noexcept;
+
+		inline static std::string getCacheFileName(const std::string &_fileName) noexcept
+		{ return _fileName + constants::SCENE_CACHE_EXT; }
+
+	private:
+		struct Mapping
+		{
+			std::shared_ptr<void>	data;
+			size_t								size = 0;
+		};
+
+		static bool map		(const std::string &_fileName, Mapping &_mapping)	noexcept;
+		static bool validate(
+			const std::string	&_fileName,
+			float							_scale,
+			const Mapping			&_mapping
+		) noexcept;
+		static bool readFile(const std::string &_fileName, std::vector<char> &_data) noexcept;
+
+		static void flattenNode(
+			const NodePtr						&_node,
+			int32_t									_parent,
+			std::vector<NodeRecord>				&_nodes,
+			std::vector<PrimitiveRecord>	&_primitives
+		) noexcept;
+
+		static void readStrings(
+			const char								*_data,
+			const SectionInfo					&_section,
+			std::vector<std::string>	&_strings
+		) noexcept;
+		static void writeStrings(
+			const std::vector<std::string>	&_strings,
+			std::vector<char>								&_blob
+		) noexcept;
+
+		template<typename TEntry>
+		inline static const TEntry *getSection(const char *_data, const SectionInfo &_section) noexcept
+		{ return reinterpret_cast<const TEntry*>(_data + _section.offset); }
+
+		inline static uint64_t fnv1a(const char *_data, size_t _size, uint64_t _hash = 0xcbf29ce484222325ull) noexcept
+		{
+			for(size_t i = 0; i < _size; ++i)
+			{
+				_hash ^= static_cast<uint8_t>(_data[i]);
+				_hash *= 0x100000001b3ull;
+			}
+
+			return _hash;
+		}
+};
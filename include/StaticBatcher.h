@@ -0,0 +1,41 @@
+#pragma once
+
+#include "vk/vk.h"
+
+// Load/cook time static batching:
+// small primitives (non skinned, non instanced, non blended) sharing a material are pre-transformed to world space
+// & merged per spatial chunk into single primitives of one root node, so they cost one draw (and are still culled
+// per chunk). The flattened geometry is compacted afterwards (source ranges of merged primitives dropped).
+
+class StaticBatcher
+{
+	using Vertex		= vk::Model::Vertex;
+	using Primitive	= vk::Model::Primitive;
+	using Node			= vk::Model::Node;
+	using NodePtr		= vk::Model::NodePtr;
+
+	public:
+		inline static const uint32_t	s_maxSrcIdxCount		= 3 * 2048;	// primitives above this are drawn as they are
+		inline static const uint32_t	s_maxBatchVtxCount	= 0xFFFF;		// keeps the batches in the 16-bit index buckets
+		inline static const uint32_t	s_chunkCount				= 4;				// per axis, over the candidates' bounds
+
+	public:
+		// _excludedNodes: nodes keeping their own transform (e.g. instanced mesh sources)
+		static void batch(
+			vk::Model::Data							&_data,
+			const std::set<const Node*>	&_excludedNodes
+		) noexcept;
+
+	private:
+		struct Candidate
+		{
+			Node				*node;
+			uint32_t		primitiveIndex;
+			glm::mat4		worldMtx;
+			glm::ivec3	chunk;
+		};
+
+		static void compact(vk::Model::Data &_data) noexcept;
+
+		static uint32_t getDrawCount(const vk::Model::Data &_data) noexcept;
+};
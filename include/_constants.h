@@ -12,6 +12,8 @@ namespace constants
 	static const auto MODELS_PATH		= ASSET_PATH + "models/";
 	static const auto TEXTURES_PATH = ASSET_PATH + "textures/";
 
+	static constexpr const auto SCENE_CACHE_EXT = ".scene";
+
 	// @todo: temporary - should implement custom initializer list (cross-compile)
 	static constexpr const vk::Array<const char*, 1> models = {
 		"sponza.gltf"
@@ -24,6 +26,19 @@ namespace constants
 		{
 			static constexpr const auto vert = "geometry_pass.vert";
 			static constexpr const auto frag = "geometry_pass.frag";
+
+			static constexpr const auto packedVert = "geometry_pass_packed.vert"; // vk::Model::VertexLayout::PACKED
+			static constexpr const auto pulledVert = "geometry_pass_pulled.vert"; // vk::Model::VertexFetch::PULLING
+
+			static constexpr const auto compactFrag = "geometry_pass_compact.frag"; // DeferredScreenData::GBufferLayout::COMPACT
+		}
+
+		// Depth pre-pass (DeferredScreenData::DepthPrePass)
+		namespace depthPrePass
+		{
+			static constexpr const auto vert				= "depth_pass.vert";
+			static constexpr const auto pulledVert	= "depth_pass_pulled.vert";	// vk::Model::VertexFetch::PULLING
+			static constexpr const auto maskedFrag	= "depth_pass_masked.frag";	// alpha masked materials
 		}
 
 		// Composition (Deferred)
@@ -31,9 +46,40 @@ namespace constants
 		{
 			static constexpr const auto vert = "lighting_pass.vert";
 			static constexpr const auto frag = "lighting_pass.frag";
+
+			static constexpr const auto clusteredFrag = "lighting_pass_clustered.frag"; // per cluster light lists
+
+			static constexpr const auto volumeVert = "light_volume.vert"; // instanced light spheres
+			static constexpr const auto volumeFrag = "light_volume.frag";
+
+			static constexpr const auto tiledVert = "lighting_pass_tiled.vert"; // classified tile quads
+			static constexpr const auto tiledFrag = "lighting_pass_tiled.frag"; // specialized per tile bucket
+
+			static constexpr const auto comp				= "lighting_pass.comp";					// tiled compute shading
+			static constexpr const auto resolveFrag	= "lighting_pass_resolve.frag";	// compute shading output to the swapchain
+
+			static constexpr const auto subpassFrag = "lighting_pass_subpass.frag"; // DeferredScreenData::PassLayout::SUBPASSES
+		}
+
+		// Meshlet culling (compute)
+		namespace meshletCulling
+		{
+			static constexpr const auto comp = "meshlet_culling.comp";
+		}
+
+		// Clustered light culling (compute)
+		namespace lightCulling
+		{
+			static constexpr const auto comp = "light_culling.comp";
+		}
+
+		// Tile classification (compute)
+		namespace tileClassification
+		{
+			static constexpr const auto comp = "tile_classification.comp";
 		}
 
-		static constexpr const auto _count_ = 4;
+		static constexpr const auto _count_ = 9;
 	}
 }
 
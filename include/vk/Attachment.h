@@ -35,6 +35,7 @@ namespace vk
 
 				Type attType = Type(0);
 				std::vector<uint16_t> spIndices = { 0 };
+				std::vector<uint16_t> inputSpIndices = {};	// subpasses reading it (input attachment, depth first), after the spIndices ones
 			};
 
 			template<uint16_t attCount>
@@ -110,14 +111,10 @@ namespace vk
 				_clearValue.color = { (VkClearColorValue&&) constants::CLEAR_COLOR };
 			}
 
-			inline static void setColorAttachment(
-				const VkExtent2D					&_extent,					const VkPhysicalDeviceMemoryProperties	&_memProps,
-				const VkDevice						&_logicalDevice,
-				VkAttachmentDescription		&_desc,		VkClearValue		&_clearValue,
-				VkImage										&_image,	VkDeviceMemory	&_imageMemory,	VkImageView	&_imageView,
-				const VkFormat						&_format			= FormatType::R8G8B8A8_UNORM,
-				const VkImageAspectFlags	&_aspectMask	= VK_IMAGE_ASPECT_COLOR_BIT,
-				const VkImageUsageFlags		&_usage				= image::UsageFlag::COLOR_ATTACHMENT | VK_IMAGE_USAGE_SAMPLED_BIT
+			// description only: the image is created elsewhere (e.g. by a frame graph)
+			inline static void setColorDesc(
+				VkAttachmentDescription &_desc, VkClearValue	&_clearValue,
+				const VkFormat					&_format
 			) noexcept
 			{
 				_desc.flags           = 0;
@@ -131,6 +128,19 @@ namespace vk
 				_desc.finalLayout     = image::LayoutType				::SHADER_READ_ONLY_OPTIMAL;
 
 				_clearValue.color = { (VkClearColorValue&&) constants::CLEAR_COLOR };
+			}
+
+			inline static void setColorAttachment(
+				const VkExtent2D					&_extent,					const VkPhysicalDeviceMemoryProperties	&_memProps,
+				const VkDevice						&_logicalDevice,
+				VkAttachmentDescription		&_desc,		VkClearValue		&_clearValue,
+				VkImage										&_image,	VkDeviceMemory	&_imageMemory,	VkImageView	&_imageView,
+				const VkFormat						&_format			= FormatType::R8G8B8A8_UNORM,
+				const VkImageAspectFlags	&_aspectMask	= VK_IMAGE_ASPECT_COLOR_BIT,
+				const VkImageUsageFlags		&_usage				= image::UsageFlag::COLOR_ATTACHMENT | VK_IMAGE_USAGE_SAMPLED_BIT
+			) noexcept
+			{
+				setColorDesc(_desc, _clearValue, _format);
 
 				setImageData(
 					_logicalDevice,
@@ -141,14 +151,10 @@ namespace vk
 				);
 			}
 
-			inline static void setDepthAttachment(
-				const VkExtent2D					&_extent,					const VkPhysicalDeviceMemoryProperties	&_memProps,
-				const VkDevice						&_logicalDevice,
-				VkAttachmentDescription		&_desc,		VkClearValue		&_clearValue,
-				VkImage										&_image,	VkDeviceMemory	&_imageMemory,	VkImageView	&_imageView,
-				const VkFormat						&_format,
-				const VkImageAspectFlags	&_aspectMask	= VK_IMAGE_ASPECT_DEPTH_BIT,
-				const VkImageUsageFlags		&_usage				= image::UsageFlag::DEPTH_STENCIL_ATTACHMENT
+			// description only: the image is created elsewhere (e.g. by a frame graph)
+			inline static void setDepthDesc(
+				VkAttachmentDescription &_desc, VkClearValue	&_clearValue,
+				const VkFormat					&_format
 			) noexcept
 			{
 				_desc.flags           = 0;
@@ -162,6 +168,19 @@ namespace vk
 				_desc.finalLayout     = image::LayoutType				::DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
 				_clearValue.depthStencil = (VkClearDepthStencilValue&&) constants::CLEAR_DEPTH_STENCIL;
+			}
+
+			inline static void setDepthAttachment(
+				const VkExtent2D					&_extent,					const VkPhysicalDeviceMemoryProperties	&_memProps,
+				const VkDevice						&_logicalDevice,
+				VkAttachmentDescription		&_desc,		VkClearValue		&_clearValue,
+				VkImage										&_image,	VkDeviceMemory	&_imageMemory,	VkImageView	&_imageView,
+				const VkFormat						&_format,
+				const VkImageAspectFlags	&_aspectMask	= VK_IMAGE_ASPECT_DEPTH_BIT,
+				const VkImageUsageFlags		&_usage				= image::UsageFlag::DEPTH_STENCIL_ATTACHMENT
+			) noexcept
+			{
+				setDepthDesc(_desc, _clearValue, _format);
 
 				setImageData(
 					_logicalDevice,
@@ -172,6 +191,7 @@ namespace vk
 				);
 			}
 
+			// written then read by later subpasses only: never stored, lazily allocated where supported (tile memory)
 			inline static void setInputAttachment(
 				const VkExtent2D				&_extent,					const VkPhysicalDeviceMemoryProperties	&_memProps,
 				const VkDevice					&_logicalDevice,
@@ -180,7 +200,40 @@ namespace vk
 				const VkFormat					&_format
 			) noexcept
 			{
-				// TODO
+				_desc.flags           = 0;
+				_desc.format          = _format;
+				_desc.samples         = image::SampleCountFlag	::_1;
+				_desc.loadOp          = LoadOp          				::CLEAR;
+				_desc.storeOp         = StoreOp         				::DONT_CARE;
+				_desc.stencilLoadOp   = LoadOp          				::DONT_CARE;
+				_desc.stencilStoreOp  = StoreOp         				::DONT_CARE;
+				_desc.initialLayout   = image::LayoutType				::UNDEFINED;
+				_desc.finalLayout     = image::LayoutType				::SHADER_READ_ONLY_OPTIMAL;
+
+				_clearValue.color = { (VkClearColorValue&&) constants::CLEAR_COLOR };
+
+				setImageData(
+					_logicalDevice,
+					_format,
+					image::UsageFlag::COLOR_ATTACHMENT | image::UsageFlag::INPUT_ATTACHMENT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+					_extent, _memProps,
+					VK_IMAGE_ASPECT_COLOR_BIT,
+					_image, _imageMemory, _imageView,
+					getTransientMemFlags(_memProps)
+				);
+			}
+
+			inline static VkMemoryPropertyFlags getTransientMemFlags(const VkPhysicalDeviceMemoryProperties &_memProps) noexcept
+			{
+				for(auto i = 0u; i < _memProps.memoryTypeCount; ++i)
+				{
+					if(_memProps.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+					{
+						return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+					}
+				}
+
+				return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 			}
 
 			inline static void setImageData(
@@ -188,7 +241,8 @@ namespace vk
 				const VkFormat		&_format, const VkImageUsageFlags									&_usage,
 				const VkExtent2D	&_extent, const VkPhysicalDeviceMemoryProperties	&_memProps,
 				const VkImageAspectFlags &_aspectMask,
-				VkImage &_image, VkDeviceMemory &_imageMemory, VkImageView &_imageView
+				VkImage &_image, VkDeviceMemory &_imageMemory, VkImageView &_imageView,
+				const VkMemoryPropertyFlags &_propFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
 			) noexcept
 			{
 				Image::create(
@@ -199,7 +253,8 @@ namespace vk
 				Image::createMemory(
 					_logicalDevice, _memProps,
 					_image,
-					_imageMemory
+					_imageMemory,
+					_propFlags
 				);
 				Image::createImageView(
 					_logicalDevice, _image, _format,
@@ -248,7 +248,7 @@ namespace vk
 
 				Array<VkBufferUsageFlags,	s_mbtCount> modelFlags;
 
-				modelFlags[Type::VERTEX]	= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+				modelFlags[Type::VERTEX]	= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT; // + vertex pulling
 				modelFlags[Type::INDEX]		= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
 
 				auto startIdx = count == s_mbtCount ? 0u : toInt(Type::VERTEX);
@@ -46,6 +46,29 @@ namespace vk
 				const VkAllocationCallbacks	*_pAllocator = nullptr
 			) noexcept;
 
+			// pipeline statistics queries (pipelineStatisticsQuery feature)
+			static void createQueryPool(
+				const VkDevice												&_logicalDevice,
+				const VkQueryPipelineStatisticFlags		&_statistics,
+				uint32_t															_queryCount,
+				VkQueryPool														&_queryPool
+			) noexcept;
+
+			static void destroyQueryPool(
+				const VkDevice							&_logicalDevice,
+				const VkQueryPool						&_queryPool,
+				const VkAllocationCallbacks	*_pAllocator = nullptr
+			) noexcept;
+
+			// one uint64_t per query & statistic, false if not available yet (no wait)
+			static bool getQueryResults(
+				const VkDevice			&_logicalDevice,
+				const VkQueryPool		&_queryPool,
+				uint32_t						_queryCount,
+				uint64_t						*_pResults,
+				size_t							_resultsSize
+			) noexcept;
+
 			static void record(
 				const VkCommandBuffer															&_cmdBuffer,
 				const std::function<void(const VkCommandBuffer&)>	&_recordCallback,
@@ -190,7 +213,8 @@ namespace vk
 			static void bindVtxBuffers(
 				const VkCommandBuffer			&_cmdBuffer,
 				const VkBuffer						&_vtxBuffer,
-				const VkDeviceSize 				&_offsets
+				const VkDeviceSize 				&_offsets,
+				uint32_t									_firstBinding = 0
 			) noexcept;
 			static void bindIdxBuffer(
 				const VkCommandBuffer 		&_cmdBuffer,
@@ -215,6 +239,11 @@ namespace vk
 				const VkPushConstantRange &_pcRange
 			) noexcept;
 
+			static void nextSubpass(
+				const VkCommandBuffer			&_cmdBuffer,
+				const VkSubpassContents		&_contents = VK_SUBPASS_CONTENTS_INLINE
+			) noexcept;
+
 			// action commands
 
 			static void draw(
@@ -233,12 +262,66 @@ namespace vk
 				uint32_t									_firstInstance	= 0
 			) noexcept;
 
+			static void drawIndexedIndirect(
+				const VkCommandBuffer			&_cmdBuffer,
+				const VkBuffer						&_buffer,
+				VkDeviceSize							_offset,
+				uint32_t									_drawCount,
+				uint32_t									_stride = sizeof(VkDrawIndexedIndirectCommand)
+			) noexcept;
+
+			static void drawIndirect(
+				const VkCommandBuffer			&_cmdBuffer,
+				const VkBuffer						&_buffer,
+				VkDeviceSize							_offset,
+				uint32_t									_drawCount,
+				uint32_t									_stride = sizeof(VkDrawIndirectCommand)
+			) noexcept;
+
+			static void dispatch(
+				const VkCommandBuffer			&_cmdBuffer,
+				uint32_t									_groupCountX,
+				uint32_t									_groupCountY = 1,
+				uint32_t									_groupCountZ = 1
+			) noexcept;
+
+			// transfer commands
+
+			// inline (<= 64 KB), outside of render passes
+			static void updateBuffer(
+				const VkCommandBuffer			&_cmdBuffer,
+				const VkBuffer						&_buffer,
+				VkDeviceSize							_offset,
+				VkDeviceSize							_size,
+				const void								*_pData
+			) noexcept;
+
+			// query commands
+
+			// outside of render passes
+			static void resetQueryPool(
+				const VkCommandBuffer			&_cmdBuffer,
+				const VkQueryPool					&_queryPool,
+				uint32_t									_queryCount,
+				uint32_t									_firstQuery = 0
+			) noexcept;
+			static void beginQuery(
+				const VkCommandBuffer			&_cmdBuffer,
+				const VkQueryPool					&_queryPool,
+				uint32_t									_query
+			) noexcept;
+			static void endQuery(
+				const VkCommandBuffer			&_cmdBuffer,
+				const VkQueryPool					&_queryPool,
+				uint32_t									_query
+			) noexcept;
+
 			// sync action commands
 
 			static void insertBarriers(
 				const VkCommandBuffer					&_cmdBuffer,
-				const VkPipelineStageFlagBits	&_srcStageMask,
-				const VkPipelineStageFlagBits	&_dstStageMask,
+				const VkPipelineStageFlags		&_srcStageMask,
+				const VkPipelineStageFlags		&_dstStageMask,
 				const VkDependencyFlags				&_dependencyFlags,
 				uint32_t											_memoryBarrierCount,
 				const VkMemoryBarrier					*_pMemoryBarriers,
@@ -254,8 +337,8 @@ namespace vk
 				const TBarrierType								*_pBarriers,
 				uint32_t													_barrierCount			= 1,
 				const VkDependencyFlags						&_dependencyFlags	= 0,
-				const VkPipelineStageFlagBits			&_srcStageMask		= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-				const VkPipelineStageFlagBits			&_dstStageMask		= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+				const VkPipelineStageFlags				&_srcStageMask		= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+				const VkPipelineStageFlags				&_dstStageMask		= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
 			) noexcept
 			{
 				const auto &isMem			= std::is_same<TBarrierType, VkMemoryBarrier>				::value;
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Image.h"
+
+namespace vk
+{
+	// Frame graph: passes declare the images they read & write, compile() culls the passes no output depends on and
+	// creates the owned images, aliasing the memory of those whose lifetimes don't overlap, execute() records the live
+	// passes, each preceded by the layout transitions & barriers its accesses need (none for already visible reads).
+	// Attachment layouts are left to the pass' render pass (initialLayout UNDEFINED, finalLayout: Use::finalLayout),
+	// ordered with the other uses of its attachments by the external dependencies getDependencies() derives from them.
+	class FrameGraph
+	{
+		public:
+			using RecordCallback = std::function<void(const VkCommandBuffer&)>;
+
+			inline static const uint16_t s_invalidResource = ~uint16_t(0);
+
+			enum class Access : uint16_t
+			{
+				COLOR_ATTACHMENT	= 0,
+				DEPTH_ATTACHMENT	= 1,
+				SAMPLED						= 2,	// by the pass' shader stages
+				DEPTH_SAMPLED			= 3,	// read only depth
+				STORAGE_READ			= 4,
+				STORAGE_WRITE			= 5,
+				DEPTH_TEST				= 6,	// read only depth attachment (layout: the graph's, not the render pass')
+				_count_ = 7
+			};
+
+			// one per resource & pass
+			struct Use
+			{
+				uint16_t			resource;
+				Access				access;
+				VkImageLayout	finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;	// attachments: the render pass' (UNDEFINED: the access')
+			};
+
+			struct State
+			{
+				VkPipelineStageFlags	stages	= 0;
+				VkAccessFlags					access	= 0;
+				VkImageLayout					layout	= VK_IMAGE_LAYOUT_UNDEFINED;
+			};
+
+			struct Resource
+			{
+				const char					*name					= "";
+				VkFormat						format				= VK_FORMAT_UNDEFINED;
+				VkExtent2D					extent				= {};
+				VkImageUsageFlags		usage					= 0;	// owned: + the usage of the declared accesses
+				VkImageAspectFlags	aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+
+				VkImage							image					= VK_NULL_HANDLE;
+				VkImageView					view					= VK_NULL_HANDLE;
+				VkDeviceSize				size					= 0;
+
+				// compile: lifetime in live pass indices, owned: allocation & previous resource of the same allocation
+				int32_t							firstPass			= -1;
+				int32_t							lastPass			= -1;
+				int32_t							memoryIndex		= -1;
+				int32_t							aliasedIndex	= -1;
+			};
+
+			struct Pass
+			{
+				const char						*name						= "";
+				VkPipelineStageFlags	shaderStages		= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;	// SAMPLED & STORAGE accesses
+				std::vector<Use>			reads;
+				std::vector<Use>			writes;
+				RecordCallback				record					= nullptr;
+				bool									hasSideEffects	= false;	// untracked writes (e.g. buffers): never culled
+				bool									isCulled				= false;
+				VkPipelineStageFlags	visibleStages		= 0;	// render pass: its writes' by the out dependency (getDependencies)
+			};
+
+			// read after execute(), e.g. by the composition pass
+			struct Output
+			{
+				uint16_t							resource;
+				Access								access;
+				VkPipelineStageFlags	stages;
+			};
+
+			struct Data
+			{
+				std::vector<Resource>				resources;
+				std::vector<Pass>						passes;
+				std::vector<Output>					outputs;
+				std::vector<VkDeviceMemory>	memories;
+			};
+
+		public:
+			static uint16_t createImage(
+				Data								&_data,
+				const char					*_name,
+				const VkFormat			&_format,
+				const VkExtent2D		&_extent,
+				VkImageUsageFlags		_usage			= 0,
+				VkImageAspectFlags	_aspectMask	= VK_IMAGE_ASPECT_COLOR_BIT
+			) noexcept;
+
+			inline static uint16_t addPass(Data &_data, const Pass &_pass) noexcept
+			{
+				_data.passes.push_back(_pass);
+
+				return static_cast<uint16_t>(_data.passes.size() - 1);
+			}
+
+			inline static void addOutput(
+				Data									&_data,
+				uint16_t							_resource,
+				Access								_access,
+				VkPipelineStageFlags	_stages
+			) noexcept
+			{
+				_data.outputs.push_back({ _resource, _access, _stages });
+			}
+
+			static void compile(
+				const VkDevice													&_logicalDevice,
+				const VkPhysicalDeviceMemoryProperties	&_memProps,
+				Data																		&_data
+			) noexcept;
+
+			// external dependencies of the render pass recorded by _pass (its writes: the attachments), after compile:
+			// in, after the previous frame's uses of the attachments' memory (the aliased resources' too); out, before the
+			// later passes' & outputs' uses of the attachments, which then need no barrier
+			static void getDependencies(
+				Data								&_data,
+				uint16_t						_pass,
+				VkSubpassDependency	&_in,
+				VkSubpassDependency	&_out
+			) noexcept;
+
+			static void execute(
+				const Data						&_data,
+				const VkCommandBuffer	&_cmdBuffer
+			) noexcept;
+
+			static void destroy(
+				const VkDevice	&_logicalDevice,
+				Data						&_data
+			) noexcept;
+
+			// VK_NULL_HANDLE if culled
+			inline static const VkImage &getImage(const Data &_data, uint16_t _resource) noexcept
+			{
+				return _data.resources[_resource].image;
+			}
+
+			inline static const VkImageView &getImageView(const Data &_data, uint16_t _resource) noexcept
+			{
+				return _data.resources[_resource].view;
+			}
+
+		private:
+			inline static const VkAccessFlags s_writeAccess	= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+																												VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		private:
+			static State getState(Access _access, VkPipelineStageFlags _shaderStages) noexcept;
+			static VkImageUsageFlags getUsage(Access _access) noexcept;
+	};
+}
@@ -39,13 +39,15 @@ namespace vk
 			}
 
 		public:
+			// _hasImages false: color & depth descriptions only, their images (& views) are provided by the caller
 			template<uint16_t attCount>
 			inline static void createAttachments(
 				const VkDevice													&_logicalDevice,
 				const VkPhysicalDeviceMemoryProperties	&_memProps,
 				const Array<AttSubpassMap, attCount>		&_attSpMaps,
 				Attachment::Data<attCount>							&_attachmentsData,
-				bool																		_isDefault = false
+				bool																		_isDefault = false,
+				bool																		_hasImages = true
 			) noexcept
 			{
 				using AttType = Attachment::Type;
@@ -79,6 +81,23 @@ namespace vk
 							);
 							break;
 						case AttType::COLOR:
+							// only read by later subpasses: transient
+							if(!attSpMap.inputSpIndices.empty())
+							{
+								Attachment::setInputAttachment(
+									extent, _memProps, _logicalDevice,
+									desc, clearValue, image, imageMemory, imageView,
+									format
+								);
+								break;
+							}
+
+							if(!_hasImages)
+							{
+								Attachment::setColorDesc(desc, clearValue, format);
+								break;
+							}
+
 							Attachment::setColorAttachment(
 								extent, _memProps, _logicalDevice,
 								desc, clearValue, image, imageMemory, imageView,
@@ -88,6 +107,13 @@ namespace vk
 						case AttType::DEPTH:
 						{
 							_attachmentsData.depthAttIndex = attIndex;
+
+							if(!_hasImages)
+							{
+								Attachment::setDepthDesc(desc, clearValue, format);
+								break;
+							}
+
 							Attachment::setDepthAttachment(
 								extent, _memProps, _logicalDevice,
 								desc, clearValue, image, imageMemory, imageView,
@@ -95,9 +121,10 @@ namespace vk
 								format >= vk::FormatType::D16_UNORM_S8_UINT
 								? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT
 								: VK_IMAGE_ASPECT_DEPTH_BIT,
-								_isDefault
+								(_isDefault
 								? image::UsageFlag::DEPTH_STENCIL_ATTACHMENT
-								: image::UsageFlag::DEPTH_STENCIL_ATTACHMENT | VK_IMAGE_USAGE_SAMPLED_BIT
+								: image::UsageFlag::DEPTH_STENCIL_ATTACHMENT | VK_IMAGE_USAGE_SAMPLED_BIT) |
+								(attSpMap.inputSpIndices.empty() ? 0 : image::UsageFlag::INPUT_ATTACHMENT)
 							);
 						}
 							break;
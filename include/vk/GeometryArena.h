@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Buffer.h"
+
+namespace vk
+{
+	class Device;
+
+	// Global vertex & index arena: one device local buffer per model buffer type (the Buffer::Data VERTEX & INDEX
+	// slots), models & streamed meshes get sub-ranges from an address ordered free list (first fit, coalesced on
+	// free), so all geometry is drawn with a single bind & nothing is reallocated when meshes come and go.
+	class GeometryArena
+	{
+		public:
+			inline static const VkDeviceSize s_vtxCapacity = 128ull << 20;	// bytes
+			inline static const VkDeviceSize s_idxCapacity = 64ull	<< 20;
+
+			inline static const VkDeviceSize s_invalidOffset = ~VkDeviceSize(0);
+
+		public:
+			struct Range
+			{
+				VkDeviceSize offset	= s_invalidOffset;	// bytes
+				VkDeviceSize size		= 0;
+
+				inline bool isValid() const noexcept { return offset != s_invalidOffset; }
+			};
+
+			struct Data
+			{
+				Array<std::vector<Range>,	Buffer::s_mbtCount>	freeRanges;	// per model buffer type, by offset
+				Array<VkDeviceSize,				Buffer::s_mbtCount>	capacities	= {};
+				Array<VkDeviceSize,				Buffer::s_mbtCount>	usedSizes		= {};
+			};
+
+		public:
+			template<Buffer::Type type, uint16_t bufferCount>
+			static void create(
+				const std::unique_ptr<Device>		&_device,
+				Data														&_data,
+				Buffer::Data<type, bufferCount>	&_bufferData
+			) noexcept
+			{
+				Buffer::assertModelBuffers<type, bufferCount>();
+
+				const auto &deviceData = _device->getData();
+				Array<VkDeviceSize, Buffer::s_mbtCount> alignments;
+
+				_data.capacities[Buffer::Type::VERTEX]	= s_vtxCapacity;
+				_data.capacities[Buffer::Type::INDEX]		= s_idxCapacity;
+
+				for(auto t = 0u; t < Buffer::s_mbtCount; ++t)
+				{
+					_data.freeRanges[t]	= { Range { 0, _data.capacities[t] } };
+					_data.usedSizes[t]	= 0;
+				}
+
+				Buffer::create<type, bufferCount>(
+					deviceData.logicalDevice, deviceData.memProps,
+					_data.capacities, alignments,
+					_bufferData.buffers, _bufferData.memories
+				);
+
+				INFO_LOG(
+					"Geometry arena: %.1f MB vertices, %.1f MB indices",
+					float(s_vtxCapacity) / float(1 << 20), float(s_idxCapacity) / float(1 << 20)
+				);
+			}
+
+			// _alignment: any value (e.g. the vertex stride), returns an invalid range if out of space
+			static Range allocate(
+				Data					&_data,
+				Buffer::Type	_type,
+				VkDeviceSize	_size,
+				VkDeviceSize	_alignment
+			) noexcept;
+
+			static void free(
+				Data					&_data,
+				Buffer::Type	_type,
+				Range					&_range
+			) noexcept;
+	};
+}
@@ -153,6 +153,7 @@ namespace vk
 		const static int descCount = toInt(TextureParam::_count_) + toInt(AdditionalTextureParam::_count_);
 
 		Array<VkDescriptorImageInfo, descCount> descriptors;
+		Array<int, descCount> textureIndices; // into the model's texture data (descriptors source)
 //		Vector<VkDescriptorImageInfo> descriptors;
 
 		Array<Texture::Data, toInt(TextureParam::_count_) + toInt(AdditionalTextureParam::_count_)> textures;
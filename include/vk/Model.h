@@ -1,8 +1,11 @@
 #pragma once
 
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 
 #include "Buffer.h"
+#include "GeometryArena.h"
 #include "Pipeline.h"
 #include "Material.h"
 
@@ -21,6 +24,40 @@ namespace vk
 				PER_PRIMITIVE = 0,
 				PER_MODEL			= 1
 			};
+			enum class VertexLayout		: uint16_t
+			{
+				FULL		= 0, // Vertex				(92 bytes)
+				PACKED	= 1  // PackedVertex	(24 bytes)
+			};
+
+			// PULLING: the geometry pass reads the packed vertices from the arena vertex buffer (SSBO, by
+			// gl_VertexIndex) instead of the vertex input state (PACKED layout ONLY, input assembly otherwise)
+			enum class VertexFetch		: uint16_t
+			{
+				INPUT_ASSEMBLY	= 0,
+				PULLING					= 1
+			};
+
+			// SPLIT: stream 0 holds the positions only, stream 1 the remaining attributes (same vertex index), in two
+			// parallel regions of the arena vertex buffer, so depth only passes don't fetch the other attributes
+			enum class VertexStreams	: uint16_t
+			{
+				INTERLEAVED	= 0,
+				SPLIT				= 1
+			};
+
+			static const VertexLayout		s_vertexLayout;
+			static const VertexFetch		s_vertexFetch;
+			static const VertexStreams	s_vertexStreams;
+
+			inline static const uint16_t s_lodCount = 4;	// incl. the source (LOD 0) index range
+
+			inline static const uint32_t s_noInstance	= ~0u;	// Node::instanceIndex of nodes without an instance slot
+			inline static const uint32_t s_noNode			= ~0u;	// Node::index of generated nodes (no source node)
+
+			inline static const uint32_t s_meshletMaxVertices		= 64;
+			inline static const uint32_t s_meshletMaxTriangles	= 124;
+			static const float s_lodErrorThreshold;				// max. projected simplification error (pixels)
 
 		public:
 			struct Node;
@@ -62,6 +99,30 @@ namespace vk
 				glm::vec4 weight0;
 			};
 
+			// GPU vertex (quantized): positions are snorm16 within the model bounds (dequantized by the node matrix),
+			// normals/tangents octahedral snorm16, half-float uvs and unorm8 colors. No skinning attributes.
+			struct PackedVertex
+			{
+				glm::i16vec4	position;	// R16G16B16A16_SNORM, w: tangent handedness
+				glm::i16vec2	normal;		// R16G16_SNORM
+				glm::i16vec2	tangent;	// R16G16_SNORM
+				glm::u16vec2	texCoord;	// R16G16_SFLOAT
+				glm::u8vec4		color;		// R8G8B8A8_UNORM
+			};
+
+			static_assert(sizeof(PackedVertex) == 24, "PackedVertex should be tightly packed (24 bytes)");
+			static_assert(
+				offsetof(Vertex, position) == 0 && offsetof(PackedVertex, position) == 0,
+				"The position should lead the vertex (stream 0 of the split vertex streams)"
+			);
+
+			// optional separate skinning stream (ONLY for models with joints/weights)
+			struct SkinVertex
+			{
+				glm::u16vec4	joint0;		// R16G16B16A16_UINT
+				glm::u16vec4	weight0;	// R16G16B16A16_UNORM
+			};
+
 			struct IndexParams
 			{
 				uint32_t 	firstIndex		= 0;
@@ -70,15 +131,102 @@ namespace vk
 				uint32_t 	firstInstance	= 0;
 			};
 
+			// simplified index range of a primitive (same vertices, same index bucket)
+			struct Lod
+			{
+				uint32_t	firstIndex	= 0;
+				uint32_t	idxCount		= 0;
+				float			error				= 0.0f;	// max. model space deviation from the source range
+			};
+
+			// cluster of a primitive's LOD 0 triangles (contiguous index range), culled individually
+			struct Meshlet
+			{
+				uint32_t	firstIndex	= 0;	// relative to the primitive's LOD 0 range
+				uint32_t	idxCount		= 0;
+
+				glm::vec3	center			= glm::vec3(0.0f);	// bounding sphere (model space)
+				float			radius			= 0.0f;
+
+				glm::vec3	coneAxis		= glm::vec3(0.0f);	// normal cone: all triangles backfacing if
+				float			coneCutoff	= 1.0f;							// dot(center - eye, axis) >= cutoff * |center - eye| + radius
+			};
+
+			// meshlet_culling.comp inputs (std430): per meshlet bounds (static), the view & per primitive cull records (per frame)
+			enum class CullMode				: uint32_t
+			{
+				CULLED		= 0,	// zero draws
+				RANGE			= 1,	// the record's range in the primitive's first slot (LOD n>0, instance groups)
+				MESHLETS	= 2		// frustum & backface culled meshlets, one draw per slot (LOD 0)
+			};
+
+			struct CullMeshlet
+			{
+				glm::vec4	sphere			= glm::vec4(0.0f);	// Meshlet center, w: radius
+				glm::vec4	cone				= glm::vec4(0.0f);	// Meshlet coneAxis, w: coneCutoff
+				uint32_t	firstIndex	= 0;
+				uint32_t	idxCount		= 0;
+				uint32_t	record			= 0;	// owning primitive's cullIndex (0: unreferenced, zero draws)
+				uint32_t	padding			= 0;
+			};
+
+			// head of the cull record buffer
+			struct CullView
+			{
+				Array<glm::vec4, 6>	planes;	// world space, normalized, pointing inwards
+				glm::vec4						eye;
+			};
+
+			struct CullRecord
+			{
+				glm::mat4	nodeMtx				= glm::mat4(1.0f);
+				CullMode	mode					= CullMode::CULLED;
+				uint32_t	firstIndex		= 0;	// LOD range (LOD 0: the meshlets' base)
+				uint32_t	idxCount			= 0;
+				int				vtxOffset			= 0;
+				uint32_t	instanceCount	= 0;
+				uint32_t	firstInstance	= 0;
+				uint32_t	firstMeshlet	= 0;
+				uint32_t	isTwoSided		= 0;	// no backface culling
+			};
+
 			struct Primitive
 			{
-				IndexParams 		indexParams;
-//		uint32_t	firstVertex;
+				IndexParams 		indexParams;	// GPU draw params (rebased into the index bucket at upload)
+				uint32_t				firstVertex = 0;
+				VkIndexType			indexType		= VK_INDEX_TYPE_UINT32;
 
 				uint32_t	idxCount = 0;
 				uint32_t	vtxCount = 0;
 
 				int				matIndex = 0;
+
+				Array<Lod, s_lodCount - 1>	lods;					// coarser LODs ONLY (LOD 0: indexParams & idxCount)
+				uint16_t										lodCount	= 0;
+				uint16_t										lodIndex	= 0;	// selected per frame (0: source range)
+
+				glm::vec3	center	= glm::vec3(0.0f);	// bounding sphere & box (model space, same center)
+				float			radius	= 0.0f;
+				glm::vec3	extent	= glm::vec3(0.0f);	// box half extent
+
+				uint32_t	firstMeshlet	= 0;	// also the primitive's first indirect draw command
+				uint32_t	meshletCount	= 0;
+				uint32_t	cullIndex			= 0;	// cull record (shared by an instance group's copies)
+
+				inline Lod getLod() const noexcept
+				{
+					return lodIndex == 0
+						? Lod { indexParams.firstIndex, idxCount, 0.0f }
+						: lods[lodIndex - 1];
+				}
+			};
+
+			// contiguous index buffer range drawn with a single index type & vertex offset
+			struct IndexBucket
+			{
+				IndexParams	indexParams;
+				uint32_t		idxCount	= 0;
+				VkIndexType	indexType	= VK_INDEX_TYPE_UINT32;
 			};
 
 			struct Mesh
@@ -100,10 +248,81 @@ namespace vk
 
 				uint32_t							index;
 				int										skinIndex = -1;
+
+				int32_t								instanceGroup		= -1;	// Data::instanceGroups (-1: not instanced)
+				uint32_t							instanceMember	= 0;
+				uint32_t							instanceIndex		= s_noInstance;	// Data::instances slot (per frame world matrix)
+			};
+
+			// nodes sharing a mesh (same primitive ranges & materials): the first member draws every primitive once,
+			// instanced (indexParams.instanceCount / firstInstance), the others only provide their world matrices
+			struct InstanceGroup
+			{
+				std::vector<Node*>		nodes;
+				std::vector<uint8_t>	isVisible;	// per member (per culling pass)
+				uint32_t							firstInstance = 0;
 			};
 
 			using VertexAttr = Vertex::Attribute;
 
+			struct Frustum
+			{
+				Array<glm::vec4, 6>	planes;	// world space, normalized, pointing inwards
+				glm::vec3						eye;
+
+				inline bool isInside(const glm::vec3 &_center, float _radius) const noexcept
+				{
+					for(const auto &plane : planes)
+					{
+						if(glm::dot(glm::vec3(plane), _center) + plane.w < -_radius) { return false; }
+					}
+
+					return true;
+				}
+			};
+
+			// baked potentially visible set (static scenes): uniform cell grid over the scene bounds,
+			// one bitset per cell over the model wide primitive indices (forEachNode order)
+			struct Pvs
+			{
+				struct Grid
+				{
+					glm::vec3		origin					= glm::vec3(0.0f);	// world space
+					uint32_t		primitiveCount	= 0;
+					glm::vec3		cellSize				= glm::vec3(1.0f);
+					uint32_t		wordCount				= 0;	// 32-bit words per cell
+					glm::uvec3	cellCounts			= glm::uvec3(0);
+					uint32_t		padding					= 0;
+				};
+
+				Grid									grid;
+				std::vector<uint32_t>	bits;	// cell major
+
+				inline static const uint32_t s_noCell = ~0u;
+
+				inline uint32_t getCell(const glm::vec3 &_position) const noexcept
+				{
+					if(bits.empty()) { return s_noCell; }
+
+					const auto cell = glm::floor((_position - grid.origin) / grid.cellSize);
+
+					for(auto c = 0; c < 3; ++c)
+					{
+						if(cell[c] < 0.0f || cell[c] >= static_cast<float>(grid.cellCounts[c])) { return s_noCell; }
+					}
+
+					const auto coords = glm::uvec3(cell);
+
+					return (coords.z * grid.cellCounts.y + coords.y) * grid.cellCounts.x + coords.x;
+				}
+
+				inline bool isVisible(uint32_t _cell, uint32_t _primitive) const noexcept
+				{
+					return _cell == s_noCell || _primitive >= grid.primitiveCount ||
+						(bits[_cell * grid.wordCount + _primitive / 32] >> (_primitive % 32)) & 1u;
+				}
+			};
+
 			struct Data
 			{
 				struct Temp
@@ -113,11 +332,67 @@ namespace vk
 					Array<const float*, toInt(VertexAttr::_count_)> buffers = {};
 				};
 
+				struct View
+				{
+					const Vertex		*vertices	= nullptr;
+					const uint32_t	*indices	= nullptr;
+					size_t					vtxCount	= 0;
+					size_t					idxCount	= 0;
+				};
+
 				std::vector<NodePtr>	nodes;
 				std::vector<NodePtr>	linearNodes;
 				std::vector<Material>	materials;
 				std::vector<Vertex>		vertices;
 				std::vector<uint32_t>	indices;
+				std::vector<SkinVertex>	skinVertices;
+
+				glm::mat4							dequantization = glm::mat4(1.0f); // ONLY for packed vertices (snorm16 -> model space)
+
+				// INDEX buffer layout: 32-bit section (absolute indices), then the 16-bit buckets (rebased indices)
+				std::vector<IndexBucket>	indexBuckets;
+				VkDeviceSize							idx16Offset = 0;	// byte offset of the 16-bit section
+
+				// sub-ranges of the geometry arena (draw params rebased into them: firstIndex & vtxOffset arena wide)
+				GeometryArena::Range			vtxRange;
+				GeometryArena::Range			idxRange;
+
+				std::vector<Meshlet>			meshlets;
+				Pvs												pvs;	// empty: not baked (everything potentially visible)
+
+				// per instance world matrices (host visible SSBO, rewritten every frame by updateInstances), indexed by
+				// gl_InstanceIndex (the draws' firstInstance), dequantization folded in: slot 0 for the per model draws,
+				// then one slot per drawn node (instance groups: contiguous, visible members compacted)
+				std::vector<InstanceGroup>	instanceGroups;
+				VkBuffer										instanceBuffer	= VK_NULL_HANDLE;
+				VkDeviceMemory							instanceMemory	= VK_NULL_HANDLE;
+				glm::mat4										*instances			= nullptr;
+				uint32_t										instanceCount		= 0;
+
+				// one indirect draw command slot per meshlet (device local), written by the meshlet culling pass from the
+				// meshlet bounds (host visible, written once) & the cull view & records (host visible, rewritten by cullClusters /
+				// cullPrimitive / cullInstances)
+				VkBuffer				meshletBuffer			= VK_NULL_HANDLE;
+				VkDeviceMemory	meshletMemory			= VK_NULL_HANDLE;
+				VkBuffer				cullRecordBuffer	= VK_NULL_HANDLE;
+				VkDeviceMemory	cullRecordMemory	= VK_NULL_HANDLE;
+				CullView				*cullView					= nullptr;
+				CullRecord			*cullRecords			= nullptr;
+				uint32_t				cullRecordCount		= 0;
+				VkBuffer				drawCmdBuffer			= VK_NULL_HANDLE;
+				VkDeviceMemory	drawCmdMemory			= VK_NULL_HANDLE;
+				bool						isMultiDrawIndirect = false;
+
+				// ONLY on scene cache hit: geometry stays in the mapped cache file
+				View									cacheView;
+				std::shared_ptr<void>	cacheMapping;
+
+				View getView() const noexcept
+				{
+					return cacheMapping
+						? cacheView
+						: View { vertices.data(), indices.data(), vertices.size(), indices.size() };
+				}
 
 				uint32_t imageSamplerCount	= 0;
 				uint32_t meshCount					= 0;
@@ -125,19 +400,175 @@ namespace vk
 			};
 
 		public:
+			inline static void forEachNode(
+				const std::vector<NodePtr>									&_nodes,
+				const std::function<void(const NodePtr&)>	&_callback
+			) noexcept
+			{
+				for(const auto &node : _nodes)
+				{
+					_callback(node);
+					forEachNode(node->children, _callback);
+				}
+			}
+
+			inline static glm::mat4 getNodeMatrix(const Node &_node) noexcept
+			{
+				auto nodeMtx		= _node.matrix;
+				auto curParent	= _node.parent;
+
+				while(curParent)
+				{
+					nodeMtx		= curParent->matrix * nodeMtx;
+					curParent	= curParent->parent;
+				}
+
+				return nodeMtx;
+			}
+
+			inline static glm::mat4 getNodeMatrix(const NodePtr &_node) noexcept
+			{ return getNodeMatrix(*_node); }
+
+			// bounding sphere radius scale
+			inline static float getMaxScale(const glm::mat4 &_mtx) noexcept
+			{
+				return std::sqrt(std::max(std::max(
+					glm::dot(glm::vec3(_mtx[0]), glm::vec3(_mtx[0])),
+					glm::dot(glm::vec3(_mtx[1]), glm::vec3(_mtx[1]))),
+					glm::dot(glm::vec3(_mtx[2]), glm::vec3(_mtx[2]))
+				));
+			}
+
+			// Picks the coarsest LOD per primitive whose simplification error, projected at the primitive's
+			// bounding sphere, stays under s_lodErrorThreshold pixels. Returns true if any selection changed.
+			static bool selectLods(
+				Data						&_data,
+				const glm::mat4	&_view,
+				const glm::mat4	&_perspective,
+				float						_viewportHeight
+			) noexcept
+			{
+				// world space error (per unit distance) -> pixels
+				const auto projScale = std::abs(_perspective[1][1]) * 0.5f * _viewportHeight;
+				std::vector<uint16_t> prevLodIndices;
+
+				forEachNode(_data.nodes, [&](const NodePtr &_node)
+				{
+					for(const auto &primitive : _node->mesh.primitives) { prevLodIndices.push_back(primitive.lodIndex); }
+				});
+
+				forEachNode(_data.nodes, [&](const NodePtr &_node)
+				{
+					const auto viewMtx	= _view * getNodeMatrix(_node);
+					const auto maxScale	= getMaxScale(viewMtx);
+
+					for(auto &primitive : _node->mesh.primitives)
+					{
+						uint16_t lodIndex = 0;
+
+						if(primitive.lodCount > 0)
+						{
+							const auto viewCenter	= glm::vec3(viewMtx * glm::vec4(primitive.center, 1.0f));
+							const auto distance		= std::max(glm::length(viewCenter) - primitive.radius * maxScale, 1e-3f);
+
+							while(
+								lodIndex < primitive.lodCount &&
+								primitive.lods[lodIndex].error * maxScale / distance * projScale <= s_lodErrorThreshold
+							) { ++lodIndex; }
+						}
+
+						primitive.lodIndex = lodIndex;
+					}
+				});
+
+				// instanced draws: the finest LOD any member needs
+				for(const auto &group : _data.instanceGroups)
+				{
+					auto &primitives = group.nodes[0]->mesh.primitives;
+
+					for(auto p = 0u; p < primitives.size(); ++p)
+					{
+						for(const auto node : group.nodes)
+						{
+							primitives[p].lodIndex = std::min(primitives[p].lodIndex, node->mesh.primitives[p].lodIndex);
+						}
+					}
+				}
+
+				auto isChanged	= false;
+				auto p					= 0u;
+
+				forEachNode(_data.nodes, [&](const NodePtr &_node)
+				{
+					for(const auto &primitive : _node->mesh.primitives)
+					{
+						isChanged = isChanged || primitive.lodIndex != prevLodIndices[p];
+						p++;
+					}
+				});
+
+				return isChanged;
+			}
+
 			template<Buffer::Type type, uint16_t bufferCount>
 			inline static void setup(
 				const std::unique_ptr<Device>		&_device,
 				Data 														&_data,
-				Buffer::Data<type, bufferCount>	&_bufferData
+				Buffer::Data<type, bufferCount>	&_bufferData,	// VERTEX & INDEX: the geometry arena buffers
+				GeometryArena::Data							&_arena
 			) noexcept
 			{
 				Buffer::assertModelBuffers<type, bufferCount>();
 
-				setupBuffers(_device, _data.vertices, _data.indices, _bufferData);
+				buildInstanceGroups(_data);
+				setupBuffers(_device, _data, _bufferData, _arena);
+				createCullBuffers(_device, _data);
+				createInstanceBuffer(_device, _data);
 				// setup descriptors
 			}
 
+			// also returns the model's geometry ranges to the arena
+			static void destroy(const VkDevice &_logicalDevice, Data &_data, GeometryArena::Data &_arena) noexcept;
+
+			static Frustum getFrustum(const glm::mat4 &_view, const glm::mat4 &_perspective) noexcept;
+
+			// Writes the frustum read by the meshlet culling pass (once per frame, ahead of the cull records)
+			static void setCullView(Data &_data, const Frustum &_frustum) noexcept;
+
+			// Writes the cull view & the primitives' cull records: per LOD 0 primitive inside the frustum its meshlets
+			// (frustum & backface culled by the meshlet culling pass, one draw per slot), per LOD n>0 primitive its LOD range.
+			static void cullClusters(
+				Data						&_data,
+				const Frustum		&_frustum
+			) noexcept;
+
+			inline static void resetInstances(Data &_data) noexcept
+			{
+				for(auto &group : _data.instanceGroups) { std::fill(group.isVisible.begin(), group.isVisible.end(), 0); }
+			}
+
+			inline static void setInstanceVisible(Data &_data, const Node &_node) noexcept
+			{
+				_data.instanceGroups[_node.instanceGroup].isVisible[_node.instanceMember] = 1;
+			}
+
+			// Compacts the visible members' instance slots & writes the groups' cull records (LOD range, instance
+			// count: visible member count). Returns the number of instanced draws.
+			static uint32_t cullInstances(Data &_data) noexcept;
+
+			// Writes the flattened world matrices of the nodes holding an instance slot (once per frame, before the
+			// draws: the previous frame's submission has completed).
+			static void updateInstances(Data &_data) noexcept;
+
+			// Writes the primitive's cull record, returns 1 if drawn (0 for hidden primitives: zero draws)
+			static uint32_t cullPrimitive(
+				Data						&_data,
+				const glm::mat4	&_nodeMtx,
+				const Primitive	&_primitive,
+				const Frustum		&_frustum,
+				bool						_isVisible = true
+			) noexcept;
+
 			// @todo make this implementation macro-based instead of generic draw function for custom api configuration
 			template<
 				RenderingMode	renderMode,
@@ -160,12 +591,18 @@ namespace vk
 				Buffer::assertModelBuffers<type, bufferCount>();
 
 				auto &buffers = _bufferData.buffers;
-				auto idxCount = _bufferData.entryCounts[BufferType::INDEX];
 
 //				Command::bindPipeline(_cmdBuffer, _pipelines[1]);
 
-				Command::bindVtxBuffers(_cmdBuffer, buffers[BufferType::VERTEX], 0);
-				Command::bindIdxBuffer(_cmdBuffer, buffers[BufferType::INDEX], 0);
+				// arena wide draw params: one vertex binding & one index binding per index type for all models
+				auto boundIdxType = VK_INDEX_TYPE_MAX_ENUM;
+
+				if(!isVertexPulling())
+				{
+					Command::bindVtxBuffers(_cmdBuffer, buffers[BufferType::VERTEX], 0);
+
+					if(isSplitStreams()) { Command::bindVtxBuffers(_cmdBuffer, buffers[BufferType::VERTEX], getAttributeStreamOffset(), 1); }
+				}
 
 				for(const auto &modelData : _modelsData)
 				{
@@ -177,7 +614,8 @@ namespace vk
 							{
 								drawNode(
 									_cmdBuffer, _descSets, _pipelineData,
-									node, _matFirstSetIdx, _matFirstPipeIdx
+									node, modelData, buffers[BufferType::INDEX], boundIdxType,
+									_matFirstSetIdx, _matFirstPipeIdx
 								);
 							}
 						}
@@ -199,24 +637,148 @@ namespace vk
 								);
 							}
 
-							Command::drawIndexed(
-								_cmdBuffer, idxCount,
-								_indexParams.firstIndex,		_indexParams.vtxOffset,
-								_indexParams.instanceCount,	_indexParams.firstInstance
-							);
+							// one draw per index bucket (vertex offsets differ between the 16-bit buckets)
+							for(const auto &bucket : modelData.indexBuckets)
+							{
+								const auto &bucketIdxParams = bucket.indexParams;
+
+								bindIdxBuffer(_cmdBuffer, buffers[BufferType::INDEX], bucket.indexType, boundIdxType);
+
+								Command::drawIndexed(
+									_cmdBuffer, bucket.idxCount,
+									_indexParams.firstIndex + bucketIdxParams.firstIndex,
+									_indexParams.vtxOffset	+ bucketIdxParams.vtxOffset,
+									_indexParams.instanceCount,	_indexParams.firstInstance
+								);
+							}
 						}
 							break;
 					}
 				}
 			}
 
+			inline static uint32_t getVertexStride() noexcept
+			{ return s_vertexLayout == VertexLayout::PACKED ? sizeof(PackedVertex) : sizeof(Vertex); }
+
+			inline static bool isVertexPulling() noexcept
+			{ return s_vertexFetch == VertexFetch::PULLING && s_vertexLayout == VertexLayout::PACKED; }
+
+			inline static bool isSplitStreams() noexcept { return s_vertexStreams == VertexStreams::SPLIT; }
+
+			// stream 0 (SPLIT) stride, the leading position of the vertex
+			inline static uint32_t getPositionStride() noexcept
+			{ return s_vertexLayout == VertexLayout::PACKED ? sizeof(PackedVertex::position) : sizeof(Vertex::position); }
+
+			// arena vertex buffer offset of stream 1 (SPLIT, 0 otherwise): the arena's vertex slots (capacity / stride) are
+			// split in a position region, then an attribute region
+			inline static VkDeviceSize getAttributeStreamOffset() noexcept
+			{ return isSplitStreams() ? GeometryArena::s_vtxCapacity / getVertexStride() * getPositionStride() : 0; }
+
+			// split vertex streams of _vtxCount vertices: positions, then the remaining attributes
+			static void splitVertices(
+				const void						*_vertices,
+				size_t								_vtxCount,
+				std::vector<uint8_t>	&_streams
+			) noexcept
+			{
+				const auto stride			= getVertexStride();
+				const auto posStride	= getPositionStride();
+				const auto attrStride	= stride - posStride;
+				const auto *src				= static_cast<const uint8_t*>(_vertices);
+
+				_streams.resize(_vtxCount * stride);
+
+				auto *positions		= _streams.data();
+				auto *attributes	= positions + _vtxCount * posStride;
+
+				for(auto v = 0u; v < _vtxCount; ++v, src += stride)
+				{
+					std::memcpy(positions		+ size_t(v) * posStride,	src,							posStride);
+					std::memcpy(attributes	+ size_t(v) * attrStride,	src + posStride,	attrStride);
+				}
+			}
+
+			static void packVertices(
+				const Data::View						&_view,
+				std::vector<PackedVertex>		&_packedVertices,
+				std::vector<SkinVertex>			&_skinVertices,
+				glm::mat4										&_dequantization
+			) noexcept
+			{
+				const auto vtxCount = _view.vtxCount;
+
+				glm::vec3 posMin(std::numeric_limits<float>::max());
+				glm::vec3 posMax(std::numeric_limits<float>::lowest());
+				bool hasSkin = false;
+
+				for(auto v = 0u; v < vtxCount; ++v)
+				{
+					const auto &vertex = _view.vertices[v];
+
+					posMin	= glm::min(posMin, vertex.position);
+					posMax	= glm::max(posMax, vertex.position);
+					hasSkin	= hasSkin || vertex.weight0 != glm::vec4(0.0f);
+				}
+
+				// uniform scale, so the dequantization can be folded into the node matrix without skewing normals
+				const auto center			= vtxCount ? (posMin + posMax) * 0.5f : glm::vec3(0.0f);
+				const auto extent			= posMax - posMin;
+				const auto halfExtent	= vtxCount ? std::max(std::max(std::max(extent.x, extent.y), extent.z) * 0.5f, 1e-6f) : 1.0f;
+
+				_dequantization = glm::scale(glm::translate(glm::mat4(1.0f), center), glm::vec3(halfExtent));
+
+				_packedVertices.resize(vtxCount);
+				_skinVertices.resize(hasSkin ? vtxCount : 0);
+
+				for(auto v = 0u; v < vtxCount; ++v)
+				{
+					const auto &vertex = _view.vertices[v];
+					auto &packed = _packedVertices[v];
+
+					const auto position	= (vertex.position - center) / halfExtent;
+					const auto tangent	= glm::vec3(vertex.tangent);
+					const auto handedness = vertex.tangent.w < 0.0f ? -1.0f : 1.0f;
+
+					packed.position	= glm::packSnorm<int16_t>(glm::vec4(position, handedness));
+					packed.normal		= glm::packSnorm<int16_t>(encodeOctahedral(vertex.normal));
+					packed.tangent	= glm::packSnorm<int16_t>(encodeOctahedral(tangent));
+					packed.texCoord	= glm::packHalf(vertex.texCoord);
+					packed.color		= glm::packUnorm<uint8_t>(glm::vec4(vertex.color, 1.0f));
+
+					if(hasSkin)
+					{
+						_skinVertices[v] = {
+							glm::u16vec4(vertex.joint0),
+							glm::packUnorm<uint16_t>(vertex.weight0)
+						};
+					}
+				}
+			}
+
+			inline static glm::vec2 encodeOctahedral(const glm::vec3 &_dir) noexcept
+			{
+				const auto l1Norm = std::abs(_dir.x) + std::abs(_dir.y) + std::abs(_dir.z);
+
+				if(l1Norm <= 0.0f) { return glm::vec2(0.0f); }
+
+				auto oct = glm::vec2(_dir) / l1Norm;
+
+				if(_dir.z < 0.0f)
+				{
+					oct = (1.0f - glm::abs(glm::vec2(oct.y, oct.x))) *
+								glm::vec2(oct.x >= 0.0f ? 1.0f : -1.0f, oct.y >= 0.0f ? 1.0f : -1.0f);
+				}
+
+				return oct;
+			}
+
 		private:
 			template<Buffer::Type type, uint16_t bufferCount>
 			static void setupBuffers(
 				const std::unique_ptr<Device>		&_device,
-				std::vector<Vertex>							&_vertices,
-				std::vector<uint32_t>						&_indices,
-				Buffer::Data<type, bufferCount>	&_bufferData
+				Data														&_data,
+				Buffer::Data<type, bufferCount>	&_bufferData,
+				GeometryArena::Data							&_arena
 			) noexcept
 			{
 				using BufferData = Buffer::Data<type, Buffer::s_mbtCount>;
@@ -236,12 +798,12 @@ namespace vk
 
 				createBuffers(
 					logicalDevice, deviceData.memProps,
-					_vertices, _indices,
-					inData, stagingBufferData, _bufferData
+					_data,
+					inData, stagingBufferData, _bufferData, _arena
 				);
 				setupBuffersCopyCmd(
 					logicalDevice,
-					sizes,
+					sizes, { _data.vtxRange.offset, _data.idxRange.offset },
 					cpuBuffers, gpuBuffers,
 					cmdPool, copyCmd
 				);
@@ -258,41 +820,284 @@ namespace vk
 			static void createBuffers(
 				const VkDevice																				&_logicalDevice,
 				const VkPhysicalDeviceMemoryProperties								&_memProps,
-				std::vector<Vertex>																		&_vertices,
-				std::vector<uint32_t>																	&_indices,
+				Data																									&_data,
 				typename Buffer::Data<type, Buffer::s_mbtCount>::Temp	&_inData,
 				Buffer::Data<type, Buffer::s_mbtCount>								&_cpuBufferData,
-				Buffer::Data<type, bufferCount>												&_gpuBufferData
+				Buffer::Data<type, bufferCount>												&_gpuBufferData,
+				GeometryArena::Data																		&_arena
 			) noexcept
 			{
 				using BufferType = Buffer::Type;
 
 				auto &sizes				= _inData.sizes;
-				auto &alignments	= _inData.alignments;
 				auto &entries			= _inData.entries;
 
 				auto &counts			= _gpuBufferData.entryCounts;
 
-				auto vtxCount			= _vertices.size();
-				auto idxCount			= _indices.size();
+				const auto view		= _data.getView();
+				auto vtxCount			= view.vtxCount;
+				auto idxCount			= view.idxCount;
+
+				std::vector<PackedVertex>	packedVertices;
+				std::vector<uint8_t>			vertexStreams;
+				std::vector<uint8_t>			bucketedIndices;
+
+				buildIndexBuckets(view, _data, bucketedIndices);
+
+				sizes		[BufferType::VERTEX]	= vtxCount * getVertexStride();
+				sizes		[BufferType::INDEX]		= bucketedIndices.size();
+
+				// staging copy source only (read-only, may point into a mapped scene cache)
+				entries	[BufferType::VERTEX]	= const_cast<Vertex*>(view.vertices);
+				entries	[BufferType::INDEX]		= bucketedIndices.data();
 
-				sizes		[BufferType::VERTEX]	= vtxCount * sizeof(Vertex);
-				sizes		[BufferType::INDEX]		= idxCount * sizeof(uint32_t);
+				if(s_vertexLayout == VertexLayout::PACKED)
+				{
+					packVertices(view, packedVertices, _data.skinVertices, _data.dequantization);
+
+					entries[BufferType::VERTEX] = packedVertices.data();
+				}
 
-				entries	[BufferType::VERTEX]	= _vertices.data();
-				entries	[BufferType::INDEX]		= _indices.data();
+				// staged as stream 0 then stream 1, copied to the arena's two regions (see setupBuffersCopyCmd)
+				if(isSplitStreams())
+				{
+					splitVertices(entries[BufferType::VERTEX], vtxCount, vertexStreams);
+
+					entries[BufferType::VERTEX] = vertexStreams.data();
+				}
 
 				counts	[BufferType::VERTEX]	= static_cast<uint32_t>(vtxCount);
 				counts	[BufferType::INDEX]		= static_cast<uint32_t>(idxCount);
 
+				// vertex ranges aligned to the stride (whole vertex offsets), index ranges to 4 bytes (both index types)
+				_data.vtxRange = GeometryArena::allocate(_arena, BufferType::VERTEX,	sizes[BufferType::VERTEX],	getVertexStride());
+				_data.idxRange = GeometryArena::allocate(_arena, BufferType::INDEX,		sizes[BufferType::INDEX],		sizeof(uint32_t));
+
+				ASSERT_FATAL(_data.vtxRange.isValid() && _data.idxRange.isValid(), "Geometry arena out of space!");
+
+				rebaseIntoArena(_data);
+
 				Buffer::create<type, Buffer::s_mbtCount>(_logicalDevice, _memProps, _inData, _cpuBufferData.buffers, _cpuBufferData.memories);
-				Buffer::create<type, bufferCount>(_logicalDevice, _memProps, sizes, alignments, _gpuBufferData.buffers, _gpuBufferData.memories);
+			}
+
+			// model local draw params -> arena wide (the index buffer is bound at offset 0 for both index types)
+			static void rebaseIntoArena(Data &_data) noexcept
+			{
+				const auto vtxBase		= static_cast<int>(_data.vtxRange.offset / getVertexStride());
+				const auto idx32Base	= static_cast<uint32_t>(_data.idxRange.offset / sizeof(uint32_t));
+				const auto idx16Base	= static_cast<uint32_t>((_data.idxRange.offset + _data.idx16Offset) / sizeof(uint16_t));
+
+				const auto getIdxBase = [&](VkIndexType _indexType)
+				{ return _indexType == VK_INDEX_TYPE_UINT16 ? idx16Base : idx32Base; };
+
+				// every primitive object once (instanced ones hold copies of their source's params)
+				forEachNode(_data.nodes, [&](const NodePtr &_node)
+				{
+					for(auto &primitive : _node->mesh.primitives)
+					{
+						const auto idxBase = getIdxBase(primitive.indexType);
+
+						primitive.indexParams.firstIndex	+= idxBase;
+						primitive.indexParams.vtxOffset		+= vtxBase;
+
+						for(auto l = 0u; l < primitive.lodCount; ++l) { primitive.lods[l].firstIndex += idxBase; }
+					}
+				});
+
+				for(auto &bucket : _data.indexBuckets)
+				{
+					bucket.indexParams.firstIndex	+= getIdxBase(bucket.indexType);
+					bucket.indexParams.vtxOffset	+= vtxBase;
+				}
+			}
+
+			// Groups the primitives into index width buckets: primitives (in index buffer order) whose combined
+			// vertex range fits 16 bits share a 16-bit bucket (indices rebased to the bucket's first vertex,
+			// restored by vtxOffset), the rest stays in the 32-bit section with absolute indices.
+			static void buildIndexBuckets(
+				const Data::View			&_view,
+				Data									&_data,
+				std::vector<uint8_t>	&_indexBytes
+			) noexcept
+			{
+				const uint32_t maxBucketVtxCount = std::numeric_limits<uint16_t>::max(); // 0xFFFF kept free (primitive restart)
+
+				std::vector<Primitive*>	primitives;
+				std::vector<uint32_t>		indices32;
+				std::vector<uint16_t>		indices16;
+				std::vector<IndexBucket>	buckets16;
+
+				forEachNode(_data.nodes, [&](const NodePtr &_node)
+				{
+					for(auto &primitive : _node->mesh.primitives)
+					{
+						if(primitive.idxCount > 0) { primitives.push_back(&primitive); }
+					}
+				});
+
+				std::stable_sort(
+					primitives.begin(), primitives.end(),
+					[](const Primitive *_a, const Primitive *_b)
+					{ return _a->indexParams.firstIndex < _b->indexParams.firstIndex; }
+				);
+
+				// primitives sharing a source range (instanced meshes) are copied once, then share the rebased ranges
+				std::vector<std::pair<Primitive*, const Primitive*>> sharedPrimitives;
+
+				for(auto p = 1u; p < primitives.size(); ++p)
+				{
+					const auto &source = *primitives[p - 1];
+
+					if(
+						primitives[p]->indexParams.firstIndex == source.indexParams.firstIndex &&
+						primitives[p]->idxCount == source.idxCount
+					) { sharedPrimitives.emplace_back(primitives[p], &source); }
+				}
+
+				primitives.erase(
+					std::unique(
+						primitives.begin(), primitives.end(),
+						[](const Primitive *_a, const Primitive *_b)
+						{ return _a->indexParams.firstIndex == _b->indexParams.firstIndex && _a->idxCount == _b->idxCount; }
+					),
+					primitives.end()
+				);
+
+				indices32.reserve(_view.idxCount);
+				indices16.reserve(_view.idxCount);
+
+				for(auto primitive : primitives)
+				{
+					auto &idxParams		= primitive->indexParams;
+					const auto srcIdx	= _view.indices + idxParams.firstIndex;
+					const auto vtxEnd	= primitive->firstVertex + primitive->vtxCount;
+
+					if(primitive->vtxCount > maxBucketVtxCount)
+					{
+						primitive->indexType	= VK_INDEX_TYPE_UINT32;
+						idxParams.firstIndex	= static_cast<uint32_t>(indices32.size());
+						idxParams.vtxOffset		= 0;
+
+						indices32.insert(indices32.end(), srcIdx, srcIdx + primitive->idxCount);
+
+						continue;
+					}
+
+					auto *bucket = buckets16.empty() ? nullptr : &buckets16.back();
+					const auto bucketBase = bucket ? static_cast<uint32_t>(bucket->indexParams.vtxOffset) : 0u;
+
+					if(!bucket || primitive->firstVertex < bucketBase || vtxEnd - bucketBase > maxBucketVtxCount)
+					{
+						IndexBucket newBucket;
+						newBucket.indexType							= VK_INDEX_TYPE_UINT16;
+						newBucket.indexParams.firstIndex	= static_cast<uint32_t>(indices16.size());
+						newBucket.indexParams.vtxOffset	= static_cast<int>(primitive->firstVertex);
+
+						buckets16.push_back(newBucket);
+						bucket = &buckets16.back();
+					}
+
+					const auto base = static_cast<uint32_t>(bucket->indexParams.vtxOffset);
+
+					primitive->indexType	= VK_INDEX_TYPE_UINT16;
+					idxParams.firstIndex	= static_cast<uint32_t>(indices16.size());
+					idxParams.vtxOffset		= bucket->indexParams.vtxOffset;
+
+					for(auto i = 0u; i < primitive->idxCount; ++i)
+					{
+						indices16.push_back(static_cast<uint16_t>(srcIdx[i] - base));
+					}
+
+					bucket->idxCount += primitive->idxCount;
+				}
+
+				const auto idx32Count = static_cast<uint32_t>(indices32.size());
+
+				// LOD ranges: after the source ranges (buckets only span LOD 0), same index type & vertex offset
+				for(auto primitive : primitives)
+				{
+					const auto base = static_cast<uint32_t>(primitive->indexParams.vtxOffset);
+
+					for(auto l = 0u; l < primitive->lodCount; ++l)
+					{
+						auto &lod = primitive->lods[l];
+						const auto srcIdx = _view.indices + lod.firstIndex;
+
+						if(primitive->indexType == VK_INDEX_TYPE_UINT32)
+						{
+							lod.firstIndex = static_cast<uint32_t>(indices32.size());
+							indices32.insert(indices32.end(), srcIdx, srcIdx + lod.idxCount);
+
+							continue;
+						}
+
+						lod.firstIndex = static_cast<uint32_t>(indices16.size());
+
+						for(auto i = 0u; i < lod.idxCount; ++i)
+						{
+							indices16.push_back(static_cast<uint16_t>(srcIdx[i] - base));
+						}
+					}
+				}
+
+				// sources are rebased by now (a shared primitive's source may be shared itself: in order)
+				for(auto &[primitive, source] : sharedPrimitives)
+				{
+					primitive->indexParams.firstIndex	= source->indexParams.firstIndex;
+					primitive->indexParams.vtxOffset	= source->indexParams.vtxOffset;
+					primitive->indexType							= source->indexType;
+					primitive->lods										= source->lods;
+				}
+
+				auto &buckets = _data.indexBuckets;
+				buckets.clear();
+
+				if(idx32Count > 0)
+				{
+					IndexBucket bucket32;
+					bucket32.idxCount = idx32Count;
+
+					buckets.push_back(bucket32);
+				}
+
+				buckets.insert(buckets.end(), buckets16.begin(), buckets16.end());
+
+				// 32-bit section first: keeps the 16-bit section offset 4-byte aligned
+				const auto size32 = indices32.size() * sizeof(uint32_t);
+				const auto size16 = indices16.size() * sizeof(uint16_t);
+
+				_data.idx16Offset = size32;
+
+				_indexBytes.resize(size32 + ((size16 + 3) & ~size_t(3)), 0);
+				std::memcpy(_indexBytes.data(),						indices32.data(), size32);
+				std::memcpy(_indexBytes.data() + size32,	indices16.data(), size16);
+
+				INFO_LOG(
+					"Index buckets: %zu 32-bit & %zu 16-bit indices (%zu 16-bit buckets), %.2f KB saved",
+					indices32.size(), indices16.size(), buckets16.size(), float(size16) / 1024.0f
+				);
+			}
+
+			// firstIndex is arena wide (in units of the index type), so the whole arena is bound
+			inline static void bindIdxBuffer(
+				const VkCommandBuffer	&_cmdBuffer,
+				const VkBuffer				&_idxBuffer,
+				VkIndexType						_indexType,
+				VkIndexType						&_boundIdxType
+			) noexcept
+			{
+				if(_indexType == _boundIdxType) { return; }
+
+				Command::bindIdxBuffer(_cmdBuffer, _idxBuffer, 0, _indexType);
+
+				_boundIdxType = _indexType;
 			}
 
 			template<uint16_t bufferCount>
 			static void setupBuffersCopyCmd(
 				const VkDevice																&_logicalDevice,
 				const Array<VkDeviceSize,	Buffer::s_mbtCount>	&_bufferSizes,
+				const Array<VkDeviceSize,	Buffer::s_mbtCount>	&_dstOffsets,	// arena ranges
 				const Array<VkBuffer,			Buffer::s_mbtCount>	&_cpuBuffers,
 				const Array<VkBuffer,			bufferCount>				&_gpuBuffers,
 				const VkCommandPool														&_cmdPool,
@@ -305,7 +1110,29 @@ namespace vk
 
 					for(auto i = 0; i < Buffer::s_mbtCount; ++i)
 					{
-						region.size = _bufferSizes[i];
+						// arena vertex slots -> the position & attribute regions
+						if(i == toInt(Buffer::Type::VERTEX) && isSplitStreams())
+						{
+							const auto stride			= getVertexStride();
+							const auto posStride	= getPositionStride();
+							const auto vtxBase		= _dstOffsets[i] / stride;
+							const auto vtxCount		= _bufferSizes[i] / stride;
+
+							const VkBufferCopy streamRegions[2] = {
+								{ 0,										vtxBase * posStride,																	vtxCount * posStride },
+								{ vtxCount * posStride,	getAttributeStreamOffset() + vtxBase * (stride - posStride),	vtxCount * (stride - posStride) }
+							};
+
+							Command::copyBuffer<2>(
+								_cmdBuffer,
+								_cpuBuffers[i], _gpuBuffers[i + toInt(Buffer::Type::VERTEX)],
+								streamRegions
+							);
+							continue;
+						}
+
+						region.size				= _bufferSizes[i];
+						region.dstOffset	= _dstOffsets[i];
 						Command::copyBuffer(
 							_cmdBuffer,
 							_cpuBuffers[i], _gpuBuffers[i + toInt(Buffer::Type::VERTEX)],
@@ -319,33 +1146,55 @@ namespace vk
 			}
 
 		private:
+			static void createCullBuffers(const std::unique_ptr<Device> &_device, Data &_data) noexcept;
+			static void createInstanceBuffer(const std::unique_ptr<Device> &_device, Data &_data) noexcept;
+			static void buildInstanceGroups(Data &_data) noexcept;
+
+			static void setCullRecord(
+				Data						&_data,
+				const Primitive	&_primitive,
+				CullMode				_mode,
+				const glm::mat4	&_nodeMtx				= glm::mat4(1.0f),
+				uint32_t				_instanceCount	= 0
+			) noexcept;
+
+			inline static void drawIndirect(
+				const VkCommandBuffer	&_cmdBuffer,
+				const Data						&_data,
+				const Primitive				&_primitive
+			) noexcept
+			{
+				const auto stride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+				const auto offset = VkDeviceSize(_primitive.firstMeshlet) * stride;
+
+				if(_data.isMultiDrawIndirect)
+				{
+					Command::drawIndexedIndirect(_cmdBuffer, _data.drawCmdBuffer, offset, _primitive.meshletCount, stride);
+					return;
+				}
+
+				for(auto m = 0u; m < _primitive.meshletCount; ++m)
+				{
+					Command::drawIndexedIndirect(_cmdBuffer, _data.drawCmdBuffer, offset + VkDeviceSize(m) * stride, 1, stride);
+				}
+			}
+
 			template<uint16_t shaderModCount, uint16_t pipelineLayoutCount, uint16_t pushConstCount>
 			static void drawNode(
 				const VkCommandBuffer																											&_cmdBuffer,
 				const Vector<VkDescriptorSet>																							&_descSets,
 				const Pipeline::Data<shaderModCount, pipelineLayoutCount, pushConstCount> &_pipelineData,
 				const NodePtr																															&_node,
+				const Data																																&_modelData,
+				const VkBuffer																														&_idxBuffer,
+				VkIndexType																																&_boundIdxType,
 				uint16_t																																	_matFirstSetIdx		= 0,
 				uint16_t																																	_matFirstPipeIdx	= 0
 			) noexcept
 			{
+				// world matrices from the instance buffer (primitives' firstInstance), no per node state
 				const auto &mesh	= _node->mesh;
-				auto nodeMtx			= _node->matrix;
-				auto curParent		= _node->parent;
-
-				while(curParent)
-				{
-					nodeMtx		= curParent->matrix * nodeMtx;
-					curParent	= curParent->parent;
-				}
-
-				if(!_pipelineData.pushConstRanges.empty())
-				{
-					Command::setPushConstants(
-						_cmdBuffer, _pipelineData.layouts[0],
-						&nodeMtx, _pipelineData.pushConstRanges[0]
-					);
-				}
+				const auto isDrawn	= _node->instanceGroup < 0 || _node->instanceMember == 0;
 
 				for(const auto &primitive : mesh.primitives)
 				{
@@ -353,11 +1202,14 @@ namespace vk
 					const auto &matSet = _descSets[_matFirstSetIdx + primitive.matIndex];
 					const auto &matPipeline = _pipelineData.pipelines[_matFirstPipeIdx + primitive.matIndex];
 
+					if(!isDrawn) { break; }
 					if(primitive.idxCount == 0) { continue; }
 
 //			DEBUG_LOG("idxCount: %d\nfirstIndex: %d", primitive.idxCount, primIdxParams.firstIndex);
 					Command::bindPipeline(_cmdBuffer, matPipeline);
 
+					bindIdxBuffer(_cmdBuffer, _idxBuffer, primitive.indexType, _boundIdxType);
+
 					Command::bindDescSets(
 						_cmdBuffer,
 						&matSet, 1,
@@ -365,10 +1217,18 @@ namespace vk
 						_pipelineData.layouts[0]//, _matFirstSetIdx
 					);
 
+					if(primitive.meshletCount > 0 && _modelData.drawCmdBuffer != VK_NULL_HANDLE)
+					{
+						drawIndirect(_cmdBuffer, _modelData, primitive);
+						continue;
+					}
+
+					const auto lod = primitive.getLod();
+
 					Command::drawIndexed(
 						_cmdBuffer,
-						primitive.idxCount,
-						primIdxParams.firstIndex,			primIdxParams.vtxOffset,
+						lod.idxCount,
+						lod.firstIndex,								primIdxParams.vtxOffset,
 						primIdxParams.instanceCount,	primIdxParams.firstInstance
 					);
 				}
@@ -377,7 +1237,8 @@ namespace vk
 				{
 					drawNode(
 						_cmdBuffer, _descSets, _pipelineData,
-						child, _matFirstSetIdx, _matFirstPipeIdx
+						child, _modelData, _idxBuffer, _boundIdxType,
+						_matFirstSetIdx, _matFirstPipeIdx
 					);
 				}
 			}
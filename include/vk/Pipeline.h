@@ -210,7 +210,8 @@ namespace vk
 				const VkPipelineLayout																					&_layout,
 				const Array<VkPipelineShaderStageCreateInfo, shaderStageCount>	&_shaderStages,
 				PSO																															&_psoData,
-				VkPipeline																											&_pipeline
+				VkPipeline																											&_pipeline,
+				uint32_t																												_subpass = 0
 			) noexcept
 			{
 				initPSOs(_psoData);
@@ -232,6 +233,7 @@ namespace vk
 
 				pipelineInfo.layout               = _layout;
 				pipelineInfo.renderPass           = _renderPass;
+				pipelineInfo.subpass              = _subpass;
 
 				auto result = vkCreateGraphicsPipelines(
 					_logicalDevice,
@@ -244,6 +246,14 @@ namespace vk
 				ASSERT_VK(result, "Failed to create graphics pipeline");
 			}
 
+			static void createComputePipeline(
+				const VkDevice													&_logicalDevice,
+				const VkPipelineCache										&_cache,
+				const VkPipelineLayout									&_layout,
+				const VkPipelineShaderStageCreateInfo		&_shaderStage,
+				VkPipeline															&_pipeline
+			) noexcept;
+
 			template<
 			  uint16_t shaderModuleCount,
 				uint16_t pipelineLayoutCount,
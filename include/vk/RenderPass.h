@@ -104,7 +104,6 @@ namespace vk
 						);
 
 						auto &subpass			= _subpasses[subpassIndex];
-						auto &subpassDesc	= subpass.desc;
 
 						auto &colorRefs		= subpass.colorRefs;
 						auto &depthRefs		= subpass.depthRefs;
@@ -123,25 +122,54 @@ namespace vk
 								inputRefs.push_back({ attIndex, ImageLayoutType::SHADER_READ_ONLY_OPTIMAL });
 								break;
 						}
+					}
 
-						subpassDesc.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
-
-						subpassDesc.colorAttachmentCount    = colorRefs.size();
-						subpassDesc.pColorAttachments       = colorRefs.data();
-
-						subpassDesc.pDepthStencilAttachment	= depthRefs.data();
+					// written by an earlier subpass (subpassLoad), input_attachment_index: depth first, then the colors in
+					// attachment order
+					for(const auto &subpassIndex : attSpMap.inputSpIndices)
+					{
+						ASSERT(
+							subpassIndex < subpassCount,
+							"Subpass index should be less than total number of subpasses!"
+						);
 
-						subpassDesc.inputAttachmentCount    = inputRefs.size();
-						subpassDesc.pInputAttachments       = inputRefs.data();
+						auto &inputRefs = _subpasses[subpassIndex].inputRefs;
 
-						// TODO
-						subpassDesc.preserveAttachmentCount	= 0;
-						subpassDesc.pPreserveAttachments		= nullptr;
-						subpassDesc.pResolveAttachments			= nullptr;
+						if(attSpMap.attType == AttType::DEPTH)
+						{
+							inputRefs.insert(
+								inputRefs.begin(), VkAttachmentReference { attIndex, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL }
+							);
+						}
+						else
+						{
+							inputRefs.push_back({ attIndex, ImageLayoutType::SHADER_READ_ONLY_OPTIMAL });
+						}
 					}
 
 					attIndex++;
 				}
+
+				// references complete: no more reallocations
+				for(auto &subpass : _subpasses)
+				{
+					auto &subpassDesc	= subpass.desc;
+
+					subpassDesc.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+					subpassDesc.colorAttachmentCount    = subpass.colorRefs.size();
+					subpassDesc.pColorAttachments       = subpass.colorRefs.data();
+
+					subpassDesc.pDepthStencilAttachment	= subpass.depthRefs.empty() ? nullptr : subpass.depthRefs.data();
+
+					subpassDesc.inputAttachmentCount    = subpass.inputRefs.size();
+					subpassDesc.pInputAttachments       = subpass.inputRefs.data();
+
+					// TODO
+					subpassDesc.preserveAttachmentCount	= 0;
+					subpassDesc.pPreserveAttachments		= nullptr;
+					subpassDesc.pResolveAttachments			= nullptr;
+				}
 			}
 
 			inline static void destroy(
@@ -44,6 +44,10 @@ namespace vk
 		static constexpr const VkFormat R32G32B32_SFLOAT			= VK_FORMAT_R32G32B32_SFLOAT;
 		static constexpr const VkFormat R32G32_SFLOAT					= VK_FORMAT_R32G32_SFLOAT;
 		static constexpr const VkFormat R32G32B32A32_SFLOAT		= VK_FORMAT_R32G32B32A32_SFLOAT;
+
+		static constexpr const VkFormat R16G16B16A16_SNORM		= VK_FORMAT_R16G16B16A16_SNORM;
+		static constexpr const VkFormat R16G16_SNORM					= VK_FORMAT_R16G16_SNORM;
+		static constexpr const VkFormat R16G16_SFLOAT					= VK_FORMAT_R16G16_SFLOAT;
 	};
 
 	struct ColorSpace : NOOP
@@ -137,6 +137,12 @@
 	#define LAYOUT_BINDING_STORAGE_BUFFER(_id, _stage)																							\
 					const uint16_t _id	= (__COUNTER__ - s_bindCountOffset);																\
 					set_binding<_id>(DescType::STORAGE_BUFFER,	_stage);
+	#define LAYOUT_BINDING_STORAGE_IMAGE(_id, _stage)																								\
+					const uint16_t _id	= (__COUNTER__ - s_bindCountOffset);																\
+					set_binding<_id>(DescType::STORAGE_IMAGE,		_stage);
+	#define LAYOUT_BINDING_INPUT_ATTACHMENT(_id, _stage)																						\
+					const uint16_t _id	= (__COUNTER__ - s_bindCountOffset);																\
+					set_binding<_id>(DescType::INPUT_ATTACHMENT,	_stage);
 
 	#define END_DESC_SET_LAYOUT_BINDING_STRUCT()																										\
     		}                                          																								\
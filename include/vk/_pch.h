@@ -14,6 +14,13 @@
 #include <string>
 #include <map>
 #include <chrono>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <bitset>
 //#include <utility>
 
 #if defined(_WIN32) && !defined(__CYGWIN__)
@@ -397,6 +397,30 @@ namespace vk
 	{
 		return static_cast<float>(std::chrono::duration<double, std::milli>(_end - _start).count());
 	}
+
+	// runs _job(0 .. _jobCount - 1) on the calling thread + up to _maxThreads - 1 spawned ones (blocking)
+	inline static void runJobs(
+		uint32_t														_jobCount,
+		const std::function<void(uint32_t)>	&_job,
+		uint32_t														_maxThreads = std::thread::hardware_concurrency()
+	) noexcept
+	{
+		const auto threadCount = std::max(1u, std::min(_maxThreads, _jobCount));
+
+		std::atomic<uint32_t>			next { 0 };
+		std::vector<std::thread>	workers;
+
+		const auto worker = [&]()
+		{
+			for(auto j = next++; j < _jobCount; j = next++) { _job(j); }
+		};
+
+		for(auto t = 1u; t < threadCount; ++t) { workers.emplace_back(worker); }
+
+		worker();
+
+		for(auto &thread : workers) { thread.join(); }
+	}
 }
 
 #endif
\ No newline at end of file
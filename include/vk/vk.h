@@ -5,4 +5,11 @@
 #include "Model.h"
 #include "Pipeline.h"
 #include "Descriptor.h"
-#include "RenderPass.h"
\ No newline at end of file
+#include "RenderPass.h"
+#include "FrameGraph.h"
+
+// SSE intrinsics (CPU culling: BVH frustum tests, occluder rasterization), scalar fallback otherwise
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#include <xmmintrin.h>
+	#define USE_SSE
+#endif
\ No newline at end of file
@@ -15,6 +15,7 @@ cd ${SHADERS_PATH} || return
 
 echo -ne "\nCompiling Shaders...\n\n"
 
+# *.glsl: shared #include files, resolved by glslc next to the including shader (neither compiled nor removed here)
 for ext in vert frag comp; do
   for file in *.${ext}; do
     if [[ ! -f $file ]]; then continue; fi;
@@ -18,23 +18,84 @@ void AssetHelper::load(
 	const std::string &_textureDir
 ) noexcept
 {
-	gltfModel	model;
+	std::vector<std::string>	textureUris;
+	std::vector<std::string>	dependencies;
 
-	loadModel			(_fileName, model);
-	loadTextures	(_device, model, _textureDir, _textureData);
-	loadMaterials	(model, _textureData, _modelData);
+	if(!SceneCache::load(_fileName, _scale, _modelData, textureUris))
+	{
+		loadScene(_fileName, _scale, _modelData, textureUris, dependencies);
+
+		SceneCache::save(_fileName, _scale, dependencies, textureUris, _modelData);
+	}
+
+	loadTextures						(_device, textureUris, _textureDir, _textureData);
+	setMaterialDescriptors	(_textureData, _modelData);
 
 	_modelData.textureCount = _textureData.size();
+}
+
+void AssetHelper::loadScene(
+	const std::string					&_fileName,
+	float 										_scale,
+	vk::Model::Data						&_modelData,
+	std::vector<std::string>	&_textureUris,
+	std::vector<std::string>	&_dependencies
+) noexcept
+{
+	gltfModel	model;
+
+	loadModel			(_fileName, model);
+	getUris				(model, _textureUris, _dependencies);
+	loadMaterials	(model, _modelData);
 
 	const auto &scene = model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
 	auto &nodes = scene.nodes;
-	auto meshCount = model.meshes.size();
+
+	MeshNodes meshNodes;
+	meshNodes.sources.resize(model.meshes.size());
 
 	for(const auto &node : nodes)
 	{
 		const auto &modelNode = model.nodes[node];
 
-		loadNode(modelNode, model, _scale, _modelData);
+		loadNode(modelNode, model, _scale, _modelData, meshNodes);
+	}
+
+	dedupMaterials(_modelData);
+
+	// instanced mesh sources keep their own transform
+	std::set<const Node*> instancedNodes;
+
+	for(const auto &[instance, source] : meshNodes.instances) { instancedNodes.insert(source.get()); }
+
+	StaticBatcher::batch(_modelData, instancedNodes);
+
+	// shared meshes are processed once (through their source node), then copied
+	MeshOptimizer::optimize(_modelData);
+	MeshOptimizer::generateLods(_modelData);
+	MeshOptimizer::buildMeshlets(_modelData);
+	shareMeshes(meshNodes);
+	PvsBaker::bake(_modelData);
+}
+
+void AssetHelper::getUris(
+	const gltfModel						&_model,
+	std::vector<std::string>	&_textureUris,
+	std::vector<std::string>	&_dependencies
+) noexcept
+{
+	for(const auto &texture : _model.textures)
+	{
+		_textureUris.push_back(_model.images[texture.source].uri);
+	}
+
+	// external buffers (embedded data uris are already hashed as part of the model file)
+	for(const auto &buffer : _model.buffers)
+	{
+		if(!buffer.uri.empty() && buffer.uri.rfind("data:", 0) != 0)
+		{
+			_dependencies.push_back(buffer.uri);
+		}
 	}
 }
 
@@ -65,7 +126,6 @@ void AssetHelper::loadModel(
 
 void AssetHelper::loadMaterials(
 	gltfModel								&_model,
-	const vk::Texture::Data	&_textureData,
 	vk::Model::Data					&_data
 )	noexcept
 {
@@ -75,7 +135,6 @@ void AssetHelper::loadMaterials(
 
 	auto 				&materials = _data.materials;
 	auto				&gltfMaterials = _model.materials;
-	const auto  &texImageInfos = _textureData.imageInfos;
 	const auto	materialCount = gltfMaterials.size();
 	const auto	&matParams = Material::paramKeys;
 	const auto	&matTexParams_1 = Material::textureParamKeys;
@@ -99,29 +158,26 @@ void AssetHelper::loadMaterials(
 		material.alphaCutoff	= (float) gltfMat.alphaCutoff;
 		material.doubleSided	= gltfMat.doubleSided;
 
-		if(!texImageInfos.empty())
+		for(auto p = 0; p < matTexParams_1.size(); ++p)
 		{
-			for(auto p = 0; p < matTexParams_1.size(); ++p)
-			{
-				const auto &param = gltfMatVals[matTexParams_1[p]];
-				auto texIndex = param.TextureIndex();
+			const auto &param = gltfMatVals[matTexParams_1[p]];
+			auto texIndex = param.TextureIndex();
 
-				if(texIndex < 0) { texIndex = 0; }
+			if(texIndex < 0) { texIndex = 0; }
 
-				material.descriptors[p] = texImageInfos[texIndex];
-				material.texCoordSets[p] = param.TextureTexCoord();
-			}
+			material.textureIndices[p] = texIndex;
+			material.texCoordSets[p] = param.TextureTexCoord();
+		}
 
-			for(auto p = 0; p < matTexParams_2.size(); ++p)
-			{
-				const auto &param = gltfMatAddVals[matTexParams_2[p]];
-				auto texIndex = param.TextureIndex();
+		for(auto p = 0; p < matTexParams_2.size(); ++p)
+		{
+			const auto &param = gltfMatAddVals[matTexParams_2[p]];
+			auto texIndex = param.TextureIndex();
 
-				if(texIndex < 0) { texIndex = 0; }
+			if(texIndex < 0) { texIndex = 0; }
 
-				material.descriptors[p + toInt(TextureParam::_count_)] = texImageInfos[texIndex];
-				material.texCoordSets[p + toInt(TextureParam::_count_)] = param.TextureTexCoord();
-			}
+			material.textureIndices[p + toInt(TextureParam::_count_)] = texIndex;
+			material.texCoordSets[p + toInt(TextureParam::_count_)] = param.TextureTexCoord();
 		}
 
 		for(auto p = 0; p < matFacParams_1.size(); ++p)
@@ -159,14 +215,88 @@ void AssetHelper::loadMaterials(
 //	materials[materialCount] = Material();
 }
 
+void AssetHelper::dedupMaterials(vk::Model::Data &_data) noexcept
+{
+	auto &materials = _data.materials;
+	const auto materialCount = materials.size();
+
+	const auto isEqual = [](const Material &_a, const Material &_b)
+	{
+		const auto isArrayEqual = [](const auto &_lhs, const auto &_rhs)
+		{ return std::equal(_lhs.begin(), _lhs.end(), _rhs.begin()); };
+
+		return
+			_a.alphaMode		== _b.alphaMode		&&
+			_a.alphaCutoff	== _b.alphaCutoff	&&
+			_a.doubleSided	== _b.doubleSided	&&
+			isArrayEqual(_a.textureIndices,	_b.textureIndices)	&&
+			isArrayEqual(_a.texCoordSets,		_b.texCoordSets)		&&
+			isArrayEqual(_a.factors,				_b.factors)					&&
+			isArrayEqual(_a.colorFactors,		_b.colorFactors);
+	};
+
+	std::vector<int>			remap(materialCount);
+	std::vector<Material>	uniqueMaterials;
+
+	for(auto m = 0u; m < materialCount; ++m)
+	{
+		const auto &material = materials[m];
+		const auto found = std::find_if(
+			uniqueMaterials.begin(), uniqueMaterials.end(),
+			[&](const Material &_unique) { return isEqual(material, _unique); }
+		);
+
+		remap[m] = static_cast<int>(std::distance(uniqueMaterials.begin(), found));
+
+		if(found == uniqueMaterials.end())
+		{
+			uniqueMaterials.push_back(material);
+		}
+	}
+
+	if(uniqueMaterials.size() == materialCount) { return; }
+
+	INFO_LOG("Deduplicated materials: %zu -> %zu", materialCount, uniqueMaterials.size());
+
+	vk::Model::forEachNode(_data.nodes, [&](const NodePtr &_node)
+	{
+		for(auto &primitive : _node->mesh.primitives)
+		{
+			if(primitive.matIndex > -1) { primitive.matIndex = remap[primitive.matIndex]; }
+		}
+	});
+
+	materials = std::move(uniqueMaterials);
+}
+
+void AssetHelper::setMaterialDescriptors(
+	const vk::Texture::Data	&_textureData,
+	vk::Model::Data					&_data
+) noexcept
+{
+	const auto &texImageInfos = _textureData.imageInfos;
+
+	if(texImageInfos.empty()) { return; }
+
+	for(auto &material : _data.materials)
+	{
+		for(auto d = 0u; d < Material::descCount; ++d)
+		{
+			const auto texIndex = static_cast<size_t>(material.textureIndices[d]);
+
+			material.descriptors[d] = texImageInfos[texIndex < texImageInfos.size() ? texIndex : 0];
+		}
+	}
+}
+
 void AssetHelper::loadTextures(
-	const DevicePtr		&_device,
-	const gltfModel		&_model,
-	const std::string	&_textureDir,
-	vk::Texture::Data	&_textureData
+	const DevicePtr									&_device,
+	const std::vector<std::string>	&_textureUris,
+	const std::string								&_textureDir,
+	vk::Texture::Data								&_textureData
 )	noexcept
 {
-	const auto textureCount = _model.textures.size();
+	const auto textureCount = _textureUris.size();
 
 	// Empty texture
 	if(textureCount < 1)
@@ -180,12 +310,9 @@ void AssetHelper::loadTextures(
 	_textureData.resize(textureCount);
 	for(auto tex = 0u; tex < textureCount; ++tex)
 	{
-		auto &gltfTexture = _model.textures[tex];
-		auto &gltfImage = _model.images[gltfTexture.source];
-
 		vk::Texture::load(
 			_device,
-			_textureDir + gltfImage.uri,
+			_textureDir + _textureUris[tex],
 			VK_FORMAT_R8G8B8A8_UNORM,
 			tex, _textureData
 		);
@@ -234,6 +361,7 @@ void AssetHelper::loadNode(
 	const gltfModel				&_model,
 	float 								_scale,
 	vk::Model::Data				&_data,
+	MeshNodes							&_meshNodes,
 	const NodePtr					&_parent
 ) noexcept
 {
@@ -247,14 +375,21 @@ void AssetHelper::loadNode(
 		{
 //			INFO_LOG("node child index: %d", n);
 
-			loadNode(_model.nodes[nodeChildren[n]], _model, _scale, _data, newNode);
+			loadNode(_model.nodes[nodeChildren[n]], _model, _scale, _data, _meshNodes, newNode);
 		}
 	}
 
-	if(_node.mesh > -1)
+	// mesh already loaded by another node: same geometry (instanced at draw time), primitives copied once cooked
+	if(_node.mesh > -1 && _meshNodes.sources[_node.mesh])
+	{
+		_meshNodes.instances.emplace_back(newNode, _meshNodes.sources[_node.mesh]);
+	}
+	else if(_node.mesh > -1)
 	{
 		const auto &mesh = _model.meshes[_node.mesh];
 
+		_meshNodes.sources[_node.mesh] = newNode;
+
 //		std::unique_ptr<vk::Model::Mesh> newMesh;
 
 //		newMesh.name = mesh.name;
@@ -313,6 +448,7 @@ void AssetHelper::loadNode(
 
 			Primitive newPrimitive;
 			newPrimitive.indexParams.firstIndex = firstIdx;
+			newPrimitive.firstVertex						= firstVtx;
 			newPrimitive.idxCount								= idxCount;
 			newPrimitive.vtxCount								= vtxCount;
 			newPrimitive.matIndex								= primitive.material;
@@ -326,6 +462,19 @@ void AssetHelper::loadNode(
 	nodes.push_back(newNode);
 }
 
+void AssetHelper::shareMeshes(const MeshNodes &_meshNodes) noexcept
+{
+	for(const auto &[instance, source] : _meshNodes.instances)
+	{
+		instance->mesh.primitives = source->mesh.primitives;
+	}
+
+	if(!_meshNodes.instances.empty())
+	{
+		INFO_LOG("Shared meshes: %zu node(s) reuse an already loaded mesh", _meshNodes.instances.size());
+	}
+}
+
 const AssetHelper::gltfAccessor &AssetHelper::getAccessor(
 	const gltfModel &_model, int _index
 ) noexcept
@@ -0,0 +1,820 @@
+#include "MeshOptimizer.h"
+
+void MeshOptimizer::optimize(vk::Model::Data &_data) noexcept
+{
+	auto &indices		= _data.indices;
+	auto &vertices	= _data.vertices;
+
+	CacheStats statsBefore, statsAfter;
+
+	TIMER(start);
+
+	vk::Model::forEachNode(_data.nodes, [&](const NodePtr &_node)
+	{
+		for(const auto &primitive : _node->mesh.primitives)
+		{
+			const auto firstIdx		= primitive.indexParams.firstIndex;
+			const auto firstVtx		= primitive.firstVertex;
+			const auto idxCount		= primitive.idxCount;
+			const auto vtxCount		= primitive.vtxCount;
+
+			if(idxCount < 3 || idxCount % 3 != 0 || vtxCount == 0) { continue; }
+
+			auto primIndices = &indices[firstIdx];
+			std::vector<uint32_t> clusters;
+
+			// indices are absolute (based on vertex offset), rebase to primitive-local for processing
+			for(auto i = 0u; i < idxCount; ++i) { primIndices[i] -= firstVtx; }
+
+			statsBefore += analyzeVertexCache(primIndices, idxCount, vtxCount);
+
+			optimizeVertexCache	(primIndices, idxCount, vtxCount, clusters);
+			optimizeOverdraw		(primIndices, idxCount, &vertices[firstVtx], clusters);
+			optimizeVertexFetch	(primIndices, idxCount, &vertices[firstVtx], vtxCount);
+
+			statsAfter += analyzeVertexCache(primIndices, idxCount, vtxCount);
+
+			for(auto i = 0u; i < idxCount; ++i) { primIndices[i] += firstVtx; }
+		}
+	});
+
+	TIMER(end);
+
+	INFO_LOG(
+		"Vertex cache optimization (FIFO %u) in %.2f ms:\n"
+		"  ACMR: %.3f -> %.3f\n"
+		"  ATVR: %.3f -> %.3f",
+		s_cacheSize, TIME_DIFF(start, end),
+		statsBefore.getACMR(), statsAfter.getACMR(),
+		statsBefore.getATVR(), statsAfter.getATVR()
+	);
+}
+
+// Tipsify (Sander, Nehab & Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007)
+void MeshOptimizer::optimizeVertexCache(
+	uint32_t							*_indices,
+	size_t								_idxCount,
+	uint32_t							_vtxCount,
+	std::vector<uint32_t>	&_clusters,
+	uint32_t							_cacheSize
+) noexcept
+{
+	const auto triCount = static_cast<uint32_t>(_idxCount / 3);
+
+	std::vector<uint32_t>	liveTriCounts	(_vtxCount, 0);
+	std::vector<uint32_t>	adjOffsets		(_vtxCount + 1, 0);
+	std::vector<uint32_t>	adjTriangles	(_idxCount);
+	std::vector<uint32_t>	cacheTimes		(_vtxCount, 0);
+	std::vector<bool>			isEmitted			(triCount, false);
+	std::vector<uint32_t>	deadEnds;
+	std::vector<uint32_t>	candidates;
+	std::vector<uint32_t>	output;
+
+	// vertex -> triangles adjacency (CSR)
+	for(auto i = 0u; i < _idxCount; ++i) { liveTriCounts[_indices[i]]++; }
+	for(auto v = 0u; v < _vtxCount; ++v) { adjOffsets[v + 1] = adjOffsets[v] + liveTriCounts[v]; }
+	{
+		auto fillOffsets = adjOffsets;
+
+		for(auto i = 0u; i < _idxCount; ++i) { adjTriangles[fillOffsets[_indices[i]]++] = i / 3; }
+	}
+
+	output.reserve(_idxCount);
+	deadEnds.reserve(_idxCount);
+	_clusters.clear();
+
+	uint32_t	timeStamp		= _cacheSize + 1;
+	uint32_t	cursor			= 0;
+	int32_t		fanVertex		= 0;
+	bool			isDeadEnd		= true;
+
+	while(fanVertex >= 0)
+	{
+		if(isDeadEnd) { _clusters.push_back(static_cast<uint32_t>(output.size() / 3)); }
+
+		candidates.clear();
+
+		for(auto a = adjOffsets[fanVertex]; a < adjOffsets[fanVertex + 1]; ++a)
+		{
+			const auto tri = adjTriangles[a];
+
+			if(isEmitted[tri]) { continue; }
+
+			for(auto c = 0u; c < 3; ++c)
+			{
+				const auto vtx = _indices[tri * 3 + c];
+
+				output.push_back(vtx);
+				deadEnds.push_back(vtx);
+				candidates.push_back(vtx);
+
+				liveTriCounts[vtx]--;
+
+				if(timeStamp - cacheTimes[vtx] > _cacheSize)
+				{
+					cacheTimes[vtx] = timeStamp++;
+				}
+			}
+
+			isEmitted[tri] = true;
+		}
+
+		fanVertex = getNextVertex(
+			candidates, cacheTimes, liveTriCounts, deadEnds,
+			cursor, timeStamp, _cacheSize, isDeadEnd
+		);
+	}
+
+	ASSERT(output.size() == _idxCount, "Vertex cache optimization lost triangles!");
+
+	std::copy(output.begin(), output.end(), _indices);
+}
+
+int32_t MeshOptimizer::getNextVertex(
+	const std::vector<uint32_t>	&_candidates,
+	const std::vector<uint32_t>	&_cacheTimes,
+	const std::vector<uint32_t>	&_liveTriCounts,
+	std::vector<uint32_t>				&_deadEnds,
+	uint32_t										&_cursor,
+	uint32_t										_timeStamp,
+	uint32_t										_cacheSize,
+	bool												&_isDeadEnd
+) noexcept
+{
+	int32_t		bestVertex		= -1;
+	int32_t		bestPriority	= -1;
+
+	_isDeadEnd = false;
+
+	for(const auto vtx : _candidates)
+	{
+		if(_liveTriCounts[vtx] == 0) { continue; }
+
+		// still in cache after fanning all its live triangles => prefer the oldest one
+		auto priority = 0;
+		const auto age = _timeStamp - _cacheTimes[vtx];
+
+		if(age + 2 * _liveTriCounts[vtx] <= _cacheSize) { priority = static_cast<int32_t>(age); }
+
+		if(priority > bestPriority)
+		{
+			bestPriority	= priority;
+			bestVertex		= static_cast<int32_t>(vtx);
+		}
+	}
+
+	if(bestVertex > -1) { return bestVertex; }
+
+	// dead end: recently used vertices first, then the next vertex in input order
+	_isDeadEnd = true;
+
+	while(!_deadEnds.empty())
+	{
+		const auto vtx = _deadEnds.back();
+		_deadEnds.pop_back();
+
+		if(_liveTriCounts[vtx] > 0) { return static_cast<int32_t>(vtx); }
+	}
+
+	for(; _cursor < _liveTriCounts.size(); ++_cursor)
+	{
+		if(_liveTriCounts[_cursor] > 0) { return static_cast<int32_t>(_cursor); }
+	}
+
+	return -1;
+}
+
+// Orders the Tipsify clusters outside-in (by the cluster's facing relative to the mesh centroid),
+// so occluders tend to be drawn before what they occlude.
+void MeshOptimizer::optimizeOverdraw(
+	uint32_t										*_indices,
+	size_t											_idxCount,
+	const Vertex								*_vertices,
+	const std::vector<uint32_t>	&_clusters
+) noexcept
+{
+	const auto triCount			= static_cast<uint32_t>(_idxCount / 3);
+	const auto clusterCount	= _clusters.size();
+
+	if(clusterCount < 2) { return; }
+
+	struct Cluster
+	{
+		uint32_t	firstTri	= 0;
+		uint32_t	triCount	= 0;
+		glm::vec3	centroid	= glm::vec3(0.0f);
+		glm::vec3	normal		= glm::vec3(0.0f);
+		float			sortKey		= 0.0f;
+	};
+
+	std::vector<Cluster> clusters(clusterCount);
+
+	auto meshCentroid	= glm::vec3(0.0f);
+	auto meshArea			= 0.0f;
+
+	for(auto c = 0u; c < clusterCount; ++c)
+	{
+		auto &cluster = clusters[c];
+		auto area = 0.0f;
+
+		cluster.firstTri	= _clusters[c];
+		cluster.triCount	= (c + 1 < clusterCount ? _clusters[c + 1] : triCount) - cluster.firstTri;
+
+		for(auto t = cluster.firstTri; t < cluster.firstTri + cluster.triCount; ++t)
+		{
+			const auto &p0 = _vertices[_indices[t * 3 + 0]].position;
+			const auto &p1 = _vertices[_indices[t * 3 + 1]].position;
+			const auto &p2 = _vertices[_indices[t * 3 + 2]].position;
+
+			const auto faceNormal	= glm::cross(p1 - p0, p2 - p0); // length = 2 * area
+			const auto triArea		= glm::length(faceNormal) * 0.5f;
+
+			cluster.centroid	+= (p0 + p1 + p2) * (triArea / 3.0f);
+			cluster.normal		+= faceNormal;
+			area							+= triArea;
+		}
+
+		meshCentroid	+= cluster.centroid;
+		meshArea			+= area;
+
+		cluster.centroid = area > 0.0f ? cluster.centroid / area : _vertices[_indices[cluster.firstTri * 3]].position;
+
+		const auto normalLength = glm::length(cluster.normal);
+		cluster.normal = normalLength > 0.0f ? cluster.normal / normalLength : glm::vec3(0.0f);
+	}
+
+	meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : glm::vec3(0.0f);
+
+	for(auto &cluster : clusters)
+	{
+		cluster.sortKey = glm::dot(cluster.centroid - meshCentroid, cluster.normal);
+	}
+
+	std::stable_sort(
+		clusters.begin(), clusters.end(),
+		[](const Cluster &_a, const Cluster &_b) { return _a.sortKey > _b.sortKey; }
+	);
+
+	std::vector<uint32_t> output;
+	output.reserve(_idxCount);
+
+	for(const auto &cluster : clusters)
+	{
+		output.insert(
+			output.end(),
+			_indices + cluster.firstTri * 3,
+			_indices + (cluster.firstTri + cluster.triCount) * 3
+		);
+	}
+
+	std::copy(output.begin(), output.end(), _indices);
+}
+
+// Reorders vertices in first-use order, so vertex fetches walk memory linearly.
+void MeshOptimizer::optimizeVertexFetch(
+	uint32_t	*_indices,
+	size_t		_idxCount,
+	Vertex		*_vertices,
+	uint32_t	_vtxCount
+) noexcept
+{
+	const auto UNUSED = std::numeric_limits<uint32_t>::max();
+
+	std::vector<uint32_t>	remap(_vtxCount, UNUSED);
+	std::vector<Vertex>		reordered;
+	uint32_t nextVtx = 0;
+
+	reordered.reserve(_vtxCount);
+
+	for(auto i = 0u; i < _idxCount; ++i)
+	{
+		auto &index = _indices[i];
+
+		if(remap[index] == UNUSED)
+		{
+			remap[index] = nextVtx++;
+			reordered.push_back(_vertices[index]);
+		}
+
+		index = remap[index];
+	}
+
+	// keep unreferenced vertices (at the end), so the primitive's vertex range stays intact
+	for(auto v = 0u; v < _vtxCount; ++v)
+	{
+		if(remap[v] == UNUSED) { reordered.push_back(_vertices[v]); }
+	}
+
+	std::copy(reordered.begin(), reordered.end(), _vertices);
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::analyzeVertexCache(
+	const uint32_t	*_indices,
+	size_t					_idxCount,
+	uint32_t				_vtxCount,
+	uint32_t				_cacheSize
+) noexcept
+{
+	CacheStats stats;
+
+	std::vector<uint32_t> cacheTimes(_vtxCount, 0);
+	std::vector<bool>			isUsed(_vtxCount, false);
+	uint32_t timeStamp = _cacheSize + 1;
+
+	for(auto i = 0u; i < _idxCount; ++i)
+	{
+		const auto vtx = _indices[i];
+
+		// FIFO: a vertex is a hit if it entered the cache less than cacheSize misses ago
+		if(timeStamp - cacheTimes[vtx] > _cacheSize)
+		{
+			cacheTimes[vtx] = timeStamp++;
+			stats.missCount++;
+		}
+
+		if(!isUsed[vtx])
+		{
+			isUsed[vtx] = true;
+			stats.vertexCount++;
+		}
+	}
+
+	stats.triangleCount = static_cast<uint32_t>(_idxCount / 3);
+
+	return stats;
+}
+
+// Per primitive LOD chain: each LOD simplifies the previous one (errors accumulate monotonically),
+// its indices get appended to the model's index buffer & vertex cache optimized.
+void MeshOptimizer::generateLods(vk::Model::Data &_data) noexcept
+{
+	auto &indices		= _data.indices;
+	auto &vertices	= _data.vertices;
+
+	size_t srcIdxCount = 0, lodIdxCount = 0;
+
+	TIMER(start);
+
+	vk::Model::forEachNode(_data.nodes, [&](const NodePtr &_node)
+	{
+		for(auto &primitive : _node->mesh.primitives)
+		{
+			const auto firstVtx = primitive.firstVertex;
+			const auto vtxCount = primitive.vtxCount;
+
+			primitive.lodCount = 0;
+
+			if(primitive.idxCount == 0 || vtxCount == 0) { continue; }
+
+			// bounding box & sphere (box center, max. distance)
+			auto posMin = vertices[firstVtx].position, posMax = posMin;
+
+			for(auto v = firstVtx; v < firstVtx + vtxCount; ++v)
+			{
+				posMin = glm::min(posMin, vertices[v].position);
+				posMax = glm::max(posMax, vertices[v].position);
+			}
+
+			primitive.center = (posMin + posMax) * 0.5f;
+			primitive.extent = (posMax - posMin) * 0.5f;
+			primitive.radius = 0.0f;
+
+			for(auto v = firstVtx; v < firstVtx + vtxCount; ++v)
+			{
+				primitive.radius = std::max(primitive.radius, glm::length(vertices[v].position - primitive.center));
+			}
+
+			srcIdxCount += primitive.idxCount;
+
+			if(primitive.idxCount % 3 != 0) { continue; }
+
+			std::vector<uint32_t> prevIndices(
+				indices.begin() + primitive.indexParams.firstIndex,
+				indices.begin() + primitive.indexParams.firstIndex + primitive.idxCount
+			);
+			std::vector<uint32_t> lodIndices;
+			auto error = 0.0f;
+
+			for(auto &index : prevIndices) { index -= firstVtx; }
+
+			while(primitive.lodCount < vk::Model::s_lodCount - 1 && prevIndices.size() >= s_lodMinIdxCount)
+			{
+				const auto targetIdxCount = static_cast<size_t>(prevIndices.size() * s_lodReduction) / 3 * 3;
+
+				// each level simplifies the previous one: its deviation from LOD0 is bounded by the sum of the steps'
+				error += simplify(
+					prevIndices.data(), prevIndices.size(),
+					&vertices[firstVtx], vtxCount,
+					targetIdxCount, lodIndices
+				);
+
+				// not worth a LOD level (locked borders/seams)
+				if(lodIndices.empty() || lodIndices.size() > prevIndices.size() * 0.85f) { break; }
+
+				std::vector<uint32_t> clusters;
+				optimizeVertexCache(lodIndices.data(), lodIndices.size(), vtxCount, clusters);
+
+				auto &lod = primitive.lods[primitive.lodCount++];
+				lod.firstIndex	= static_cast<uint32_t>(indices.size());
+				lod.idxCount		= static_cast<uint32_t>(lodIndices.size());
+				lod.error				= error;
+
+				for(const auto index : lodIndices) { indices.push_back(index + firstVtx); }
+
+				lodIdxCount += lodIndices.size();
+				prevIndices.swap(lodIndices);
+			}
+		}
+	});
+
+	TIMER(end);
+
+	INFO_LOG(
+		"LOD generation in %.2f ms: %zu source + %zu LOD indices",
+		TIME_DIFF(start, end), srcIdxCount, lodIdxCount
+	);
+}
+
+// Quadric error edge collapse (Garland & Heckbert, "Surface Simplification Using Quadric Error Metrics", 1997),
+// collapsing vertices onto existing ones (attributes stay intact). Border & attribute seam vertices are locked,
+// so the result stays crack free between primitives & across UV seams.
+float MeshOptimizer::simplify(
+	const uint32_t				*_indices,
+	size_t								_idxCount,
+	const Vertex					*_vertices,
+	uint32_t							_vtxCount,
+	size_t								_targetIdxCount,
+	std::vector<uint32_t>	&_outIndices
+) noexcept
+{
+	struct Collapse
+	{
+		uint32_t	from	= 0;
+		uint32_t	to		= 0;
+		float			error	= 0.0f;
+	};
+
+	_outIndices.assign(_indices, _indices + _idxCount);
+
+	// position welding (vertices split by attributes)
+	std::map<std::tuple<float, float, float>, uint32_t>	positionIds;
+	std::vector<uint32_t>																wedges(_vtxCount);
+	std::vector<uint32_t>																wedgeCounts(_vtxCount, 0);
+
+	for(auto v = 0u; v < _vtxCount; ++v)
+	{
+		const auto &pos = _vertices[v].position;
+
+		wedges[v] = positionIds.emplace(std::make_tuple(pos.x, pos.y, pos.z), v).first->second;
+		wedgeCounts[wedges[v]]++;
+	}
+
+	// border edges (in welded space)
+	std::map<uint64_t, uint32_t> edgeCounts;
+
+	const auto getEdgeKey = [](uint32_t _a, uint32_t _b)
+	{ return (uint64_t(std::min(_a, _b)) << 32) | std::max(_a, _b); };
+
+	for(auto i = 0u; i < _idxCount; i += 3)
+	{
+		for(auto e = 0u; e < 3; ++e)
+		{
+			edgeCounts[getEdgeKey(wedges[_indices[i + e]], wedges[_indices[i + (e + 1) % 3]])]++;
+		}
+	}
+
+	std::vector<bool> isLocked(_vtxCount, false);
+
+	for(auto v = 0u; v < _vtxCount; ++v) { isLocked[v] = wedgeCounts[wedges[v]] > 1; }
+
+	for(auto i = 0u; i < _idxCount; i += 3)
+	{
+		for(auto e = 0u; e < 3; ++e)
+		{
+			const auto a = _indices[i + e], b = _indices[i + (e + 1) % 3];
+
+			if(edgeCounts[getEdgeKey(wedges[a], wedges[b])] == 1) { isLocked[a] = isLocked[b] = true; }
+		}
+	}
+
+	// vertex quadrics
+	std::vector<Quadric> quadrics(_vtxCount);
+
+	for(auto i = 0u; i < _idxCount; i += 3)
+	{
+		const auto &p0 = _vertices[_indices[i + 0]].position;
+		const auto &p1 = _vertices[_indices[i + 1]].position;
+		const auto &p2 = _vertices[_indices[i + 2]].position;
+
+		const auto normal	= glm::cross(p1 - p0, p2 - p0);
+		const auto length	= glm::length(normal);
+
+		if(length <= 0.0f) { continue; }
+
+		const auto unitNormal	= normal / length;
+		const auto quadric		= Quadric::fromPlane(unitNormal, -glm::dot(unitNormal, p0), length * 0.5f);
+
+		for(auto c = 0u; c < 3; ++c) { quadrics[_indices[i + c]] += quadric; }
+	}
+
+	std::vector<uint32_t>	remap(_vtxCount);
+	std::vector<bool>			isTouched(_vtxCount);
+	std::vector<uint32_t>	adjOffsets(_vtxCount + 1);
+	std::vector<uint32_t>	adjTriangles;
+	std::vector<Collapse>	collapses;
+	auto maxError = 0.0f;
+
+	const auto getPos = [&](uint32_t _v) -> const glm::vec3& { return _vertices[_v].position; };
+
+	while(_outIndices.size() > _targetIdxCount)
+	{
+		const auto idxCount = _outIndices.size();
+
+		// vertex -> triangles adjacency (CSR)
+		std::fill(adjOffsets.begin(), adjOffsets.end(), 0);
+		adjTriangles.resize(idxCount);
+
+		for(auto i = 0u; i < idxCount; ++i) { adjOffsets[_outIndices[i] + 1]++; }
+		for(auto v = 0u; v < _vtxCount; ++v) { adjOffsets[v + 1] += adjOffsets[v]; }
+		{
+			auto fillOffsets = adjOffsets;
+
+			for(auto i = 0u; i < idxCount; ++i) { adjTriangles[fillOffsets[_outIndices[i]]++] = i / 3; }
+		}
+
+		// candidates: free vertex -> edge neighbour
+		collapses.clear();
+
+		for(auto i = 0u; i < idxCount; i += 3)
+		{
+			for(auto e = 0u; e < 3; ++e)
+			{
+				const auto from	= _outIndices[i + e];
+				const auto to		= _outIndices[i + (e + 1) % 3];
+
+				for(const auto &[a, b] : { std::make_pair(from, to), std::make_pair(to, from) })
+				{
+					if(isLocked[a]) { continue; }
+
+					auto quadric = quadrics[a];
+					quadric += quadrics[b];
+
+					collapses.push_back({ a, b, quadric.getError(getPos(b)) });
+				}
+			}
+		}
+
+		std::sort(
+			collapses.begin(), collapses.end(),
+			[](const Collapse &_a, const Collapse &_b) { return _a.error < _b.error; }
+		);
+
+		// each collapse removes ~2 triangles
+		const auto collapseBudget = (idxCount - _targetIdxCount) / 6 + 1;
+		auto collapseCount = 0u;
+
+		for(auto v = 0u; v < _vtxCount; ++v) { remap[v] = v; }
+		std::fill(isTouched.begin(), isTouched.end(), false);
+
+		for(const auto &collapse : collapses)
+		{
+			if(collapseCount >= collapseBudget) { break; }
+
+			const auto from = collapse.from, to = collapse.to;
+
+			if(isTouched[from] || isTouched[to]) { continue; }
+
+			// reject collapses flipping (or degenerating into slivers) the surviving triangles
+			auto isFlipped = false;
+
+			for(auto a = adjOffsets[from]; a < adjOffsets[from + 1] && !isFlipped; ++a)
+			{
+				const auto tri = adjTriangles[a] * 3;
+				uint32_t triVtx[3];
+
+				for(auto c = 0u; c < 3; ++c) { triVtx[c] = remap[_outIndices[tri + c]]; }
+
+				if(triVtx[0] == to || triVtx[1] == to || triVtx[2] == to) { continue; } // removed by the collapse
+
+				const auto normalBefore = glm::cross(getPos(triVtx[1]) - getPos(triVtx[0]), getPos(triVtx[2]) - getPos(triVtx[0]));
+
+				for(auto &vtx : triVtx) { vtx = vtx == from ? to : vtx; }
+
+				const auto normalAfter = glm::cross(getPos(triVtx[1]) - getPos(triVtx[0]), getPos(triVtx[2]) - getPos(triVtx[0]));
+
+				isFlipped = glm::dot(normalBefore, normalAfter) <= 0.25f * glm::length(normalBefore) * glm::length(normalAfter);
+			}
+
+			if(isFlipped) { continue; }
+
+			remap[from]			= to;
+			quadrics[to]		+= quadrics[from];
+			isTouched[from]	= isTouched[to] = true;
+			maxError				= std::max(maxError, collapse.error);
+
+			collapseCount++;
+		}
+
+		if(collapseCount == 0) { break; }
+
+		// apply & drop degenerate triangles
+		auto writeIdx = 0u;
+
+		for(auto i = 0u; i < idxCount; i += 3)
+		{
+			const auto i0 = remap[_outIndices[i]], i1 = remap[_outIndices[i + 1]], i2 = remap[_outIndices[i + 2]];
+
+			if(i0 == i1 || i1 == i2 || i0 == i2) { continue; }
+
+			_outIndices[writeIdx++] = i0;
+			_outIndices[writeIdx++] = i1;
+			_outIndices[writeIdx++] = i2;
+		}
+
+		_outIndices.resize(writeIdx);
+	}
+
+	return std::sqrt(maxError);
+}
+
+MeshOptimizer::Quadric MeshOptimizer::Quadric::fromPlane(const glm::vec3 &_normal, float _distance, float _weight) noexcept
+{
+	Quadric quadric;
+
+	quadric.a00	= _weight * _normal.x * _normal.x;
+	quadric.a11	= _weight * _normal.y * _normal.y;
+	quadric.a22	= _weight * _normal.z * _normal.z;
+	quadric.a10	= _weight * _normal.y * _normal.x;
+	quadric.a20	= _weight * _normal.z * _normal.x;
+	quadric.a21	= _weight * _normal.z * _normal.y;
+	quadric.b0	= _weight * _normal.x * _distance;
+	quadric.b1	= _weight * _normal.y * _distance;
+	quadric.b2	= _weight * _normal.z * _distance;
+	quadric.c		= _weight * _distance * _distance;
+	quadric.w		= _weight;
+
+	return quadric;
+}
+
+MeshOptimizer::Quadric &MeshOptimizer::Quadric::operator+=(const Quadric &_quadric) noexcept
+{
+	a00 += _quadric.a00; a11 += _quadric.a11; a22 += _quadric.a22;
+	a10 += _quadric.a10; a20 += _quadric.a20; a21 += _quadric.a21;
+	b0	+= _quadric.b0;	 b1	 += _quadric.b1;	b2	+= _quadric.b2;
+	c		+= _quadric.c;
+	w		+= _quadric.w;
+
+	return *this;
+}
+
+float MeshOptimizer::Quadric::getError(const glm::vec3 &_pos) const noexcept
+{
+	const auto x = _pos.x, y = _pos.y, z = _pos.z;
+
+	// p^T A p + 2 b.p + c
+	const auto error =
+		a00 * x * x + a11 * y * y + a22 * z * z +
+		2.0f * (a10 * x * y + a20 * x * z + a21 * y * z) +
+		2.0f * (b0 * x + b1 * y + b2 * z) +
+		c;
+
+	return w > 0.0f ? std::abs(error) / w : 0.0f;
+}
+
+// Greedy meshlet build in (cache optimized) index order: a meshlet is closed once the next triangle would exceed
+// its vertex or triangle budget, so every meshlet is a contiguous index range of the primitive's LOD 0.
+void MeshOptimizer::buildMeshlets(vk::Model::Data &_data) noexcept
+{
+	using Meshlet = vk::Model::Meshlet;
+
+	const auto &indices		= _data.indices;
+	const auto &vertices	= _data.vertices;
+	auto &meshlets				= _data.meshlets;
+
+	const auto maxVertices	= vk::Model::s_meshletMaxVertices;
+	const auto maxTriangles	= vk::Model::s_meshletMaxTriangles;
+
+	std::vector<uint32_t> meshletVertices;
+	meshletVertices.reserve(maxVertices);
+
+	const auto finalize = [&](Meshlet &_meshlet, const uint32_t *_primIndices)
+	{
+		// bounding sphere (bounds center, max. distance)
+		auto posMin = vertices[meshletVertices[0]].position, posMax = posMin;
+
+		for(const auto vtx : meshletVertices)
+		{
+			posMin = glm::min(posMin, vertices[vtx].position);
+			posMax = glm::max(posMax, vertices[vtx].position);
+		}
+
+		_meshlet.center = (posMin + posMax) * 0.5f;
+		_meshlet.radius = 0.0f;
+
+		for(const auto vtx : meshletVertices)
+		{
+			_meshlet.radius = std::max(_meshlet.radius, glm::length(vertices[vtx].position - _meshlet.center));
+		}
+
+		// normal cone (average face normal, widest deviation)
+		std::vector<glm::vec3> normals;
+		auto axis = glm::vec3(0.0f);
+
+		for(auto i = _meshlet.firstIndex; i < _meshlet.firstIndex + _meshlet.idxCount; i += 3)
+		{
+			const auto &p0 = vertices[_primIndices[i + 0]].position;
+			const auto &p1 = vertices[_primIndices[i + 1]].position;
+			const auto &p2 = vertices[_primIndices[i + 2]].position;
+
+			const auto normal = glm::cross(p1 - p0, p2 - p0);
+			const auto length = glm::length(normal);
+
+			if(length <= 0.0f) { continue; }
+
+			normals.push_back(normal / length);
+			axis += normals.back();
+		}
+
+		const auto axisLength = glm::length(axis);
+
+		_meshlet.coneAxis		= axisLength > 0.0f ? axis / axisLength : glm::vec3(0.0f, 0.0f, 1.0f);
+		_meshlet.coneCutoff	= 1.0f; // never culled
+
+		if(normals.empty() || axisLength <= 0.0f) { return; }
+
+		auto minDot = 1.0f;
+
+		for(const auto &normal : normals) { minDot = std::min(minDot, glm::dot(normal, _meshlet.coneAxis)); }
+
+		// cone half angle a: backfacing from every view direction within (90 - a) of the axis => cutoff = sin(a)
+		if(minDot > 0.1f) { _meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot); }
+	};
+
+	meshlets.clear();
+
+	vk::Model::forEachNode(_data.nodes, [&](const NodePtr &_node)
+	{
+		for(auto &primitive : _node->mesh.primitives)
+		{
+			primitive.firstMeshlet	= static_cast<uint32_t>(meshlets.size());
+			primitive.meshletCount	= 0;
+
+			if(primitive.idxCount < 3 || primitive.idxCount % 3 != 0) { continue; }
+
+			const auto primIndices = &indices[primitive.indexParams.firstIndex];
+
+			Meshlet meshlet;
+			meshletVertices.clear();
+
+			for(auto i = 0u; i < primitive.idxCount; i += 3)
+			{
+				auto newVtxCount = 0u;
+
+				for(auto c = 0u; c < 3; ++c)
+				{
+					const auto vtx = primIndices[i + c];
+					const auto isNew =
+						std::find(meshletVertices.begin(), meshletVertices.end(), vtx) == meshletVertices.end() &&
+						std::find(primIndices + i, primIndices + i + c, vtx) == primIndices + i + c;
+
+					newVtxCount += isNew ? 1 : 0;
+				}
+
+				if(
+					meshletVertices.size() + newVtxCount > maxVertices ||
+					meshlet.idxCount / 3 + 1 > maxTriangles
+				)
+				{
+					finalize(meshlet, primIndices);
+					meshlets.push_back(meshlet);
+
+					meshlet = Meshlet();
+					meshlet.firstIndex = i;
+					meshletVertices.clear();
+				}
+
+				for(auto c = 0u; c < 3; ++c)
+				{
+					const auto vtx = primIndices[i + c];
+
+					if(std::find(meshletVertices.begin(), meshletVertices.end(), vtx) == meshletVertices.end())
+					{
+						meshletVertices.push_back(vtx);
+					}
+				}
+
+				meshlet.idxCount += 3;
+			}
+
+			finalize(meshlet, primIndices);
+			meshlets.push_back(meshlet);
+
+			primitive.meshletCount = static_cast<uint32_t>(meshlets.size()) - primitive.firstMeshlet;
+		}
+	});
+
+	INFO_LOG(
+		"Meshlets: %zu (max. %u vertices, %u triangles)",
+		meshlets.size(), maxVertices, maxTriangles
+	);
+}
@@ -0,0 +1,337 @@
+#include "OcclusionCuller.h"
+
+void OcclusionCuller::addOccluders(const vk::Model::Data &_data) noexcept
+{
+	using Primitive = vk::Model::Primitive;
+	using AlphaMode = vk::Material::AlphaMode;
+
+	struct Candidate
+	{
+		const Primitive	*primitive;
+		glm::mat4				worldMtx;
+		float						area;
+	};
+
+	std::vector<Candidate> candidates;
+	const auto &opaqueMode = vk::Material::alphaModes[AlphaMode::OPAQUE_];
+
+	vk::Model::forEachNode(_data.nodes, [&](const vk::Model::NodePtr &_node)
+	{
+		const auto worldMtx = vk::Model::getNodeMatrix(_node);
+
+		for(const auto &primitive : _node->mesh.primitives)
+		{
+			// source range: a simplified LOD may lie outside the surface it stands for (occluding what is visible)
+			const auto lod = vk::Model::Lod{ primitive.indexParams.firstIndex, primitive.idxCount };
+
+			if(
+				lod.idxCount == 0 || lod.idxCount / 3 > s_maxOccluderTriangles ||
+				primitive.matIndex >= static_cast<int>(_data.materials.size()) ||
+				_data.materials[primitive.matIndex].alphaMode != opaqueMode
+			) { continue; }
+
+			auto extent = glm::vec3(0.0f);
+
+			for(auto c = 0; c < 3; ++c) { extent += glm::abs(glm::vec3(worldMtx[c])) * primitive.extent[c]; }
+
+			candidates.push_back({ &primitive, worldMtx, extent.x * extent.y + extent.y * extent.z + extent.z * extent.x });
+		}
+	});
+
+	const auto occluderCount = std::min<size_t>(candidates.size(), s_maxOccluders);
+
+	std::partial_sort(
+		candidates.begin(), candidates.begin() + occluderCount, candidates.end(),
+		[](const Candidate &_a, const Candidate &_b) { return _a.area > _b.area; }
+	);
+
+	const auto view = _data.getView();
+
+	for(auto c = 0u; c < occluderCount; ++c)
+	{
+		const auto &candidate	= candidates[c];
+		const auto &primitive	= *candidate.primitive;
+		const auto lod				= vk::Model::Lod{ primitive.indexParams.firstIndex, primitive.idxCount };
+
+		Occluder occluder;
+		occluder.positions.reserve(lod.idxCount);
+
+		for(auto i = lod.firstIndex; i < lod.firstIndex + lod.idxCount; ++i)
+		{
+			const auto position = glm::vec3(candidate.worldMtx * glm::vec4(view.vertices[view.indices[i]].position, 1.0f));
+
+			occluder.positions.push_back(position);
+			occluder.bounds.grow(position);
+		}
+
+		m_occluders.push_back(std::move(occluder));
+	}
+
+	INFO_LOG("Occlusion culling: %zu occluder(s) added", occluderCount);
+}
+
+void OcclusionCuller::render(const glm::mat4 &_viewProj) noexcept
+{
+	if(!isEnabled) { return; }
+
+	TIMER(start);
+
+	m_viewProj = _viewProj;
+
+	m_depth.assign(s_width * s_height, 1.0f);
+	m_blockMaxDepth.assign((s_width / s_blockSize) * (s_height / s_blockSize), 1.0f);
+	m_tileBins.resize(s_tileCountX * s_tileCountY);
+
+	setupTriangles();
+
+	vk::runJobs(s_tileCountX * s_tileCountY, [this](uint32_t _tile) { rasterizeTile(_tile); }, s_maxThreads);
+
+	TIMER(end);
+
+	m_stats.occluderTriangleCount	= static_cast<uint32_t>(m_triangles.size());
+	m_stats.rasterTime						= TIME_DIFF(start, end);
+}
+
+// clip -> screen, depth plane & tile binning (triangles touching the near plane are dropped: conservative)
+void OcclusionCuller::setupTriangles() noexcept
+{
+	m_triangles.clear();
+
+	for(auto &bin : m_tileBins) { bin.clear(); }
+
+	const auto toScreen = [](const glm::vec4 &_clip)
+	{
+		const auto ndc = glm::vec3(_clip) / _clip.w;
+
+		return glm::vec3((ndc.x * 0.5f + 0.5f) * s_width, (ndc.y * 0.5f + 0.5f) * s_height, ndc.z);
+	};
+
+	for(const auto &occluder : m_occluders)
+	{
+		const auto &positions = occluder.positions;
+
+		for(auto i = 0u; i + 2 < positions.size(); i += 3)
+		{
+			const auto c0 = m_viewProj * glm::vec4(positions[i + 0], 1.0f);
+			const auto c1 = m_viewProj * glm::vec4(positions[i + 1], 1.0f);
+			const auto c2 = m_viewProj * glm::vec4(positions[i + 2], 1.0f);
+
+			if(c0.z < 0.0f || c1.z < 0.0f || c2.z < 0.0f) { continue; }
+
+			auto s0 = toScreen(c0), s1 = toScreen(c1), s2 = toScreen(c2);
+
+			// double sided: wind all triangles counter clockwise
+			auto area = (s1.x - s0.x) * (s2.y - s0.y) - (s1.y - s0.y) * (s2.x - s0.x);
+
+			if(std::abs(area) < 1e-6f) { continue; }
+			if(area < 0.0f) { std::swap(s1, s2); area = -area; }
+
+			ScreenTriangle triangle;
+
+			triangle.rect = glm::ivec4(
+				std::max(0,													static_cast<int>(std::floor(std::min(std::min(s0.x, s1.x), s2.x)))),
+				std::max(0,													static_cast<int>(std::floor(std::min(std::min(s0.y, s1.y), s2.y)))),
+				std::min(static_cast<int>(s_width),		static_cast<int>(std::ceil (std::max(std::max(s0.x, s1.x), s2.x)))),
+				std::min(static_cast<int>(s_height),	static_cast<int>(std::ceil (std::max(std::max(s0.y, s1.y), s2.y))))
+			);
+
+			if(triangle.rect.x >= triangle.rect.z || triangle.rect.y >= triangle.rect.w) { continue; }
+
+			triangle.v0 = glm::vec2(s0);
+			triangle.v1 = glm::vec2(s1);
+			triangle.v2 = glm::vec2(s2);
+
+			// depth plane through the 3 vertices
+			const auto e1 = s1 - s0, e2 = s2 - s0;
+			const auto a = (e1.z * e2.y - e2.z * e1.y) / area;
+			const auto b = (e2.z * e1.x - e1.z * e2.x) / area;
+
+			triangle.depthPlane = glm::vec3(a, b, s0.z - a * s0.x - b * s0.y);
+
+			const auto index = static_cast<uint32_t>(m_triangles.size());
+			m_triangles.push_back(triangle);
+
+			for(auto ty = triangle.rect.y / s_tileHeight; ty <= (triangle.rect.w - 1) / s_tileHeight; ++ty)
+			{
+				for(auto tx = triangle.rect.x / s_tileWidth; tx <= (triangle.rect.z - 1) / s_tileWidth; ++tx)
+				{
+					m_tileBins[ty * s_tileCountX + tx].push_back(index);
+				}
+			}
+		}
+	}
+}
+
+void OcclusionCuller::rasterizeTile(uint32_t _tile) noexcept
+{
+	const auto tileX = static_cast<int>((_tile % s_tileCountX) * s_tileWidth);
+	const auto tileY = static_cast<int>((_tile / s_tileCountX) * s_tileHeight);
+
+	for(const auto t : m_tileBins[_tile])
+	{
+		const auto &triangle = m_triangles[t];
+
+		const auto x0 = std::max(tileX, triangle.rect.x) & ~3; // 4-pixel aligned
+		const auto x1 = std::min(tileX + static_cast<int>(s_tileWidth),		triangle.rect.z);
+		const auto y0 = std::max(tileY, triangle.rect.y);
+		const auto y1 = std::min(tileY + static_cast<int>(s_tileHeight),	triangle.rect.w);
+
+		// edge functions: E(x, y) = (y - a.y) * (b.x - a.x) - (x - a.x) * (b.y - a.y) >= 0 inside (ccw)
+		const glm::vec2 edges[3][2] = {
+			{ triangle.v0, triangle.v1 }, { triangle.v1, triangle.v2 }, { triangle.v2, triangle.v0 }
+		};
+
+		for(auto y = y0; y < y1; ++y)
+		{
+			const auto py = static_cast<float>(y) + 0.5f;
+			auto depthRow = &m_depth[y * s_width];
+
+			for(auto x = x0; x < x1; x += 4)
+			{
+#ifdef USE_SSE
+				const auto px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x) + 0.5f), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+				auto inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());	// all lanes set
+
+				for(const auto &edge : edges)
+				{
+					const auto &a = edge[0], &b = edge[1];
+					const auto value = _mm_sub_ps(
+						_mm_set1_ps((py - a.y) * (b.x - a.x)),
+						_mm_mul_ps(_mm_sub_ps(px, _mm_set1_ps(a.x)), _mm_set1_ps(b.y - a.y))
+					);
+
+					inside = _mm_and_ps(inside, _mm_cmpge_ps(value, _mm_setzero_ps()));
+				}
+
+				if(_mm_movemask_ps(inside) == 0) { continue; }
+
+				const auto &plane = triangle.depthPlane;
+				const auto depth = _mm_add_ps(
+					_mm_mul_ps(px, _mm_set1_ps(plane.x)),
+					_mm_set1_ps(py * plane.y + plane.z)
+				);
+
+				const auto prevDepth	= _mm_loadu_ps(depthRow + x);
+				const auto minDepth		= _mm_min_ps(prevDepth, depth);
+
+				_mm_storeu_ps(depthRow + x, _mm_or_ps(_mm_and_ps(inside, minDepth), _mm_andnot_ps(inside, prevDepth)));
+#else
+				for(auto p = x; p < x + 4; ++p)
+				{
+					const auto px = static_cast<float>(p) + 0.5f;
+					auto isInside = true;
+
+					for(const auto &edge : edges)
+					{
+						const auto &a = edge[0], &b = edge[1];
+
+						isInside = isInside && (py - a.y) * (b.x - a.x) - (px - a.x) * (b.y - a.y) >= 0.0f;
+					}
+
+					if(isInside)
+					{
+						const auto &plane = triangle.depthPlane;
+
+						depthRow[p] = std::min(depthRow[p], px * plane.x + py * plane.y + plane.z);
+					}
+				}
+#endif
+			}
+		}
+	}
+
+	// per block max. depth
+	const auto blockCountX = s_width / s_blockSize;
+
+	for(auto by = tileY / s_blockSize; by < (tileY + s_tileHeight) / s_blockSize; ++by)
+	{
+		for(auto bx = tileX / s_blockSize; bx < (tileX + s_tileWidth) / s_blockSize; ++bx)
+		{
+			auto maxDepth = 0.0f;
+
+			for(auto y = by * s_blockSize; y < (by + 1) * s_blockSize; ++y)
+			{
+				for(auto x = bx * s_blockSize; x < (bx + 1) * s_blockSize; ++x)
+				{
+					maxDepth = std::max(maxDepth, m_depth[y * s_width + x]);
+				}
+			}
+
+			m_blockMaxDepth[by * blockCountX + bx] = maxDepth;
+		}
+	}
+}
+
+bool OcclusionCuller::isOccluded(const Aabb &_bounds) const noexcept
+{
+	auto rectMin	= glm::vec2( std::numeric_limits<float>::max());
+	auto rectMax	= glm::vec2(-std::numeric_limits<float>::max());
+	auto minDepth	= 1.0f;
+
+	for(auto c = 0u; c < 8; ++c)
+	{
+		const auto corner = glm::vec3(
+			c & 1 ? _bounds.max.x : _bounds.min.x,
+			c & 2 ? _bounds.max.y : _bounds.min.y,
+			c & 4 ? _bounds.max.z : _bounds.min.z
+		);
+		const auto clip = m_viewProj * glm::vec4(corner, 1.0f);
+
+		if(clip.w <= 1e-4f || clip.z < 0.0f) { return false; } // crosses the near plane
+
+		const auto ndc = glm::vec3(clip) / clip.w;
+		const auto pixel = glm::vec2((ndc.x * 0.5f + 0.5f) * s_width, (ndc.y * 0.5f + 0.5f) * s_height);
+
+		rectMin		= glm::min(rectMin, pixel);
+		rectMax		= glm::max(rectMax, pixel);
+		minDepth	= std::min(minDepth, ndc.z);
+	}
+
+	const auto blockCountX = static_cast<int>(s_width / s_blockSize);
+	const auto blockCountY = static_cast<int>(s_height / s_blockSize);
+
+	const auto bx0 = std::max(0,								static_cast<int>(std::floor(rectMin.x)) / static_cast<int>(s_blockSize));
+	const auto by0 = std::max(0,								static_cast<int>(std::floor(rectMin.y)) / static_cast<int>(s_blockSize));
+	const auto bx1 = std::min(blockCountX - 1,	static_cast<int>(std::floor(rectMax.x)) / static_cast<int>(s_blockSize));
+	const auto by1 = std::min(blockCountY - 1,	static_cast<int>(std::floor(rectMax.y)) / static_cast<int>(s_blockSize));
+
+	if(bx0 > bx1 || by0 > by1) { return false; } // off screen: left to frustum culling
+
+	for(auto by = by0; by <= by1; ++by)
+	{
+		for(auto bx = bx0; bx <= bx1; ++bx)
+		{
+			if(minDepth <= m_blockMaxDepth[by * blockCountX + bx]) { return false; }
+		}
+	}
+
+	return true;
+}
+
+void OcclusionCuller::cull(
+	const SceneBvh				&_bvh,
+	std::vector<uint32_t>	&_visible,
+	std::vector<uint32_t>	&_occluded
+) noexcept
+{
+	m_stats.testedCount	= static_cast<uint32_t>(_visible.size());
+	m_stats.culledCount	= 0;
+
+	if(!isEnabled || m_occluders.empty()) { return; }
+
+	TIMER(start);
+
+	const auto it = std::stable_partition(
+		_visible.begin(), _visible.end(),
+		[&](uint32_t _ref) { return !isOccluded(_bvh.getRef(_ref).bounds); }
+	);
+
+	m_stats.culledCount	= static_cast<uint32_t>(std::distance(it, _visible.end()));
+
+	_occluded.insert(_occluded.end(), it, _visible.end());
+	_visible.erase(it, _visible.end());
+
+	TIMER(end);
+
+	m_stats.testTime		= TIME_DIFF(start, end);
+}
@@ -0,0 +1,328 @@
+#include "PvsBaker.h"
+
+void PvsBaker::bake(vk::Model::Data &_data) noexcept
+{
+	using AlphaMode = vk::Material::AlphaMode;
+
+	TIMER(start);
+
+	const auto view				= _data.getView();
+	const auto &opaqueMode	= vk::Material::alphaModes[AlphaMode::OPAQUE_];
+
+	// world space triangles, per (model wide) primitive
+
+	std::vector<Triangle>		triangles;
+	std::vector<uint32_t>		firstTriangles, triangleCounts;
+	std::vector<Bounds>			primBounds;
+	std::vector<uint8_t>			isOccluder;
+
+	auto sceneMin = glm::vec3( std::numeric_limits<float>::max());
+	auto sceneMax = glm::vec3(-std::numeric_limits<float>::max());
+
+	vk::Model::forEachNode(_data.nodes, [&](const NodePtr &_node)
+	{
+		const auto worldMtx = vk::Model::getNodeMatrix(_node);
+
+		for(const auto &primitive : _node->mesh.primitives)
+		{
+			const auto firstIndex	= primitive.indexParams.firstIndex;
+			const auto idxCount		= primitive.idxCount - primitive.idxCount % 3;
+
+			Bounds bounds;
+
+			firstTriangles.push_back(static_cast<uint32_t>(triangles.size()));
+			triangleCounts.push_back(idxCount / 3);
+			isOccluder.push_back(
+				primitive.matIndex < static_cast<int>(_data.materials.size()) &&
+				_data.materials[primitive.matIndex].alphaMode == opaqueMode
+			);
+
+			for(auto i = firstIndex; i < firstIndex + idxCount; i += 3)
+			{
+				glm::vec3 positions[3];
+
+				for(auto c = 0u; c < 3; ++c)
+				{
+					positions[c] = glm::vec3(worldMtx * glm::vec4(view.vertices[view.indices[i + c]].position, 1.0f));
+
+					bounds.min = glm::min(bounds.min, positions[c]);
+					bounds.max = glm::max(bounds.max, positions[c]);
+				}
+
+				triangles.push_back({
+					positions[0], positions[1] - positions[0], positions[2] - positions[0],
+					static_cast<uint32_t>(primBounds.size())
+				});
+			}
+
+			sceneMin = glm::min(sceneMin, bounds.min);
+			sceneMax = glm::max(sceneMax, bounds.max);
+
+			primBounds.push_back(bounds);
+		}
+	});
+
+	const auto primitiveCount = static_cast<uint32_t>(primBounds.size());
+
+	if(triangles.empty()) { return; }
+
+	// cells: (close to) cubic, at most s_maxCellCount
+
+	const auto sceneExtent	= glm::max(sceneMax - sceneMin, glm::vec3(1e-3f));
+	auto cellSize						= std::cbrt(sceneExtent.x * sceneExtent.y * sceneExtent.z / s_maxCellCount);
+	auto cellCounts					= glm::uvec3(1);
+
+	for(;; cellSize *= 1.05f)
+	{
+		cellCounts = glm::uvec3(glm::max(glm::ceil(sceneExtent / cellSize), glm::vec3(1.0f)));
+
+		if(cellCounts.x * cellCounts.y * cellCounts.z <= s_maxCellCount) { break; }
+	}
+
+	auto &pvs		= _data.pvs;
+	auto &grid	= pvs.grid;
+
+	grid.origin					= sceneMin;
+	grid.cellSize				= sceneExtent / glm::vec3(cellCounts);
+	grid.cellCounts			= cellCounts;
+	grid.primitiveCount	= primitiveCount;
+	grid.wordCount			= (primitiveCount + 31) / 32;
+
+	const auto cellCount = cellCounts.x * cellCounts.y * cellCounts.z;
+
+	pvs.bits.assign(cellCount * grid.wordCount, 0u);
+
+	TriangleGrid triGrid;
+	buildGrid(triangles, isOccluder, sceneMin, sceneMax, triGrid);
+
+	vk::runJobs(cellCount, [&](uint32_t _cell)
+	{
+		const auto coords		= glm::uvec3(
+			_cell % cellCounts.x, (_cell / cellCounts.x) % cellCounts.y, _cell / (cellCounts.x * cellCounts.y)
+		);
+		const auto cellMin	= grid.origin + glm::vec3(coords) * grid.cellSize;
+		const auto cellMax	= cellMin + grid.cellSize;
+		auto cellBits				= &pvs.bits[_cell * grid.wordCount];
+
+		std::mt19937													rng(_cell);
+		std::uniform_real_distribution<float>	unit(0.0f, 1.0f);
+
+		// the cell corners, then jittered points inside
+		std::vector<glm::vec3> origins;
+
+		for(auto o = 0u; o < s_originsPerCell; ++o)
+		{
+			const auto weights = o < 8
+				? glm::vec3(o & 1 ? 1.0f : 0.0f, o & 2 ? 1.0f : 0.0f, o & 4 ? 1.0f : 0.0f)
+				: glm::vec3(unit(rng), unit(rng), unit(rng));
+
+			origins.push_back(glm::mix(cellMin, cellMax, weights));
+		}
+
+		for(auto p = 0u; p < primitiveCount; ++p)
+		{
+			const auto triCount = triangleCounts[p];
+			const auto &bounds	= primBounds[p];
+
+			if(triCount == 0) { continue; }
+
+			// camera inside the primitive's bounds: always visible
+			auto isVisible = glm::all(glm::lessThanEqual(bounds.min, cellMax)) && glm::all(glm::lessThanEqual(cellMin, bounds.max));
+
+			for(auto o = 0u; o < origins.size() && !isVisible; ++o)
+			{
+				for(auto r = 0u; r < s_raysPerOrigin && !isVisible; ++r)
+				{
+					const auto &triangle = triangles[firstTriangles[p] + std::min(static_cast<uint32_t>(unit(rng) * triCount), triCount - 1)];
+
+					auto u = unit(rng), v = unit(rng);
+
+					if(u + v > 1.0f) { u = 1.0f - u; v = 1.0f - v; }
+
+					isVisible = !isBlocked(triangles, triGrid, origins[o], triangle.v0 + triangle.e1 * u + triangle.e2 * v, p);
+				}
+			}
+
+			if(isVisible) { cellBits[p / 32] |= 1u << (p % 32); }
+		}
+	});
+
+	TIMER(end);
+
+	size_t visibleCount = 0;
+
+	for(const auto word : pvs.bits) { visibleCount += std::bitset<32>(word).count(); }
+
+	INFO_LOG(
+		"PVS baked: %u cells (%ux%ux%u), %u primitives, %.1f%% potentially visible on average in %.2f ms",
+		cellCount, cellCounts.x, cellCounts.y, cellCounts.z, primitiveCount,
+		100.0f * static_cast<float>(visibleCount) / static_cast<float>(cellCount * primitiveCount),
+		TIME_DIFF(start, end)
+	);
+}
+
+void PvsBaker::buildGrid(
+	const std::vector<Triangle>	&_triangles,
+	const std::vector<uint8_t>	&_isOccluder,
+	const glm::vec3							&_min,
+	const glm::vec3							&_max,
+	TriangleGrid								&_grid
+) noexcept
+{
+	const auto extent		= glm::max(_max - _min, glm::vec3(1e-3f));
+	const auto cellSize	= std::cbrt(extent.x * extent.y * extent.z / std::max<size_t>(_triangles.size() / 2, 1));
+
+	_grid.origin			= _min;
+	_grid.cellCounts	= glm::clamp(glm::ivec3(glm::ceil(extent / cellSize)), glm::ivec3(1), glm::ivec3(s_maxGridRes));
+	_grid.cellSize		= extent / glm::vec3(_grid.cellCounts);
+
+	const auto &counts		= _grid.cellCounts;
+	const auto cellCount	= static_cast<size_t>(counts.x) * counts.y * counts.z;
+
+	const auto getCellRange = [&](const Triangle &_triangle, glm::ivec3 &_from, glm::ivec3 &_to)
+	{
+		const auto v1 = _triangle.v0 + _triangle.e1, v2 = _triangle.v0 + _triangle.e2;
+		const auto triMin = glm::min(glm::min(_triangle.v0, v1), v2);
+		const auto triMax = glm::max(glm::max(_triangle.v0, v1), v2);
+
+		_from	= glm::clamp(glm::ivec3(glm::floor((triMin - _grid.origin) / _grid.cellSize)), glm::ivec3(0), counts - 1);
+		_to		= glm::clamp(glm::ivec3(glm::floor((triMax - _grid.origin) / _grid.cellSize)), glm::ivec3(0), counts - 1);
+	};
+
+	const auto forEachCell = [&](const std::function<void(size_t, uint32_t)> &_callback)
+	{
+		for(auto t = 0u; t < _triangles.size(); ++t)
+		{
+			if(!_isOccluder[_triangles[t].primitive]) { continue; }
+
+			glm::ivec3 from, to;
+			getCellRange(_triangles[t], from, to);
+
+			for(auto z = from.z; z <= to.z; ++z)
+			for(auto y = from.y; y <= to.y; ++y)
+			for(auto x = from.x; x <= to.x; ++x)
+			{
+				_callback((static_cast<size_t>(z) * counts.y + y) * counts.x + x, t);
+			}
+		}
+	};
+
+	// counts, prefix sum, fill (CSR)
+	_grid.cellStarts.assign(cellCount + 1, 0);
+
+	forEachCell([&](size_t _cell, uint32_t) { _grid.cellStarts[_cell + 1]++; });
+
+	std::partial_sum(_grid.cellStarts.begin(), _grid.cellStarts.end(), _grid.cellStarts.begin());
+
+	auto cursors = _grid.cellStarts;
+	_grid.triangles.resize(_grid.cellStarts.back());
+
+	forEachCell([&](size_t _cell, uint32_t _triangle) { _grid.triangles[cursors[_cell]++] = _triangle; });
+}
+
+bool PvsBaker::isBlocked(
+	const std::vector<Triangle>	&_triangles,
+	const TriangleGrid					&_grid,
+	const glm::vec3							&_from,
+	const glm::vec3							&_to,
+	uint32_t										_ignore
+) noexcept
+{
+	static const float s_epsilon = 1e-4f;
+
+	const auto dir			= _to - _from;
+	const auto gridMax	= _grid.origin + _grid.cellSize * glm::vec3(_grid.cellCounts);
+
+	// clip the segment to the grid
+	auto tMin = 0.0f, tMax = 1.0f;
+
+	for(auto a = 0; a < 3; ++a)
+	{
+		if(std::abs(dir[a]) < 1e-12f)
+		{
+			if(_from[a] < _grid.origin[a] || _from[a] > gridMax[a]) { return false; }
+			continue;
+		}
+
+		auto t0 = (_grid.origin[a] - _from[a]) / dir[a];
+		auto t1 = (gridMax[a] - _from[a]) / dir[a];
+
+		if(t0 > t1) { std::swap(t0, t1); }
+
+		tMin = std::max(tMin, t0);
+		tMax = std::min(tMax, t1);
+
+		if(tMin > tMax) { return false; }
+	}
+
+	// 3D DDA (Amanatides & Woo)
+	const auto &counts = _grid.cellCounts;
+	auto cell = glm::clamp(
+		glm::ivec3(glm::floor((_from + dir * tMin - _grid.origin) / _grid.cellSize)), glm::ivec3(0), counts - 1
+	);
+
+	glm::ivec3	step;
+	glm::vec3		tNext, tDelta;
+
+	for(auto a = 0; a < 3; ++a)
+	{
+		step[a] = dir[a] > 0.0f ? 1 : -1;
+
+		if(std::abs(dir[a]) < 1e-12f)
+		{
+			tNext[a]	= std::numeric_limits<float>::max();
+			tDelta[a]	= std::numeric_limits<float>::max();
+			continue;
+		}
+
+		const auto boundary = _grid.origin[a] + static_cast<float>(cell[a] + (step[a] > 0 ? 1 : 0)) * _grid.cellSize[a];
+
+		tNext[a]	= (boundary - _from[a]) / dir[a];
+		tDelta[a]	= _grid.cellSize[a] / std::abs(dir[a]);
+	}
+
+	for(;;)
+	{
+		const auto cellIndex = (static_cast<size_t>(cell.z) * counts.y + cell.y) * counts.x + cell.x;
+
+		for(auto i = _grid.cellStarts[cellIndex]; i < _grid.cellStarts[cellIndex + 1]; ++i)
+		{
+			const auto &triangle = _triangles[_grid.triangles[i]];
+
+			if(triangle.primitive == _ignore) { continue; }
+
+			// Moller & Trumbore (double sided)
+			const auto p		= glm::cross(dir, triangle.e2);
+			const auto det	= glm::dot(triangle.e1, p);
+
+			if(std::abs(det) < 1e-12f) { continue; }
+
+			const auto invDet	= 1.0f / det;
+			const auto s			= _from - triangle.v0;
+			const auto u			= glm::dot(s, p) * invDet;
+
+			if(u < 0.0f || u > 1.0f) { continue; }
+
+			const auto q = glm::cross(s, triangle.e1);
+			const auto v = glm::dot(dir, q) * invDet;
+
+			if(v < 0.0f || u + v > 1.0f) { continue; }
+
+			const auto t = glm::dot(triangle.e2, q) * invDet;
+
+			if(t > s_epsilon && t < 1.0f - s_epsilon) { return true; }
+		}
+
+		const auto axis = tNext.x < tNext.y
+			? (tNext.x < tNext.z ? 0 : 2)
+			: (tNext.y < tNext.z ? 1 : 2);
+
+		if(tNext[axis] > tMax) { return false; }
+
+		cell[axis] += step[axis];
+
+		if(cell[axis] < 0 || cell[axis] >= counts[axis]) { return false; }
+
+		tNext[axis] += tDelta[axis];
+	}
+}
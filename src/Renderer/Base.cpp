@@ -220,21 +220,28 @@ namespace renderer
 		const VkPipeline &_pipeline,
 		const VkPipelineLayout &_pipelineLayout,
 		const VkDescriptorSet *_descSets,
-		uint32_t _descSetCount
+		uint32_t _descSetCount,
+		const std::function<void(const VkCommandBuffer&)> &_drawCallback,
+		const VkRenderPass &_renderPass,
+		const std::vector<VkFramebuffer> *_framebuffers
 	) noexcept
 	{
 		auto &deviceData = m_device->getData();
 		auto &swapchainData = deviceData.swapchainData;
 		auto &swapchainExtent = swapchainData.extent;
-		auto &framebufferData = getFbData(m_screenData);
+		auto framebufferData = getFbData(m_screenData);
+		auto &framebuffers = _framebuffers != nullptr ? *_framebuffers : swapchainData.framebuffers;
 		auto &cmdData = deviceData.cmdData;
 
+		if(_renderPass != VK_NULL_HANDLE) { framebufferData.renderPass = _renderPass; }
+
 		const auto &rpCallback = [&](const VkCommandBuffer &_cmdBuffer)
 		{
 			setupRenderPassCommands(
 				_cmdBuffer,
 				_pipeline, _pipelineLayout,
-				_descSets, _descSetCount
+				_descSets, _descSetCount,
+				_drawCallback
 			);
 		};
 
@@ -251,7 +258,7 @@ namespace renderer
 		auto &cmdBuffers = cmdData.drawCmdBuffers;
 		for (auto i = 0u; i < cmdBuffers.size(); ++i)
 		{
-			framebufferData.framebuffer = swapchainData.framebuffers[i];
+			framebufferData.framebuffer = framebuffers[i];
 
 			vk::Command::record(cmdBuffers[i], recordCallback);
 		}
@@ -262,7 +269,8 @@ namespace renderer
 		const VkPipeline &_pipeline,
 		const VkPipelineLayout &_pipelineLayout,
 		const VkDescriptorSet *_descSets,
-		uint32_t _descSetCount
+		uint32_t _descSetCount,
+		const std::function<void(const VkCommandBuffer&)> &_drawCallback
 	) noexcept
 	{
 		auto &deviceData = m_device->getData();
@@ -282,7 +290,8 @@ namespace renderer
 			nullptr, 0,
 			_pipelineLayout
 		);
-		vk::Command::draw(_cmdBuffer, 3);
+		if(_drawCallback)	{ _drawCallback(_cmdBuffer); }
+		else							{ vk::Command::draw(_cmdBuffer, 3); }
 		// TODO: Draw UI
 	}
 
@@ -354,6 +363,8 @@ namespace renderer
 			swapchainData.framebuffers
 		);
 
+		onSwapchainRecreate();
+
 		vk::Command::destroyCmdBuffers(
 			logicalDevice,
 			cmdData.cmdPool,
@@ -2,11 +2,17 @@
 
 namespace renderer
 {
+	// the compute & tile passes read the g-buffer outside of the render pass
+	static_assert(
+		!DeferredScreenData::isSubpassLayout() ||
+		DeferredScreenData::s_lightingMode == DeferredScreenData::LightingMode::CLUSTERED,
+		"The single render pass layout only supports clustered lighting"
+	);
+
 	Deferred::~Deferred()
 	{
 		const auto &deviceData = m_device->getData();
 		const auto &logicalDevice = deviceData.logicalDevice;
-		const auto &fbData = getFbData(m_deferredScreenData);
 		const auto &descData = m_deferredScreenData.descriptorData;
 
 		vk::Descriptor::destroyPool(logicalDevice, descData.pool);
@@ -17,12 +23,36 @@ namespace renderer
 			&m_deferredScreenData.cmdBuffer
 		);
 
-		vk::Attachment	::destroy(logicalDevice, fbData.attachments);
-		vk::RenderPass	::destroy(logicalDevice, fbData.renderPass);
-		vk::Framebuffer	::destroy(logicalDevice, fbData.framebuffer);
+		destroyScreenTargets();
+
+		vk::Framebuffer	::destroy(logicalDevice, m_deferredScreenData.swapchainFramebuffers);
+		vk::RenderPass	::destroy(logicalDevice, m_deferredScreenData.volumeRenderPass);
 		vk::Pipeline		::destroy(logicalDevice, m_deferredScreenData.pipelineData);
 		vk::Descriptor	::destroySetLayouts(logicalDevice, descData.setLayouts);
 		vk::Buffer			::destroy(logicalDevice, m_deferredScreenData.bufferData);
+		vk::Pipeline		::destroy(logicalDevice, m_deferredScreenData.meshletCullingPipeline);
+		vk::Pipeline		::destroy(logicalDevice, m_deferredScreenData.lightCullingPipeline);
+
+		vk::Device			::unmapMemory(logicalDevice, m_deferredScreenData.lightMemory);
+		vk::Buffer			::destroy(logicalDevice, m_deferredScreenData.lightBuffer);
+		vk::Buffer			::destroy(logicalDevice, m_deferredScreenData.clusterBuffer);
+		vk::Device			::freeMemory(logicalDevice, m_deferredScreenData.lightMemory);
+		vk::Device			::freeMemory(logicalDevice, m_deferredScreenData.clusterMemory);
+		vk::Buffer			::destroy(logicalDevice, m_deferredScreenData.lightVolumeBuffer);
+		vk::Device			::freeMemory(logicalDevice, m_deferredScreenData.lightVolumeMemory);
+		vk::Pipeline		::destroy(logicalDevice, m_deferredScreenData.tileClassificationPipeline);
+		vk::Pipeline		::destroy(logicalDevice, m_deferredScreenData.lightingPipeline);
+		vk::Command			::destroyQueryPool(logicalDevice, m_deferredScreenData.statsQueryPool);
+
+		for(const auto &tilePipeline : m_deferredScreenData.tilePipelines)
+		{
+			vk::Pipeline::destroy(logicalDevice, tilePipeline);
+		}
+
+		for(auto &modelData : m_screenData.modelsData)
+		{
+			vk::Model::destroy(logicalDevice, modelData, m_deferredScreenData.geometryArena);
+		}
 		vk::Sync				::destroySemaphore(logicalDevice, m_deferredScreenData.semaphore);
 	}
 
@@ -31,16 +61,23 @@ namespace renderer
 		Base::init();
 
 		loadAssets();
+		m_screenData.bvh.build(m_screenData.modelsData);
+		setupLights();
+
 		initCmdBuffer();
 		initSyncPrimitive();
+		initStatsQuery();
 
 		setupRenderPass();
+		setupVolumeRenderPass();
+		setupTiles();
 		setupFramebuffer();
 		setupUBOs();
 		setupDescriptors();
 		setupPipelines();
 
 		setupCommands();
+		updateVisibility();
 
 		m_screenData.isInited = true;
 	}
@@ -54,7 +91,10 @@ namespace renderer
 		m_screenData.modelsData.resize(modelCount);
 		m_screenData.texturesData.resize(modelCount);
 
-		loadAsset<Model::ID::SPONZA>(m_deferredScreenData.bufferData);
+		// every model's geometry is a sub-range of the arena's vertex & index buffers
+		vk::GeometryArena::create(m_device, m_deferredScreenData.geometryArena, m_deferredScreenData.bufferData);
+
+		loadAsset<Model::ID::SPONZA>(m_deferredScreenData.bufferData, m_deferredScreenData.geometryArena);
 	}
 
 	void Deferred::initCmdBuffer() noexcept
@@ -82,6 +122,26 @@ namespace renderer
 		);
 	}
 
+	// fragment shader invocations per geometry draws (see DeferredScreenData::StatsQuery), the overdraw once divided by
+	// the pixel count
+	void Deferred::initStatsQuery() noexcept
+	{
+		auto &deviceData = m_device->getData();
+
+		if(!deviceData.enabledFeatures.pipelineStatisticsQuery)
+		{
+			WARN_LOG("Pipeline statistics queries not supported: no overdraw stats");
+			return;
+		}
+
+		vk::Command::createQueryPool(
+			deviceData.logicalDevice,
+			VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT,
+			vk::toInt(DeferredScreenData::StatsQuery::_count_),
+			m_deferredScreenData.statsQueryPool
+		);
+	}
+
 	void Deferred::setupRenderPass() noexcept
 	{
 		using Att				= vk::Attachment;
@@ -96,54 +156,139 @@ namespace renderer
 		auto &formats					= attachmentsData.formats;
 
 		auto &attCount		= DeferredScreenData::s_fbAttCount;
-		auto &spCount 		= vk::RenderPass::s_subpassCount;
-		auto &spDepCount	= vk::RenderPass::s_spDepCount;
+		auto &spCount 		= DeferredScreenData::s_subpassCount;
+		auto &spDepCount	= DeferredScreenData::s_spDepCount;
 
 		auto tempRPData			= DeferredScreenData::RenderPassData::create();
 		auto &attSpMaps			= tempRPData.attSpMaps;
 		auto &dependencies	= tempRPData.deps;
 		auto &subpasses			= tempRPData.subpasses;
 
-		const auto DEPTH		= attCount - 1; // 3
+		const auto DEPTH		= DeferredScreenData::s_gBufferColorCount; // 3 (2: compact g-buffer)
+		const auto SWAPCHAIN	= attCount - 1; // subpasses only: lighting output
+
+		const auto NORMAL		= DeferredScreenData::getGBufferIndex(AttColor::NORMAL);
+		const auto ALBEDO		= DeferredScreenData::getGBufferIndex(AttColor::ALBEDO);
 
 		attachmentsData.extent = swapchainData.extent;
 
-		formats[AttColor::POSITION]	= VK_FORMAT_R16G16B16A16_SFLOAT;
-		formats[AttColor::NORMAL]		= VK_FORMAT_R16G16B16A16_SFLOAT;
-		formats[AttColor::ALBEDO]		= VK_FORMAT_R8G8B8A8_UNORM;
-		formats[DEPTH]							= deviceData.depthFormat;
+		if(DeferredScreenData::isCompactGBuffer())
+		{
+			formats[NORMAL]	= VK_FORMAT_A2B10G10R10_UNORM_PACK32;	// octahedral normal, roughness, metalness
+		}
+		else
+		{
+			formats[AttColor::POSITION]	= VK_FORMAT_R16G16B16A16_SFLOAT;
+			formats[NORMAL]							= VK_FORMAT_R16G16B16A16_SFLOAT;
+		}
+		formats[ALBEDO]	= VK_FORMAT_R8G8B8A8_UNORM;
+		formats[DEPTH]	= deviceData.depthFormat;
 
-		const Att::AttSubpassMap &colorAttSpMap		= { AttType::COLOR,	{ 0 } };
+		const auto isSubpass = DeferredScreenData::isSubpassLayout();
 
-		attSpMaps[AttColor::POSITION]	= colorAttSpMap;
-		attSpMaps[AttColor::NORMAL]		= colorAttSpMap;
-		attSpMaps[AttColor::ALBEDO]		= colorAttSpMap;
-		attSpMaps[DEPTH]							= { AttType::DEPTH,	{ 0 } };
+		// subpasses: the g-buffer is written by subpass 0, then read as input attachments by the lighting subpass 1
+		const Att::AttSubpassMap &colorAttSpMap		= isSubpass
+			? Att::AttSubpassMap{ AttType::COLOR,	{ 0 }, { 1 } }
+			: Att::AttSubpassMap{ AttType::COLOR,	{ 0 } };
 
-		// TODO
-		dependencies[0].srcSubpass			= VK_SUBPASS_EXTERNAL;
-		dependencies[0].dstSubpass			= 0;
-		dependencies[0].srcStageMask		= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-		dependencies[0].dstStageMask		= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		dependencies[0].srcAccessMask		= VK_ACCESS_MEMORY_READ_BIT;
-		dependencies[0].dstAccessMask		= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-		dependencies[0].dependencyFlags	= VK_DEPENDENCY_BY_REGION_BIT;
-
-		dependencies[1].srcSubpass			= 0;
-		dependencies[1].dstSubpass			= VK_SUBPASS_EXTERNAL;
-		dependencies[1].srcStageMask		= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		dependencies[1].dstStageMask		= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-		dependencies[1].srcAccessMask		= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-		dependencies[1].dstAccessMask		= VK_ACCESS_MEMORY_READ_BIT;
-		dependencies[1].dependencyFlags	= VK_DEPENDENCY_BY_REGION_BIT;
+		for(auto i = 0u; i < DeferredScreenData::s_gBufferColorCount; ++i)
+		{
+			attSpMaps[i] = colorAttSpMap;
+		}
+		attSpMaps[DEPTH] = isSubpass && DeferredScreenData::isCompactGBuffer()
+			? Att::AttSubpassMap{ AttType::DEPTH,	{ 0 }, { 1 } }
+			: Att::AttSubpassMap{ AttType::DEPTH,	{ 0 } };
+
+		if(isSubpass)
+		{
+			formats[SWAPCHAIN]		= swapchainData.format;
+			attSpMaps[SWAPCHAIN]	= { AttType::FRAMEBUFFER,	{ 1 } };
+		}
 
+		// separate passes: the g-buffer images are the frame graph's (see setupFrameGraph), descriptions only
 		vk::Framebuffer::createAttachments<attCount>(
 			deviceData.logicalDevice,
 			deviceData.memProps,
 			attSpMaps,
-			attachmentsData
+			attachmentsData,
+			false, isSubpass
 		);
 
+		// subpasses: the depth doesn't outlive the render pass
+		if(isSubpass)
+		{
+			attachmentsData.descs[DEPTH].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		}
+
+		// the lighting reconstructs positions from the depth (sampled or read as input through a depth only view)
+		if(DeferredScreenData::isCompactGBuffer())
+		{
+			attachmentsData.descs[DEPTH].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+		}
+
+		// subpasses: depth only view of the input attachment (separate passes: of the graph's image, see setupFrameGraph)
+		if(isSubpass && DeferredScreenData::isCompactGBuffer())
+		{
+			vk::Image::createImageView(
+				deviceData.logicalDevice,
+				attachmentsData.images[DEPTH], formats[DEPTH],
+				m_deferredScreenData.depthView,
+				1, 1, 0,
+				VK_IMAGE_ASPECT_DEPTH_BIT
+			);
+		}
+
+		if(isSubpass)
+		{
+			const auto ATTACHMENT_STAGES	= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+																			VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+			const auto ATTACHMENT_WRITES	= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+			// g-buffer: after the previous frame's writes & input attachment reads (transient, cleared)
+			dependencies[0].srcSubpass			= VK_SUBPASS_EXTERNAL;
+			dependencies[0].dstSubpass			= 0;
+			dependencies[0].srcStageMask		= ATTACHMENT_STAGES | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			dependencies[0].dstStageMask		= ATTACHMENT_STAGES;
+			dependencies[0].srcAccessMask		= ATTACHMENT_WRITES;
+			dependencies[0].dstAccessMask		= ATTACHMENT_WRITES | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+																				VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+
+			// swapchain image: its layout transition after the acquire semaphore's wait (color attachment output)
+			dependencies[1].srcSubpass			= VK_SUBPASS_EXTERNAL;
+			dependencies[1].dstSubpass			= 1;
+			dependencies[1].srcStageMask		= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			dependencies[1].dstStageMask		= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			dependencies[1].dstAccessMask		= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+			// g-buffer writes visible to the lighting subpass' input attachment reads (same pixel only)
+			dependencies[2].srcSubpass			= 0;
+			dependencies[2].dstSubpass			= 1;
+			dependencies[2].srcStageMask		= ATTACHMENT_STAGES;
+			dependencies[2].dstStageMask		= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			dependencies[2].srcAccessMask		= ATTACHMENT_WRITES;
+			dependencies[2].dstAccessMask		= VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
+			dependencies[2].dependencyFlags	= VK_DEPENDENCY_BY_REGION_BIT;
+
+			// swapchain image: presented (the render finished semaphore orders it)
+			dependencies[3].srcSubpass			= 1;
+			dependencies[3].dstSubpass			= VK_SUBPASS_EXTERNAL;
+			dependencies[3].srcStageMask		= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			dependencies[3].dstStageMask		= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+			dependencies[3].srcAccessMask		= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		}
+		else
+		{
+			// the g-buffer pass' attachment uses & those of the passes around it (images owned by the graph)
+			setupFrameGraph();
+
+			vk::FrameGraph::getDependencies(
+				m_deferredScreenData.frameGraph,
+				m_deferredScreenData.gBufferPass,
+				dependencies[0],
+				dependencies[1]
+			);
+		}
+
 		vk::RenderPass::createSubpasses<attCount, spCount>(
 			attSpMaps,
 			subpasses
@@ -158,6 +303,73 @@ namespace renderer
 		);
 	}
 
+	// light volumes composition: Base's attachments (swapchain image, clear values), its depth replaced by the g-buffer's,
+	// loaded read only (left so by the frame graph) for the volumes' depth test; formats only: kept across resizes
+	void Deferred::setupVolumeRenderPass() noexcept
+	{
+		using AttType	= vk::Attachment::Type;
+
+		if(DeferredScreenData::s_lightingMode != DeferredScreenData::LightingMode::LIGHT_VOLUMES) { return; }
+
+		const auto &deviceData = m_device->getData();
+
+		auto &attCount		= vk::Attachment::s_attCount;
+		auto &spCount			= vk::RenderPass::s_subpassCount;
+		auto &spDepCount	= vk::RenderPass::s_spDepCount;
+
+		auto tempRPData			= ScreenData::RenderPassData::create();
+		auto &attSpMaps			= tempRPData.attSpMaps;
+		auto &dependencies	= tempRPData.deps;
+		auto &subpasses			= tempRPData.subpasses;
+
+		// Base's descriptions (same formats), the images are the swapchain's & the g-buffer's (see setupSwapchainFramebuffers)
+		auto descs			= getFbData(m_screenData).attachments.descs;
+		auto &depthDesc	= descs[AttType::DEPTH];
+
+		attSpMaps[AttType::FRAMEBUFFER]	= { AttType::FRAMEBUFFER,	{ 0 } };
+		attSpMaps[AttType::DEPTH]				= { AttType::DEPTH,				{ 0 } };
+
+		// left read only by the frame graph (DEPTH_TEST output, see setupFrameGraph)
+		depthDesc.loadOp					= VK_ATTACHMENT_LOAD_OP_LOAD;
+		depthDesc.storeOp					= VK_ATTACHMENT_STORE_OP_STORE;
+		depthDesc.stencilLoadOp		= VK_ATTACHMENT_LOAD_OP_LOAD;
+		depthDesc.stencilStoreOp	= VK_ATTACHMENT_STORE_OP_STORE;
+		depthDesc.initialLayout		= VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+		depthDesc.finalLayout			= VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+		// g-buffer depth writes (offscreen submission) before the volumes' depth tests
+		dependencies[0].srcSubpass			= VK_SUBPASS_EXTERNAL;
+		dependencies[0].dstSubpass			= 0;
+		dependencies[0].srcStageMask		= VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		dependencies[0].dstStageMask		= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		dependencies[0].srcAccessMask		= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		dependencies[0].dstAccessMask		= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+		dependencies[0].dependencyFlags	= 0;
+
+		dependencies[1].srcSubpass			= VK_SUBPASS_EXTERNAL;
+		dependencies[1].dstSubpass			= 0;
+		dependencies[1].srcStageMask		= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependencies[1].dstStageMask		= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependencies[1].srcAccessMask		= 0;
+		dependencies[1].dstAccessMask		= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+		dependencies[1].dependencyFlags	= 0;
+
+		vk::RenderPass::createSubpasses<attCount, spCount>(
+			attSpMaps,
+			subpasses
+		);
+
+		subpasses[0].depthRefs[0].layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+		vk::RenderPass::create<attCount, spCount, spDepCount>(
+			deviceData.logicalDevice,
+			descs,
+			subpasses,
+			dependencies,
+			m_deferredScreenData.volumeRenderPass
+		);
+	}
+
 	void Deferred::setupFramebuffer() noexcept
 	{
 		auto &deviceData = m_device->getData();
@@ -165,10 +377,18 @@ namespace renderer
 		auto &attachmentsData = framebufferData.attachments;
 		auto samplerInfo = vk::Image::Data::SamplerInfo::create();
 
+		attachmentsData.samplers.resize(1);
+		vk::Image::createSampler(deviceData.logicalDevice, samplerInfo, attachmentsData.samplers[0]);
+
+		// subpasses: one framebuffer per swapchain image (see setupSwapchainFramebuffers)
+		if(DeferredScreenData::isSubpassLayout()) { return; }
+
+		auto imageViews = getGBufferViews();
+
 		auto fbInfo = vk::Framebuffer::setFramebufferInfo(
 			framebufferData.renderPass,
 			attachmentsData.extent,
-			attachmentsData.imageViews
+			imageViews
 		);
 
 		vk::Framebuffer::create(
@@ -176,311 +396,1074 @@ namespace renderer
 			fbInfo,
 			framebufferData.framebuffer
 		);
-
-		attachmentsData.samplers.resize(1);
-		vk::Image::createSampler(deviceData.logicalDevice, samplerInfo, attachmentsData.samplers[0]);
 	}
 
-	void Deferred::setupUBOs() noexcept
+	// frame graph's images (separate passes) or the attachments' (subpasses, swapchain image slot left empty)
+	vk::Array<VkImageView, DeferredScreenData::s_fbAttCount> Deferred::getGBufferViews() const noexcept
 	{
-		using BufferCategory	= vk::Buffer::Category;
-		using BufferType			= vk::Buffer::Type;
+		auto imageViews = m_deferredScreenData.framebufferData.attachments.imageViews;
 
-		const auto &deviceData = m_device->getData();
-		auto &bufferData = m_deferredScreenData.bufferData;
-		auto tempData = vk::Buffer::TempData<BufferType::UNIFORM, vk::Buffer::s_ubcCount>::create();
-		auto &sizes = tempData.sizes;
+		if(DeferredScreenData::isSubpassLayout()) { return imageViews; }
 
-		// TODO: Parameterize this data through the UI
+		for(auto i = 0u; i < imageViews.size(); ++i)
+		{
+			imageViews[i] = vk::FrameGraph::getImageView(m_deferredScreenData.frameGraph, m_deferredScreenData.gBufferResources[i]);
+		}
 
-		DeferredScreenData::CompositionUBO compositionUBO = {};
-		DeferredScreenData::OffScreenUBO offscreenUBO = {};
+		return imageViews;
+	}
 
-		setCompositionUBOData(compositionUBO);
-		setOffscreenUBOData(offscreenUBO);
+	// subpasses: g-buffer attachments + the swapchain image (last), light volumes: the swapchain image + the g-buffer
+	// depth (volumeRenderPass), (re)created with the swapchain
+	void Deferred::setupSwapchainFramebuffers() noexcept
+	{
+		using AttType = vk::Attachment::Type;
 
-		sizes	[BufferCategory::COMPOSITION]	= sizeof(compositionUBO);
-		sizes	[BufferCategory::OFFSCREEN]		= sizeof(offscreenUBO);
+		const auto &deviceData		= m_device->getData();
+		const auto &swapchainData	= deviceData.swapchainData;
+		const auto &framebufferData	= getFbData(m_deferredScreenData);
+		const auto &attachmentsData	= framebufferData.attachments;
 
-		vk::Buffer::create(
-			deviceData.logicalDevice, deviceData.memProps,
-			tempData,
-			bufferData
-		);
+		auto &framebuffers	= m_deferredScreenData.swapchainFramebuffers;
+		auto imageViews			= attachmentsData.imageViews;
 
-		updateOffscreenUBO();
-		updateCompositionUBO();
-	}
+		vk::Framebuffer::destroy(deviceData.logicalDevice, framebuffers);
 
-	void Deferred::setOffscreenUBOData(DeferredScreenData::OffScreenUBO &_data) noexcept
-	{
-		const auto &cameraData = m_screenData.camera.getData();
-		const auto &matrices = cameraData.matrices;
+		if(!DeferredScreenData::isSubpassLayout())
+		{
+			vk::Array<VkImageView, vk::Attachment::s_attCount> volumeViews = {};
+			volumeViews[AttType::DEPTH] = getGBufferViews()[DeferredScreenData::s_gBufferColorCount];
 
-		_data = {
-			matrices.perspective,
-			matrices.view
-		};
-	}
+			auto volumeFbInfo = vk::Framebuffer::setFramebufferInfo(
+				m_deferredScreenData.volumeRenderPass,
+				attachmentsData.extent,
+				volumeViews
+			);
 
-	void Deferred::setCompositionUBOData(DeferredScreenData::CompositionUBO &_data) noexcept
-	{
-		// TODO: Fix light values
-		const auto &cameraData = m_screenData.camera.getData();
-		_data = {
+			framebuffers.resize(swapchainData.size);
+			for(auto i = 0u; i < framebuffers.size(); ++i)
 			{
-				{
-					glm::vec4(0.0f, 2.5f, 0.0f, 1.0f),
-					glm::vec3(1.0f, 0.7f, 0.3f),
-					25.0f
-				}
-			},
-			// Current View Position
-			glm::vec4(cameraData.pos, 1.0f)// * glm::vec4(-1.0f, 1.0f, -1.0f, 1.0f)
-		};
+				volumeViews[AttType::FRAMEBUFFER] = swapchainData.imageViews[i];
 
-	}
-
-	void Deferred::updateOffscreenUBO() noexcept
-	{
-		using BufferCategory	= vk::Buffer::Category;
+				vk::Framebuffer::create(
+					deviceData.logicalDevice,
+					volumeFbInfo,
+					framebuffers[i]
+				);
+			}
+			return;
+		}
 
-		auto &ubos = m_deferredScreenData.bufferData.entries;
+		auto fbInfo = vk::Framebuffer::setFramebufferInfo(
+			framebufferData.renderPass,
+			attachmentsData.extent,
+			imageViews
+		);
 
-		DeferredScreenData::OffScreenUBO offscreenUBO = {};
-		setOffscreenUBOData(offscreenUBO);
+		framebuffers.resize(swapchainData.size);
+		for(auto i = 0u; i < framebuffers.size(); ++i)
+		{
+			imageViews[DeferredScreenData::s_fbAttCount - 1] = swapchainData.imageViews[i];
 
-		memcpy(ubos[BufferCategory::OFFSCREEN], &offscreenUBO, sizeof(offscreenUBO));
+			vk::Framebuffer::create(
+				deviceData.logicalDevice,
+				fbInfo,
+				framebuffers[i]
+			);
+		}
 	}
 
-	void Deferred::updateCompositionUBO() noexcept
+	// per bucket indirect draw commands (reset each frame), then one tile list per bucket
+	void Deferred::setupTiles() noexcept
 	{
-		using BufferCategory	= vk::Buffer::Category;
-
-		auto &ubos = m_deferredScreenData.bufferData.entries;
-
-		DeferredScreenData::CompositionUBO compositionUBO = {};
-		setCompositionUBOData(compositionUBO);
+		const auto &deviceData		= m_device->getData();
+		const auto &logicalDevice	= deviceData.logicalDevice;
+		const auto &extent				= m_deferredScreenData.framebufferData.attachments.extent;
+		const auto &tileSize			= DeferredScreenData::s_tileSize;
+		const auto &bucketCount		= DeferredScreenData::s_tileBucketCount;
 
-		memcpy(ubos[BufferCategory::COMPOSITION], &compositionUBO, sizeof(compositionUBO));
-	}
+		auto &tileCount = m_deferredScreenData.tileCount;
 
-	void Deferred::setupDescPool(
-		uint32_t _materialCount,
-		uint32_t _maxSetCount
-	) noexcept
-	{
-		using DescType				= vk::descriptor::Type;
-		using Desc						= vk::Descriptor;
-		using TextureMap			= vk::Texture::Sampler;
+		tileCount = ((extent.width + tileSize - 1) / tileSize) * ((extent.height + tileSize - 1) / tileSize);
 
-		auto &logicalDevice		= m_device->getData().logicalDevice;
-		auto &descriptorData	= m_deferredScreenData.descriptorData;
-		auto texMapCount = vk::toInt(TextureMap::_count_);
+		const auto &usageFlags	= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+															VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		const auto size					= bucketCount * sizeof(VkDrawIndirectCommand) + bucketCount * tileCount * sizeof(uint32_t);
 
-		const auto &poolSizes = {
-			Desc::createPoolSize(DescType::UNIFORM_BUFFER, 2),
-			Desc::createPoolSize(DescType::COMBINED_IMAGE_SAMPLER, _materialCount * texMapCount) // @todo: texture maps per material
-		};
+		VkDeviceSize alignment;
 
-		Desc::createPool(
-			logicalDevice,
-			poolSizes,
-			_maxSetCount,
-			descriptorData.pool
+		vk::Buffer::create(logicalDevice, size, usageFlags, m_deferredScreenData.tileBuffer);
+		vk::Buffer::createMemory(
+			logicalDevice, usageFlags,
+			deviceData.memProps, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_deferredScreenData.tileBuffer, alignment, m_deferredScreenData.tileMemory
 		);
 	}
 
-	void Deferred::setupDescriptors() noexcept
+	// offscreen passes & the images they share: meshlet & light culling, g-buffer (attachments), then the tile
+	// classification or the compute lighting (lit image); the composition pass reads the outputs. All the images are
+	// owned by the graph: those not read past a pass share their memory with the ones created after it (e.g. the full
+	// layout depth, only tested by the g-buffer pass, with the lit image)
+	void Deferred::setupFrameGraph() noexcept
 	{
-		using DescType				= vk::descriptor::Type;
-		using BufferCategory	= vk::Buffer::Category;
-		using TextureParam		= vk::Material::TexParam;
-		using Att							= vk::Attachment;
-		using Desc						= vk::Descriptor;
-
-		using AttTag					= Att::Tag;
-		using AttColor				= AttTag::Color;
+		using Graph					= vk::FrameGraph;
+		using Access				= Graph::Access;
+		using LightingMode	= DeferredScreenData::LightingMode;
 
-		auto &logicalDevice			= m_device->getData().logicalDevice;
-		auto &attachmentData		= m_deferredScreenData.framebufferData.attachments;
-		auto &descriptorData		= m_deferredScreenData.descriptorData;
-		auto &setLayouts				= descriptorData.setLayouts;
-		auto &bufferData				= m_deferredScreenData.bufferData;
-		auto &modelsData				= m_screenData.modelsData;
-		auto &bufferInfos				= bufferData.descriptors;
-		auto &descSets					= descriptorData.sets;
+		// single render pass: no offscreen passes
+		if(DeferredScreenData::isSubpassLayout()) { return; }
 
-		auto tempData = DeferredScreenData::DescriptorData::Temp::create();
-		auto &descriptors					= tempData.descriptors;
+		const auto &deviceData			= m_device->getData();
+		const auto &attachmentsData	= m_deferredScreenData.framebufferData.attachments;
+		const auto &lightingMode		= DeferredScreenData::s_lightingMode;
+		const auto DEPTH						= DeferredScreenData::s_gBufferColorCount;
 
-		for(const auto &model : modelsData)
-		{ tempData.maxSetCount += model.textureCount; tempData.materialCount += model.materials.size(); }
+		auto &graph							= m_deferredScreenData.frameGraph;
+		auto &gBufferResources	= m_deferredScreenData.gBufferResources;
 
-		tempData.maxSetCount += 1;
+		// g-buffer: SHADER_READ_ONLY after its render pass, depth read only (compact g-buffer)
+		std::vector<Graph::Use> gBufferWrites, gBufferReads;
 
-		setupDescPool(tempData.materialCount, tempData.maxSetCount);
+		for(auto i = 0u; i < DeferredScreenData::s_gBufferColorCount; ++i)
+		{
+			const auto resource = Graph::createImage(graph, "g-buffer color", attachmentsData.formats[i], attachmentsData.extent);
 
-		const auto &dsLayoutBindings = GET_DESC_SET_LAYOUT_BINDINGS(DEFERRED_SHADING)
+			gBufferResources[i] = resource;
 
-		const uint16_t GEOM_VS_UBO			= 0;
-		uint16_t COLOR;
-		const uint16_t POSITION = COLOR	= 1;
-		const uint16_t NORMAL						= 2;
-		const uint16_t ALBEDO						= 3;
-		const uint16_t LIGHT_FS_UBO			= 4;
+			gBufferWrites	.push_back({ resource, Access::COLOR_ATTACHMENT, attachmentsData.descs[i].finalLayout });
+			gBufferReads	.push_back({ resource, Access::SAMPLED });
+		}
 
-		Desc::createSetLayout(
-			logicalDevice,
-			dsLayoutBindings,
-			setLayouts[Desc::LayoutCategory::DEFERRED_SHADING]
+		const auto depth = Graph::createImage(
+			graph, "g-buffer depth",
+			attachmentsData.formats[DEPTH], attachmentsData.extent, 0,
+			attachmentsData.formats[DEPTH] >= vk::FormatType::D16_UNORM_S8_UINT
+			? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT
+			: VK_IMAGE_ASPECT_DEPTH_BIT
 		);
 
-		descSets.resize(tempData.materialCount + 1); // @todo: 1 set for COMPOSITION buffers + 1 per model images/textures
+		gBufferResources[DEPTH] = depth;
 
-		auto setIndex = 0;
+		gBufferWrites.push_back({ depth, Access::DEPTH_ATTACHMENT, attachmentsData.descs[DEPTH].finalLayout });
 
-		// COMPOSITION Set (Deferred)
+		if(DeferredScreenData::isCompactGBuffer()) { gBufferReads.push_back({ depth, Access::DEPTH_SAMPLED }); }
+
+		// models' indirect draw commands (buffers, own barrier)
 		{
-			auto &set = descSets[setIndex];
+			auto pass = Graph::Pass();
+			pass.name						= "meshlet culling";
+			pass.shaderStages		= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			pass.record					= [this](const VkCommandBuffer &_cmdBuffer) { recordMeshletCulling(_cmdBuffer); };
+			pass.hasSideEffects	= true;
 
-			Desc::allocSets(
-				logicalDevice,
-				descriptorData.pool,
-				&setLayouts[Desc::LayoutCategory::DEFERRED_SHADING],
-				&set
-			);
+			Graph::addPass(graph, pass);
+		}
 
-			auto attTempData = Att::Data<DeferredScreenData::s_fbAttCount>::Temp::create();
-			auto colorAttCount = vk::toInt(AttTag::Color::_count_);
-			auto &imageInfos = attTempData.imageDescs;
+		// cluster light lists (buffer, own barrier)
+		if(DeferredScreenData::isClusteredLighting())
+		{
+			auto pass = Graph::Pass();
+			pass.name						= "light culling";
+			pass.shaderStages		= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			pass.record					= [this](const VkCommandBuffer &_cmdBuffer) { recordLightCulling(_cmdBuffer); };
+			pass.hasSideEffects	= true;
 
-			for(auto i = 0u; i < colorAttCount; ++i)
-			{
-				auto &imageDescriptor = imageInfos[i];
+			Graph::addPass(graph, pass);
+		}
 
-				imageDescriptor.sampler			= attachmentData.samplers[0];
-				imageDescriptor.imageView		= attachmentData.imageViews[i];
-				imageDescriptor.imageLayout	= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			}
+		{
+			auto pass = Graph::Pass();
+			pass.name		= "g-buffer";
+			pass.writes	= gBufferWrites;
+			pass.record	= [this](const VkCommandBuffer &_cmdBuffer)
+			{
+				resetStatsQuery(_cmdBuffer);
 
-			descriptors = {
-				Desc::createDescriptor(set, dsLayoutBindings[POSITION],			&imageInfos	[AttColor::POSITION]),
-				Desc::createDescriptor(set, dsLayoutBindings[NORMAL],				&imageInfos	[AttColor::NORMAL]),
-				Desc::createDescriptor(set, dsLayoutBindings[ALBEDO],				&imageInfos	[AttColor::ALBEDO]),
-				Desc::createDescriptor(set, dsLayoutBindings[LIGHT_FS_UBO],	&bufferInfos[BufferCategory::COMPOSITION])
+				vk::Command::recordRenderPassCommands(
+					_cmdBuffer,
+					m_device->getData().swapchainData.extent,
+					m_deferredScreenData.framebufferData,
+					[this](const VkCommandBuffer &_rpCmdBuffer) { setupRenderPassCommands(_rpCmdBuffer); }
+				);
 			};
 
-			Desc::updateSets(logicalDevice, descriptors);
-
-			setIndex += 1;
+			m_deferredScreenData.gBufferPass = Graph::addPass(graph, pass);
 		}
 
-		// Camera Matrices + Models Materials Sets (Offscreen)
+		// tile lists & draws (buffer, own barriers)
+		if(lightingMode == LightingMode::TILE_CLASSIFIED)
 		{
-			for(auto i = 0u; i < vk::Model::s_modelCount; ++i)
-			{
-				const auto &materials = modelsData[i].materials;
+			auto pass = Graph::Pass();
+			pass.name						= "tile classification";
+			pass.shaderStages		= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			pass.reads					= gBufferReads;
+			pass.record					= [this](const VkCommandBuffer &_cmdBuffer) { recordTileClassification(_cmdBuffer); };
+			pass.hasSideEffects	= true;
+
+			Graph::addPass(graph, pass);
+		}
 
-				for(const auto &material : materials)
-				{
-					auto &set = descSets[setIndex];
+		if(lightingMode == LightingMode::COMPUTE)
+		{
+			auto &litResource = m_deferredScreenData.litResource;
 
-					Desc::allocSets(
-						logicalDevice,
-						descriptorData.pool,
-						&setLayouts[Desc::LayoutCategory::DEFERRED_SHADING],
-						&set
-					);
+			litResource = Graph::createImage(
+				graph, "lit image",
+				DeferredScreenData::s_litFormat,
+				attachmentsData.extent
+			);
 
-					const auto &imageInfos = material.descriptors;
+			auto pass = Graph::Pass();
+			pass.name					= "compute lighting";
+			pass.shaderStages	= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			pass.reads				= gBufferReads;
+			pass.writes				= { { litResource, Access::STORAGE_WRITE } };
+			pass.record				= [this](const VkCommandBuffer &_cmdBuffer) { recordComputeLighting(_cmdBuffer); };
 
-					descriptors = {
+			Graph::addPass(graph, pass);
+			Graph::addOutput(graph, litResource, Access::SAMPLED, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+		}
+		else
+		{
+			for(const auto &use : gBufferReads)
+			{
+				Graph::addOutput(graph, use.resource, use.access, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+			}
+		}
+
+		// light volumes: tested against the g-buffer depth (volumeRenderPass)
+		if(lightingMode == LightingMode::LIGHT_VOLUMES)
+		{
+			Graph::addOutput(
+				graph, depth, Access::DEPTH_TEST,
+				VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
+			);
+		}
+
+		Graph::compile(deviceData.logicalDevice, deviceData.memProps, graph);
+
+		// framebuffer: the graph's views (all aspects), sampled: depth only
+		if(DeferredScreenData::isCompactGBuffer())
+		{
+			vk::Image::createImageView(
+				deviceData.logicalDevice,
+				Graph::getImage(graph, depth), attachmentsData.formats[DEPTH],
+				m_deferredScreenData.depthView,
+				1, 1, 0,
+				VK_IMAGE_ASPECT_DEPTH_BIT
+			);
+		}
+	}
+
+	void Deferred::setupUBOs() noexcept
+	{
+		using BufferCategory	= vk::Buffer::Category;
+		using BufferType			= vk::Buffer::Type;
+
+		const auto &deviceData = m_device->getData();
+		auto &bufferData = m_deferredScreenData.bufferData;
+		auto tempData = vk::Buffer::TempData<BufferType::UNIFORM, vk::Buffer::s_ubcCount>::create();
+		auto &sizes = tempData.sizes;
+
+		// TODO: Parameterize this data through the UI
+
+		DeferredScreenData::CompositionUBO compositionUBO = {};
+		DeferredScreenData::OffScreenUBO offscreenUBO = {};
+
+		setCompositionUBOData(compositionUBO);
+		setOffscreenUBOData(offscreenUBO);
+
+		sizes	[BufferCategory::COMPOSITION]	= sizeof(compositionUBO);
+		sizes	[BufferCategory::OFFSCREEN]		= sizeof(offscreenUBO);
+
+		vk::Buffer::create(
+			deviceData.logicalDevice, deviceData.memProps,
+			tempData,
+			bufferData
+		);
+
+		updateOffscreenUBO();
+		updateCompositionUBO();
+	}
+
+	// lights in an SSBO (LIGHT_SSBO), binned per cluster each frame by the light culling pass (CLUSTER_SSBO)
+	void Deferred::setupLights() noexcept
+	{
+		using Light = DeferredScreenData::Light;
+
+		const auto &deviceData		= m_device->getData();
+		const auto &logicalDevice	= deviceData.logicalDevice;
+		const auto &bvh						= m_screenData.bvh;
+
+		auto &lightBuffer		= m_deferredScreenData.lightBuffer;
+		auto &lightMemory		= m_deferredScreenData.lightMemory;
+		auto &clusterBuffer	= m_deferredScreenData.clusterBuffer;
+		auto &clusterMemory	= m_deferredScreenData.clusterMemory;
+
+		const auto &usageFlags		= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+		const auto &hostMemFlags	= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+		const auto lightsSize		= DeferredScreenData::s_lightCount * sizeof(Light);
+		const auto clustersSize	= DeferredScreenData::s_clusterCount * (1 + DeferredScreenData::s_maxLightsPerCluster) * sizeof(uint32_t);
+
+		VkDeviceSize alignment;
+		void *lights = nullptr;
+
+		vk::Buffer::create(logicalDevice, lightsSize, usageFlags, lightBuffer);
+		vk::Buffer::createMemory(
+			logicalDevice, usageFlags,
+			deviceData.memProps, hostMemFlags,
+			lightBuffer, alignment, lightMemory
+		);
+		vk::Device::mapMemory(logicalDevice, lightMemory, &lights);
+
+		vk::Buffer::create(logicalDevice, clustersSize, usageFlags, clusterBuffer);
+		vk::Buffer::createMemory(
+			logicalDevice, usageFlags,
+			deviceData.memProps, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			clusterBuffer, alignment, clusterMemory
+		);
+
+		m_deferredScreenData.lights = static_cast<Light*>(lights);
+
+		// scene bounds
+		auto boundsMin = glm::vec3( std::numeric_limits<float>::max());
+		auto boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+
+		for(auto r = 0u; r < bvh.getRefCount(); ++r)
+		{
+			boundsMin = glm::min(boundsMin, bvh.getRef(r).bounds.min);
+			boundsMax = glm::max(boundsMax, bvh.getRef(r).bounds.max);
+		}
+
+		if(bvh.getRefCount() == 0) { boundsMin = glm::vec3(-10.0f); boundsMax = glm::vec3(10.0f); }
+
+		auto *lightData	= m_deferredScreenData.lights;
+		auto rng				= std::mt19937(DeferredScreenData::s_lightSeed);
+		auto unit				= std::uniform_real_distribution<float>(0.0f, 1.0f);
+
+		lightData[0] = { glm::vec4(0.0f, 2.5f, 0.0f, 25.0f), glm::vec4(1.0f, 0.7f, 0.3f, 25.0f) };
+
+		for(auto l = 1u; l < DeferredScreenData::s_lightCount; ++l)
+		{
+			const auto position	= glm::mix(boundsMin, boundsMax, glm::vec3(unit(rng), unit(rng), unit(rng)));
+			const auto color		= glm::vec3(unit(rng), unit(rng), unit(rng));
+			const auto radius		= glm::mix(1.0f, 4.0f, unit(rng));
+
+			lightData[l] = { glm::vec4(position, radius), glm::vec4(glm::normalize(color + 0.1f), radius) };
+		}
+
+		if(DeferredScreenData::s_lightingMode == DeferredScreenData::LightingMode::LIGHT_VOLUMES)
+		{
+			setupLightVolumes();
+			return;
+		}
+
+		INFO_LOG(
+			"Clustered lighting: %u lights, %ux%ux%u clusters",
+			DeferredScreenData::s_lightCount,
+			DeferredScreenData::s_clusterGridSize.x, DeferredScreenData::s_clusterGridSize.y, DeferredScreenData::s_clusterGridSize.z
+		);
+	}
+
+	// subdivided octahedron, scaled so its faces enclose the unit sphere (scaled per light by its radius)
+	void Deferred::setupLightVolumes() noexcept
+	{
+		const auto &deviceData		= m_device->getData();
+		const auto &logicalDevice	= deviceData.logicalDevice;
+		const auto &n							= DeferredScreenData::s_lightVolumeSubdivisions;
+
+		const glm::vec3 axes[6] = {
+			{ 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+			{-1.0f, 0.0f, 0.0f }, { 0.0f,-1.0f, 0.0f }, { 0.0f, 0.0f,-1.0f }
+		};
+
+		std::vector<glm::vec3> vertices;
+
+		// octant faces (x, y, z), counter clockwise seen from outside
+		for(auto f = 0u; f < 8; ++f)
+		{
+			const auto &a = axes[(f & 1) ? 3 : 0];
+			const auto &b = axes[(f & 2) ? 4 : 1];
+			const auto &c = axes[(f & 4) ? 5 : 2];
+			const auto isFlipped = std::bitset<3>(f).count() % 2 == 1;	// odd number of mirrored axes
+
+			const auto getPoint = [&](uint32_t _i, uint32_t _j)
+			{
+				const auto u = static_cast<float>(_i) / n;
+				const auto v = static_cast<float>(_j) / n;
+
+				return glm::normalize(a * (1.0f - u - v) + b * u + c * v);
+			};
+
+			const auto addTriangle = [&](const glm::vec3 &_p0, const glm::vec3 &_p1, const glm::vec3 &_p2)
+			{
+				vertices.push_back(_p0);
+				vertices.push_back(isFlipped ? _p2 : _p1);
+				vertices.push_back(isFlipped ? _p1 : _p2);
+			};
+
+			for(auto i = 0u; i < n; ++i)
+			{
+				for(auto j = 0u; i + j < n; ++j)
+				{
+					addTriangle(getPoint(i, j), getPoint(i + 1, j), getPoint(i, j + 1));
+
+					if(i + j + 1 < n) { addTriangle(getPoint(i + 1, j), getPoint(i + 1, j + 1), getPoint(i, j + 1)); }
+				}
+			}
+		}
+
+		// closest face plane to the center
+		auto minDist = 1.0f;
+
+		for(auto v = 0u; v < vertices.size(); v += 3)
+		{
+			const auto normal = glm::normalize(glm::cross(vertices[v + 1] - vertices[v], vertices[v + 2] - vertices[v]));
+
+			minDist = glm::min(minDist, glm::abs(glm::dot(normal, vertices[v])));
+		}
+
+		for(auto &vertex : vertices) { vertex /= minDist; }
+
+		const auto &usageFlags		= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+		const auto &memPropFlags	= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		const auto size						= vertices.size() * sizeof(glm::vec3);
+
+		auto &buffer = m_deferredScreenData.lightVolumeBuffer;
+		auto &memory = m_deferredScreenData.lightVolumeMemory;
+
+		VkDeviceSize alignment;
+		void *data = nullptr;
+
+		vk::Buffer::create(logicalDevice, size, usageFlags, buffer);
+		vk::Buffer::createMemory(
+			logicalDevice, usageFlags,
+			deviceData.memProps, memPropFlags,
+			buffer, alignment, memory
+		);
+		vk::Device::mapMemory(logicalDevice, memory, &data);
+		memcpy(data, vertices.data(), size);
+		vk::Device::unmapMemory(logicalDevice, memory);
+
+		m_deferredScreenData.lightVolumeVtxCount = static_cast<uint32_t>(vertices.size());
+
+		INFO_LOG(
+			"Light volumes: %u lights, %u triangles per volume",
+			DeferredScreenData::s_lightCount, m_deferredScreenData.lightVolumeVtxCount / 3
+		);
+	}
+
+	void Deferred::setOffscreenUBOData(DeferredScreenData::OffScreenUBO &_data) noexcept
+	{
+		const auto &cameraData = m_screenData.camera.getData();
+		const auto &matrices = cameraData.matrices;
+
+		_data = {
+			matrices.perspective,
+			matrices.view
+		};
+	}
+
+	void Deferred::setCompositionUBOData(DeferredScreenData::CompositionUBO &_data) noexcept
+	{
+		const auto &camera			= m_screenData.camera;
+		const auto &cameraData	= camera.getData();
+		const auto &matrices		= cameraData.matrices;
+		const auto &extent			= m_device->getData().swapchainData.extent;
+		const auto &gridSize		= DeferredScreenData::s_clusterGridSize;
+
+		// depth slice k: [near * (far / near)^(k / z), near * (far / near)^((k + 1) / z)]
+		const auto zNear				= camera.getZNear();
+		const auto zFar					= camera.getZFar();
+		const auto sliceScale		= static_cast<float>(gridSize.z) / std::log(zFar / zNear);
+		const auto sliceBias		= -sliceScale * std::log(zNear);
+
+		_data = {
+			// Current View Position
+			glm::vec4(cameraData.pos, 1.0f),
+			matrices.view,
+			glm::inverse(matrices.perspective),
+			glm::uvec4(gridSize, DeferredScreenData::s_lightCount),
+			glm::vec4(zNear, zFar, sliceScale, sliceBias),
+			glm::vec2(extent.width, extent.height),
+			m_screenData.isLightHeatmap,
+			m_deferredScreenData.tileCount,
+			matrices.perspective * matrices.view,
+			glm::inverse(matrices.perspective * matrices.view)
+		};
+	}
+
+	void Deferred::updateOffscreenUBO() noexcept
+	{
+		using BufferCategory	= vk::Buffer::Category;
+
+		auto &ubos = m_deferredScreenData.bufferData.entries;
+
+		DeferredScreenData::OffScreenUBO offscreenUBO = {};
+		setOffscreenUBOData(offscreenUBO);
+
+		memcpy(ubos[BufferCategory::OFFSCREEN], &offscreenUBO, sizeof(offscreenUBO));
+	}
+
+	void Deferred::updateCompositionUBO() noexcept
+	{
+		using BufferCategory	= vk::Buffer::Category;
+
+		auto &ubos = m_deferredScreenData.bufferData.entries;
+
+		DeferredScreenData::CompositionUBO compositionUBO = {};
+		setCompositionUBOData(compositionUBO);
+
+		memcpy(ubos[BufferCategory::COMPOSITION], &compositionUBO, sizeof(compositionUBO));
+	}
+
+	void Deferred::setupDescPool(
+		uint32_t _materialCount,
+		uint32_t _maxSetCount
+	) noexcept
+	{
+		using DescType				= vk::descriptor::Type;
+		using Desc						= vk::Descriptor;
+		using TextureMap			= vk::Texture::Sampler;
+
+		auto &logicalDevice		= m_device->getData().logicalDevice;
+		auto &descriptorData	= m_deferredScreenData.descriptorData;
+		auto texMapCount = vk::toInt(TextureMap::_count_);
+
+		const auto &poolSizes = {
+			Desc::createPoolSize(DescType::UNIFORM_BUFFER, 2),
+			Desc::createPoolSize(DescType::COMBINED_IMAGE_SAMPLER, _materialCount * texMapCount + 1), // @todo: texture maps per material, + lit image
+			Desc::createPoolSize(DescType::STORAGE_BUFFER, _materialCount * 2 + 3 + vk::Model::s_modelCount * 3), // instances & vertices, lights & clusters & tiles, meshlets & cull records & draw commands
+			Desc::createPoolSize(DescType::STORAGE_IMAGE, 1), // lit image
+			Desc::createPoolSize(DescType::INPUT_ATTACHMENT, 3) // g-buffer (subpasses)
+		};
+
+		Desc::createPool(
+			logicalDevice,
+			poolSizes,
+			_maxSetCount,
+			descriptorData.pool
+		);
+	}
+
+	void Deferred::setupDescriptors() noexcept
+	{
+		using DescType				= vk::descriptor::Type;
+		using BufferCategory	= vk::Buffer::Category;
+		using TextureParam		= vk::Material::TexParam;
+		using Desc						= vk::Descriptor;
+
+		auto &logicalDevice			= m_device->getData().logicalDevice;
+		auto &descriptorData		= m_deferredScreenData.descriptorData;
+		auto &setLayouts				= descriptorData.setLayouts;
+		auto &bufferData				= m_deferredScreenData.bufferData;
+		auto &modelsData				= m_screenData.modelsData;
+		auto &bufferInfos				= bufferData.descriptors;
+		auto &descSets					= descriptorData.sets;
+
+		auto tempData = DeferredScreenData::DescriptorData::Temp::create();
+		auto &descriptors					= tempData.descriptors;
+
+		for(const auto &model : modelsData)
+		{ tempData.maxSetCount += model.textureCount; tempData.materialCount += model.materials.size(); }
+
+		tempData.maxSetCount += 1 + vk::Model::s_modelCount;
+
+		setupDescPool(tempData.materialCount, tempData.maxSetCount);
+
+		const auto &dsLayoutBindings		= GET_DESC_SET_LAYOUT_BINDINGS(DEFERRED_SHADING)
+		const auto &cullLayoutBindings	= GET_DESC_SET_LAYOUT_BINDINGS(MESHLET_CULLING)
+
+		const uint16_t GEOM_VS_UBO			= 0;
+		const uint16_t COLOR						= 1;
+		const uint16_t NORMAL						= 2;
+		const uint16_t INSTANCE_SSBO		= 5;
+		const uint16_t VERTEX_SSBO			= 6;
+
+		Desc::createSetLayout(
+			logicalDevice,
+			dsLayoutBindings,
+			setLayouts[Desc::LayoutCategory::DEFERRED_SHADING]
+		);
+		Desc::createSetLayout(
+			logicalDevice,
+			cullLayoutBindings,
+			setLayouts[Desc::LayoutCategory::MESHLET_CULLING]
+		);
+
+		descSets.resize(tempData.materialCount + 1); // @todo: 1 set for COMPOSITION buffers + 1 per model images/textures
+
+		auto setIndex = 0;
+
+		// COMPOSITION Set (Deferred)
+		{
+			auto &set = descSets[setIndex];
+
+			Desc::allocSets(
+				logicalDevice,
+				descriptorData.pool,
+				&setLayouts[Desc::LayoutCategory::DEFERRED_SHADING],
+				&set
+			);
+
+			updateCompositionDescriptors();
+
+			setIndex += 1;
+		}
+
+		// Camera Matrices + Models Materials Sets (Offscreen)
+		{
+			for(auto i = 0u; i < vk::Model::s_modelCount; ++i)
+			{
+				const auto &materials = modelsData[i].materials;
+				const VkDescriptorBufferInfo instanceInfo	= { modelsData[i].instanceBuffer, 0, VK_WHOLE_SIZE };
+				const VkDescriptorBufferInfo vertexInfo		= { bufferData.buffers[vk::Buffer::Type::VERTEX], 0, VK_WHOLE_SIZE };
+
+				for(const auto &material : materials)
+				{
+					auto &set = descSets[setIndex];
+
+					Desc::allocSets(
+						logicalDevice,
+						descriptorData.pool,
+						&setLayouts[Desc::LayoutCategory::DEFERRED_SHADING],
+						&set
+					);
+
+					const auto &imageInfos = material.descriptors;
+
+					descriptors = {
 						Desc::createDescriptor(set, dsLayoutBindings[GEOM_VS_UBO],	&bufferInfos[BufferCategory::OFFSCREEN]), // TODO: should use a separate set since it's dynamic per view change
 						Desc::createDescriptor(set, dsLayoutBindings[COLOR],				&imageInfos	[TextureParam::BASE_COLOR_TEXTURE]),
-						Desc::createDescriptor(set, dsLayoutBindings[NORMAL],				&imageInfos	[TextureParam::NORMAL_TEXTURE])
+						Desc::createDescriptor(set, dsLayoutBindings[NORMAL],				&imageInfos	[TextureParam::NORMAL_TEXTURE]),
+						Desc::createDescriptor(set, dsLayoutBindings[INSTANCE_SSBO],	&instanceInfo),
+						Desc::createDescriptor(set, dsLayoutBindings[VERTEX_SSBO],		&vertexInfo)
 					};
 
-					Desc::updateSets(logicalDevice, descriptors);
+					Desc::updateSets(logicalDevice, descriptors, descriptors.size());
 
 					setIndex++;
 				}
 			}
 		}
+
+		// Meshlet Culling Sets (per model, compute)
+		{
+			const uint16_t MESHLET_SSBO	= 0;
+			const uint16_t CULL_SSBO		= 1;
+			const uint16_t DRAW_SSBO		= 2;
+
+			auto &cullSets = m_deferredScreenData.meshletCullSets;
+
+			cullSets.assign(vk::Model::s_modelCount, VK_NULL_HANDLE);
+
+			for(auto i = 0u; i < vk::Model::s_modelCount; ++i)
+			{
+				const auto &modelData = modelsData[i];
+				auto &set = cullSets[i];
+
+				if(modelData.drawCmdBuffer == VK_NULL_HANDLE) { continue; }
+
+				Desc::allocSets(
+					logicalDevice,
+					descriptorData.pool,
+					&setLayouts[Desc::LayoutCategory::MESHLET_CULLING],
+					&set
+				);
+
+				const VkDescriptorBufferInfo meshletInfo		= { modelData.meshletBuffer,		0, VK_WHOLE_SIZE };
+				const VkDescriptorBufferInfo cullRecordInfo	= { modelData.cullRecordBuffer,	0, VK_WHOLE_SIZE };
+				const VkDescriptorBufferInfo drawCmdInfo		= { modelData.drawCmdBuffer,		0, VK_WHOLE_SIZE };
+
+				descriptors = {
+					Desc::createDescriptor(set, cullLayoutBindings[MESHLET_SSBO],	&meshletInfo),
+					Desc::createDescriptor(set, cullLayoutBindings[CULL_SSBO],		&cullRecordInfo),
+					Desc::createDescriptor(set, cullLayoutBindings[DRAW_SSBO],		&drawCmdInfo)
+				};
+
+				Desc::updateSets(logicalDevice, descriptors);
+			}
+		}
+	}
+
+	// composition set: g-buffer & lit image views, UBO & SSBOs (rewritten when the screen targets are recreated)
+	void Deferred::updateCompositionDescriptors() noexcept
+	{
+		using BufferCategory	= vk::Buffer::Category;
+		using Att							= vk::Attachment;
+		using Desc						= vk::Descriptor;
+
+		using AttTag					= Att::Tag;
+		using AttColor				= AttTag::Color;
+
+		auto &logicalDevice			= m_device->getData().logicalDevice;
+		auto &attachmentData		= m_deferredScreenData.framebufferData.attachments;
+		auto &bufferInfos				= m_deferredScreenData.bufferData.descriptors;
+		auto &set								= m_deferredScreenData.descriptorData.sets[vk::Pipeline::Type::COMPOSITION];
+
+		auto tempData = DeferredScreenData::DescriptorData::Temp::create();
+		auto &descriptors					= tempData.descriptors;
+
+		const auto &dsLayoutBindings = GET_DESC_SET_LAYOUT_BINDINGS(DEFERRED_SHADING)
+
+		const uint16_t POSITION					= 1;
+		const uint16_t NORMAL						= 2;
+		const uint16_t ALBEDO						= 3;
+		const uint16_t LIGHT_FS_UBO			= 4;
+		const uint16_t LIGHT_SSBO				= 7;
+		const uint16_t CLUSTER_SSBO			= 8;
+		const uint16_t TILE_SSBO				= 9;
+		const uint16_t LIT_IMAGE				= 10;
+		const uint16_t LIT_MAP					= 11;
+		const uint16_t POSITION_INPUT		= 12;
+		const uint16_t NORMAL_INPUT			= 13;
+		const uint16_t ALBEDO_INPUT			= 14;
+
+		auto attTempData = Att::Data<DeferredScreenData::s_fbAttCount>::Temp::create();
+		auto &imageInfos = attTempData.imageDescs;
+		const auto gBufferViews = getGBufferViews();
+
+		for(auto i = 0u; i < vk::toInt(AttColor::_count_); ++i)
+		{
+			auto &imageDescriptor = imageInfos[i];
+			const auto color = static_cast<AttColor>(i);
+
+			imageDescriptor.sampler			= attachmentData.samplers[0];
+			imageDescriptor.imageLayout	= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+			// compact g-buffer: depth in place of the positions
+			if(DeferredScreenData::isCompactGBuffer() && color == AttColor::POSITION)
+			{
+				imageDescriptor.imageView		= m_deferredScreenData.depthView;
+				imageDescriptor.imageLayout	= VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+				continue;
+			}
+
+			imageDescriptor.imageView = gBufferViews[DeferredScreenData::getGBufferIndex(color)];
+		}
+
+		const VkDescriptorBufferInfo lightInfo		= { m_deferredScreenData.lightBuffer,		0, VK_WHOLE_SIZE };
+		const VkDescriptorBufferInfo clusterInfo	= { m_deferredScreenData.clusterBuffer,	0, VK_WHOLE_SIZE };
+		const VkDescriptorBufferInfo tileInfo			= { m_deferredScreenData.tileBuffer,		0, VK_WHOLE_SIZE };
+
+		const auto &frameGraph	= m_deferredScreenData.frameGraph;
+		const auto litView			= m_deferredScreenData.litResource != vk::FrameGraph::s_invalidResource
+			? vk::FrameGraph::getImageView(frameGraph, m_deferredScreenData.litResource)
+			: VK_NULL_HANDLE;
+
+		// written in GENERAL, then transitioned for the composition pass by the frame graph
+		const VkDescriptorImageInfo litImageInfo	= { VK_NULL_HANDLE,					litView, VK_IMAGE_LAYOUT_GENERAL };
+		const VkDescriptorImageInfo litMapInfo		= { attachmentData.samplers[0],	litView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+
+		// subpasses: the (transient) g-buffer is only readable as input attachments, not sampled
+		if(DeferredScreenData::isSubpassLayout())
+		{
+			for(auto &imageDescriptor : imageInfos) { imageDescriptor.sampler = VK_NULL_HANDLE; }
+
+			descriptors = {
+				Desc::createDescriptor(set, dsLayoutBindings[POSITION_INPUT],	&imageInfos	[AttColor::POSITION]),
+				Desc::createDescriptor(set, dsLayoutBindings[NORMAL_INPUT],		&imageInfos	[AttColor::NORMAL]),
+				Desc::createDescriptor(set, dsLayoutBindings[ALBEDO_INPUT],		&imageInfos	[AttColor::ALBEDO])
+			};
+			Desc::updateSets(logicalDevice, descriptors, descriptors.size());
+		}
+		else
+		{
+			descriptors = {
+				Desc::createDescriptor(set, dsLayoutBindings[POSITION],	&imageInfos	[AttColor::POSITION]),
+				Desc::createDescriptor(set, dsLayoutBindings[NORMAL],		&imageInfos	[AttColor::NORMAL]),
+				Desc::createDescriptor(set, dsLayoutBindings[ALBEDO],		&imageInfos	[AttColor::ALBEDO])
+			};
+			Desc::updateSets(logicalDevice, descriptors, descriptors.size());
+		}
+
+		descriptors = {
+			Desc::createDescriptor(set, dsLayoutBindings[LIGHT_FS_UBO],	&bufferInfos[BufferCategory::COMPOSITION]),
+			Desc::createDescriptor(set, dsLayoutBindings[LIGHT_SSBO],		&lightInfo),
+			Desc::createDescriptor(set, dsLayoutBindings[CLUSTER_SSBO],	&clusterInfo),
+			Desc::createDescriptor(set, dsLayoutBindings[TILE_SSBO],		&tileInfo)
+		};
+
+		Desc::updateSets(logicalDevice, descriptors, descriptors.size());
+
+		// compute lighting only
+		if(litView != VK_NULL_HANDLE)
+		{
+			descriptors = {
+				Desc::createDescriptor(set, dsLayoutBindings[LIT_IMAGE],	&litImageInfo),
+				Desc::createDescriptor(set, dsLayoutBindings[LIT_MAP],		&litMapInfo)
+			};
+
+			Desc::updateSets(logicalDevice, descriptors, descriptors.size());
+		}
 	}
 
 	void Deferred::setupPipelines() noexcept
 	{
 		namespace lightingPassShader	= constants::shaders::lightingPass;
 		namespace geometryPassShader	= constants::shaders::geometryPass;
+		namespace meshletCullingShader	= constants::shaders::meshletCulling;
+		namespace lightCullingShader	= constants::shaders::lightCulling;
+		namespace tileClassShader			= constants::shaders::tileClassification;
+		namespace depthPrePassShader	= constants::shaders::depthPrePass;
+		using LightingMode						= DeferredScreenData::LightingMode;
+		using TileBucket							= DeferredScreenData::TileBucket;
 		using ShaderStage							= vk::Shader::Stage;
 		using PipelineType						= vk::Pipeline::Type;
 		using Vertex									= vk::Model::Vertex;
+		using PackedVertex						= vk::Model::PackedVertex;
 
 		auto psoData					= vk::Pipeline::PSO::create();
-		auto shaderData				= vk::Shader::Data<vk::toInt(ShaderStage::_count_)>();
+		auto shaderData				= vk::Shader::Data<vk::toInt(ShaderStage::COMPUTE)>();	// graphics stages
+
+		auto &deviceData			= m_device->getData();
+		auto &logicalDevice		= deviceData.logicalDevice;
+		auto &modelsData			= m_screenData.modelsData;
+		auto &pipelineData		= m_deferredScreenData.pipelineData;
+		auto &descriptorData	= m_deferredScreenData.descriptorData;
+		auto &shaderStages		= shaderData.stages;
+
+		// composition pipeline + per material pipeline (same number as all descriptor sets), + per material depth pre-pass
+		// pipeline
+		auto &prePassFirstPipeIdx	= m_deferredScreenData.prePassFirstPipeIdx;
+		auto prePassPipeCount			= 0u;
+
+		prePassFirstPipeIdx = static_cast<uint16_t>(descriptorData.sets.size());
+
+		if(DeferredScreenData::isDepthPrePass())
+		{
+			for(const auto &modelData : modelsData) { prePassPipeCount += static_cast<uint32_t>(modelData.materials.size()); }
+		}
+
+		pipelineData.pipelines.resize(prePassFirstPipeIdx + prePassPipeCount);
+
+		vk::Pipeline::createCache(logicalDevice, pipelineData.cache);
+
+		// single pipeline layout used for all desc set layouts (no push constants: node matrices in the instance SSBO)
+		vk::Pipeline::createLayout(
+			logicalDevice,
+			descriptorData.setLayouts,
+			pipelineData.pipeLayoutDescSets,
+			pipelineData.layouts
+		);
+
+		// g-buffer layout of the lighting shaders (constant_id 1)
+		const VkBool32 isCompact		= DeferredScreenData::isCompactGBuffer();
+		const auto gBufferMapEntry	= vk::Shader::setSpecializationMapEntry(1, 0, sizeof(isCompact));
+		auto gBufferSpecInfo				= vk::Shader::setSpecializationInfo(&isCompact, sizeof(isCompact), &gBufferMapEntry, 1);
+
+		// Deferred (Lighting) Pass Pipeline
+
+		const auto isLightVolumes		= DeferredScreenData::s_lightingMode == LightingMode::LIGHT_VOLUMES;
+		const auto isTileClassified	= DeferredScreenData::s_lightingMode == LightingMode::TILE_CLASSIFIED;
+		const auto isComputeLit			= DeferredScreenData::s_lightingMode == LightingMode::COMPUTE;
+
+		if(isLightVolumes)
+		{
+			setShader<ShaderStage::VERTEX>(lightingPassShader::volumeVert, shaderData);
+			setShader<ShaderStage::FRAGMENT>(lightingPassShader::volumeFrag, shaderData, &gBufferSpecInfo);
+
+			auto volumePsoData = vk::Pipeline::PSO::create();
+			auto additiveBlend = vk::Pipeline::setColorBlendAttachment();
+
+			additiveBlend.blendEnable					= VK_TRUE;
+			additiveBlend.dstColorBlendFactor	= VK_BLEND_FACTOR_ONE;
+			additiveBlend.dstAlphaBlendFactor	= VK_BLEND_FACTOR_ONE;
+
+			// back faces (camera inside a volume) behind the g-buffer depth (read only): only the pixels in front of
+			// the volume's far side are shaded, the light range is still tested per pixel against the g-buffer position
+			volumePsoData.rasterizationState.cullMode				= VK_CULL_MODE_FRONT_BIT;
+			volumePsoData.depthStencilState.depthTestEnable		= VK_TRUE;
+			volumePsoData.depthStencilState.depthWriteEnable	= VK_FALSE;
+			volumePsoData.depthStencilState.depthCompareOp		= VK_COMPARE_OP_GREATER_OR_EQUAL;
+			volumePsoData.colorBlendState.attachments					= { additiveBlend };
+			volumePsoData.vertexInputState.vertexBindingDescs	= {
+				{ 0, sizeof(glm::vec3), VK_VERTEX_INPUT_RATE_VERTEX }
+			};
+			volumePsoData.vertexInputState.vertexAttrDescs		= {
+				{ 0, 0, vk::FormatType::R32G32B32_SFLOAT, 0 } // Position (vec3, unit volume)
+			};
+
+			setPipeline<PipelineType::COMPOSITION>(volumePsoData, shaderStages);
+		}
+		else if(isTileClassified)
+		{
+			setShader<ShaderStage::VERTEX>(lightingPassShader::tiledVert, shaderData);
+			setShader<ShaderStage::FRAGMENT>(lightingPassShader::tiledFrag, shaderData);
+
+			auto tilePsoData = vk::Pipeline::PSO::create();
+
+			tilePsoData.rasterizationState.cullMode				= VK_CULL_MODE_NONE;
+			tilePsoData.depthStencilState.depthTestEnable		= VK_FALSE;
+			tilePsoData.depthStencilState.depthWriteEnable	= VK_FALSE;
+
+			// one pipeline per drawn bucket (the bucket is a specialization constant of both stages)
+			for(auto b = vk::toInt(TileBucket::UNLIT); b < DeferredScreenData::s_tileBucketCount; ++b)
+			{
+				const uint32_t specData[2] = { b, isCompact };
+				const VkSpecializationMapEntry specMapEntries[2] = {
+					vk::Shader::setSpecializationMapEntry(0, 0,									sizeof(uint32_t)),	// bucket
+					vk::Shader::setSpecializationMapEntry(1, sizeof(uint32_t),	sizeof(uint32_t))		// g-buffer layout
+				};
+				const auto specInfo = vk::Shader::setSpecializationInfo(&specData, sizeof(specData), specMapEntries, 2);
+				const auto &bucket = specData[0];
+
+				shaderStages[ShaderStage::VERTEX].pSpecializationInfo		= &specInfo;
+				shaderStages[ShaderStage::FRAGMENT].pSpecializationInfo	= &specInfo;
+
+				if(bucket == vk::toInt(TileBucket::COMPLEX))
+				{
+					setPipeline<PipelineType::COMPOSITION>(tilePsoData, shaderStages);
+					continue;
+				}
+
+				vk::Pipeline::createGraphicsPipeline(
+					logicalDevice,
+					getRenderPass(m_screenData),
+					pipelineData.cache, pipelineData.layouts[0],
+					shaderStages,
+					tilePsoData,
+					m_deferredScreenData.tilePipelines[b]
+				);
+			}
+
+			shaderStages[ShaderStage::VERTEX].pSpecializationInfo		= nullptr;
+			shaderStages[ShaderStage::FRAGMENT].pSpecializationInfo	= nullptr;
+		}
+		else
+		{
+			setShader<ShaderStage::VERTEX>(lightingPassShader::vert, shaderData);
+			setShader<ShaderStage::FRAGMENT>(
+				isComputeLit																	? lightingPassShader::resolveFrag		:
+				DeferredScreenData::isSubpassLayout()	? lightingPassShader::subpassFrag	:
+																								lightingPassShader::clusteredFrag,
+				shaderData, &gBufferSpecInfo
+			);
+
+			psoData.rasterizationState.cullMode = VK_CULL_MODE_FRONT_BIT;
+			psoData.rasterizationState.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+			setPipeline<PipelineType::COMPOSITION>(psoData, shaderStages);
+		}
+
+		// Geometry (MRT) Pass / Material Pipeline(s)
+
+		const auto isPacked		= vk::Model::s_vertexLayout == vk::Model::VertexLayout::PACKED;
+		const auto isPulled		= vk::Model::isVertexPulling();
+		const auto isSplit		= vk::Model::isSplitStreams();
+
+		// pulled vertices: word offset of the attribute stream (constant_id 0, 0: interleaved vertices)
+		const uint32_t attrWordOffset	= static_cast<uint32_t>(vk::Model::getAttributeStreamOffset() / sizeof(uint32_t));
+		const auto streamMapEntry			= vk::Shader::setSpecializationMapEntry(0, 0, sizeof(attrWordOffset));
+		auto streamSpecInfo						= vk::Shader::setSpecializationInfo(&attrWordOffset, sizeof(attrWordOffset), &streamMapEntry, 1);
+
+		setShader<ShaderStage::VERTEX>(
+			isPulled ? geometryPassShader::pulledVert : isPacked ? geometryPassShader::packedVert : geometryPassShader::vert,
+			shaderData, isPulled ? &streamSpecInfo : nullptr
+		);
+		setShader<ShaderStage::FRAGMENT>(
+			DeferredScreenData::isCompactGBuffer() ? geometryPassShader::compactFrag : geometryPassShader::frag,
+			shaderData
+		);
+
+		psoData.rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
+		psoData.vertexInputState.vertexBindingDescs = {
+			{ 0, vk::Model::getVertexStride(), VK_VERTEX_INPUT_RATE_VERTEX }
+		};
+
+		if(isPulled)
+		{
+			// fetched in the vertex shader (VERTEX_SSBO)
+			psoData.vertexInputState.vertexBindingDescs.clear();
+			psoData.vertexInputState.vertexAttrDescs.clear();
+		}
+		else if(isPacked)
+		{
+			psoData.vertexInputState.vertexAttrDescs = {
+				{ 0, 0, vk::FormatType::R16G16B16A16_SNORM,	(uint32_t) offsetof(PackedVertex, position)	}, // Position	(vec4, w: tangent sign)
+				{ 1, 0, vk::FormatType::R16G16_SFLOAT,			(uint32_t) offsetof(PackedVertex, texCoord)	}, // UV				(vec2)
+				{ 2, 0, vk::FormatType::R8G8B8A8_UNORM,			(uint32_t) offsetof(PackedVertex, color)		}, // Color			(vec4)
+				{ 3, 0, vk::FormatType::R16G16_SNORM,				(uint32_t) offsetof(PackedVertex, normal)		}, // Normal 		(oct vec2)
+				{ 4, 0, vk::FormatType::R16G16_SNORM,				(uint32_t) offsetof(PackedVertex, tangent)	}  // Tangent 	(oct vec2)
+			};
+		}
+		else
+		{
+			psoData.vertexInputState.vertexAttrDescs = {
+				{ 0, 0, vk::FormatType::R32G32B32_SFLOAT,			(uint32_t) offsetof(Vertex, position)	}, // Position	(vec3)
+				{ 1, 0, vk::FormatType::R32G32_SFLOAT,				(uint32_t) offsetof(Vertex, texCoord)	}, // UV				(vec2)
+				{ 2, 0, vk::FormatType::R32G32B32_SFLOAT,			(uint32_t) offsetof(Vertex, color)		}, // Color			(vec3)
+				{ 3, 0, vk::FormatType::R32G32B32_SFLOAT,			(uint32_t) offsetof(Vertex, normal)		}, // Normal 		(vec3)
+				{ 4, 0, vk::FormatType::R32G32B32A32_SFLOAT,	(uint32_t) offsetof(Vertex, tangent)	}  // Tangent 	(vec4)
+			};
+		}
 
-		auto &deviceData			= m_device->getData();
-		auto &logicalDevice		= deviceData.logicalDevice;
-		auto &modelsData			= m_screenData.modelsData;
-		auto &pipelineData		= m_deferredScreenData.pipelineData;
-		auto &descriptorData	= m_deferredScreenData.descriptorData;
-		auto &shaderStages		= shaderData.stages;
+		// split vertex streams: the position from binding 0, the rest from binding 1 (offsets within the stream)
+		if(!isPulled && isSplit)
+		{
+			const auto posStride = vk::Model::getPositionStride();
 
-		// composition pipeline + per material pipeline (same number as all descriptor sets)
-		pipelineData.pipelines.resize(descriptorData.sets.size());
+			psoData.vertexInputState.vertexBindingDescs = {
+				{ 0, posStride,																	VK_VERTEX_INPUT_RATE_VERTEX },
+				{ 1, vk::Model::getVertexStride() - posStride,	VK_VERTEX_INPUT_RATE_VERTEX }
+			};
 
-		vk::Pipeline::createCache(logicalDevice, pipelineData.cache);
+			for(auto &attrDesc : psoData.vertexInputState.vertexAttrDescs)
+			{
+				if(attrDesc.location == 0) { continue; }
 
-		VkPushConstantRange pushConstRange = {};
+				attrDesc.binding	= 1;
+				attrDesc.offset		-= posStride;
+			}
+		}
 
-		pushConstRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-		pushConstRange.offset			= 0;
-		pushConstRange.size				= sizeof(vk::Model::Node::matrix); // glm::mat4
+		// POSITION (full g-buffer), NORMAL, ALBEDO
+		psoData.colorBlendState.attachments.assign(
+			DeferredScreenData::s_gBufferColorCount,
+			vk::Pipeline::setColorBlendAttachment()
+		);
 
-		pipelineData.pushConstRanges = {
-			pushConstRange
-		};
+		// Depth Pre-Pass Pipeline(s): position only (no fragment shader), or the geometry pass vertex input + alpha test
+		// (masked materials), no color writes
 
-		// single pipeline layout used for all desc set layouts
-		vk::Pipeline::createLayout(
-			logicalDevice,
-			pipelineData.pushConstRanges,
-			descriptorData.setLayouts,
-			pipelineData.pipeLayoutDescSets,
-			pipelineData.layouts
-		);
+		auto depthShaderData	= vk::Shader::Data<vk::toInt(ShaderStage::COMPUTE)>();
+		auto depthPsoData			= psoData;
+		auto maskedPsoData		= psoData;
 
-		// Deferred (Lighting) Pass Pipeline
+		depthShaderData.moduleIndex = shaderData.moduleIndex;
 
-		setShader<ShaderStage::VERTEX>(lightingPassShader::vert, shaderData);
-		setShader<ShaderStage::FRAGMENT>(lightingPassShader::frag, shaderData);
+		if(DeferredScreenData::isDepthPrePass())
+		{
+			setShader<ShaderStage::VERTEX>(
+				isPulled ? depthPrePassShader::pulledVert : depthPrePassShader::vert,
+				depthShaderData, isPulled ? &streamSpecInfo : nullptr
+			);
+			setShader<ShaderStage::FRAGMENT>(depthPrePassShader::maskedFrag, depthShaderData);
 
-		psoData.rasterizationState.cullMode = VK_CULL_MODE_FRONT_BIT;
-		psoData.rasterizationState.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-		setPipeline<PipelineType::COMPOSITION>(psoData, shaderStages);
+			// position only: binding 0 (the whole vertex if interleaved, stream 0 if split)
+			if(!isPulled)
+			{
+				depthPsoData.vertexInputState.vertexBindingDescs.resize(1);
+				depthPsoData.vertexInputState.vertexAttrDescs = {
+					{ 0, 0, isPacked ? vk::FormatType::R16G16B16A16_SNORM : vk::FormatType::R32G32B32_SFLOAT, 0 } // Position
+				};
+			}
 
-		// Geometry (MRT) Pass / Material Pipeline(s)
+			depthPsoData.colorBlendState.attachments.assign(
+				DeferredScreenData::s_gBufferColorCount,
+				vk::Pipeline::setColorBlendAttachment(0)
+			);
+			maskedPsoData.colorBlendState.attachments = depthPsoData.colorBlendState.attachments;
 
-		setShader<ShaderStage::VERTEX>(geometryPassShader::vert, shaderData);
-		setShader<ShaderStage::FRAGMENT>(geometryPassShader::frag, shaderData);
+			// g-buffer: only the fragments of the nearest surface, already in the depth attachment
+			psoData.depthStencilState.depthCompareOp		= VK_COMPARE_OP_EQUAL;
+			psoData.depthStencilState.depthWriteEnable	= VK_FALSE;
+		}
 
-		psoData.rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
-		psoData.vertexInputState.vertexBindingDescs = {
-			{ 0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX }
-		};
-		psoData.vertexInputState.vertexAttrDescs = {
-			{ 0, 0, vk::FormatType::R32G32B32_SFLOAT,			(uint32_t) offsetof(Vertex, position)	}, // Position	(vec3)
-			{ 1, 0, vk::FormatType::R32G32_SFLOAT,				(uint32_t) offsetof(Vertex, texCoord)	}, // UV				(vec2)
-			{ 2, 0, vk::FormatType::R32G32B32A32_SFLOAT,	(uint32_t) offsetof(Vertex, color)		}, // Color			(vec4)
-			{ 3, 0, vk::FormatType::R32G32B32_SFLOAT,			(uint32_t) offsetof(Vertex, normal)		}, // Normal 		(vec3)
-			{ 4, 0, vk::FormatType::R32G32B32A32_SFLOAT,	(uint32_t) offsetof(Vertex, tangent)	}  // Tangent 	(vec4)
-		};
-		psoData.colorBlendState.attachments = {
-			vk::Pipeline::setColorBlendAttachment(), 	// POSITION
-			vk::Pipeline::setColorBlendAttachment(),	// NORMAL
-			vk::Pipeline::setColorBlendAttachment()		// ALBEDO
-		};
+		auto depthStages	= vk::Array<VkPipelineShaderStageCreateInfo, 1>(depthShaderData.stages[ShaderStage::VERTEX]);
+		auto maskedStages	= vk::Array<VkPipelineShaderStageCreateInfo, 2>(
+			shaderStages[ShaderStage::VERTEX], depthShaderData.stages[ShaderStage::FRAGMENT]
+		);
 
 		for(auto i = 0u; i < vk::Model::s_modelCount; ++i)
 		{
@@ -495,15 +1478,21 @@ namespace renderer
 				{
 					VkBool32	alphaMask;
 					float 		alphaMaskCutoff;
+					float			roughness;	// compact g-buffer normal target's spare channels
+					float			metalness;
 				} specData
 				{
 					material.alphaMode == vk::Material::alphaModes[vk::Material::AlphaMode::MASK_],
-					material.alphaCutoff
+					material.alphaCutoff,
+					material.roughnessFactor,
+					material.metallicFactor
 				};
 
-				const VkSpecializationMapEntry specMapEntries[2] = {
+				const VkSpecializationMapEntry specMapEntries[4] = {
 					vk::Shader::setSpecializationMapEntry(0, offsetof(SpecData, alphaMask), sizeof(SpecData::alphaMask)),
-					vk::Shader::setSpecializationMapEntry(1, offsetof(SpecData, alphaMaskCutoff), sizeof(SpecData::alphaMaskCutoff))
+					vk::Shader::setSpecializationMapEntry(1, offsetof(SpecData, alphaMaskCutoff), sizeof(SpecData::alphaMaskCutoff)),
+					vk::Shader::setSpecializationMapEntry(2, offsetof(SpecData, roughness), sizeof(SpecData::roughness)),
+					vk::Shader::setSpecializationMapEntry(3, offsetof(SpecData, metalness), sizeof(SpecData::metalness))
 				};
 				const auto specInfo = vk::Shader::setSpecializationInfo(
 					&specData, sizeof(specData),
@@ -514,37 +1503,176 @@ namespace renderer
 				psoData.rasterizationState.cullMode = material.doubleSided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
 
 				setPipeline<PipelineType::OFFSCREEN>(psoData, shaderStages, j + 1);
+
+				if(!DeferredScreenData::isDepthPrePass()) { continue; }
+
+				const auto prePassPipeIdx = prePassFirstPipeIdx + j;
+
+				if(specData.alphaMask)
+				{
+					maskedStages[ShaderStage::FRAGMENT].pSpecializationInfo	= &specInfo;
+					maskedPsoData.rasterizationState.cullMode								= psoData.rasterizationState.cullMode;
+
+					setPipeline<PipelineType::OFFSCREEN>(maskedPsoData, maskedStages, prePassPipeIdx);
+					continue;
+				}
+
+				depthPsoData.rasterizationState.cullMode = psoData.rasterizationState.cullMode;
+
+				setPipeline<PipelineType::OFFSCREEN>(depthPsoData, depthStages, prePassPipeIdx);
 			}
 		}
+
+		// Compute Pipelines
+
+		auto computeShaderData = vk::Shader::Data<vk::toInt(ShaderStage::_count_)>();
+		computeShaderData.moduleIndex = depthShaderData.moduleIndex;
+
+		const auto &createComputePipeline = [&](const char *_shaderFile, VkPipeline &_pipeline)
+		{
+			setShader<ShaderStage::COMPUTE>(_shaderFile, computeShaderData, &gBufferSpecInfo);
+
+			vk::Pipeline::createComputePipeline(
+				logicalDevice,
+				pipelineData.cache, pipelineData.layouts[0],
+				computeShaderData.stages[ShaderStage::COMPUTE],
+				_pipeline
+			);
+		};
+
+		// Meshlet Culling
+		createComputePipeline(meshletCullingShader::comp, m_deferredScreenData.meshletCullingPipeline);
+
+		// Clustered Light Culling
+		if(DeferredScreenData::isClusteredLighting())
+		{
+			createComputePipeline(lightCullingShader::comp, m_deferredScreenData.lightCullingPipeline);
+		}
+
+		// Tile Classification
+		if(isTileClassified)
+		{
+			createComputePipeline(tileClassShader::comp, m_deferredScreenData.tileClassificationPipeline);
+		}
+
+		// Tiled Lighting
+		if(isComputeLit)
+		{
+			createComputePipeline(lightingPassShader::comp, m_deferredScreenData.lightingPipeline);
+		}
 	}
 
 	void Deferred::setupBaseCommands() noexcept
 	{
 		using PipelineType = vk::Pipeline::Type;
 
+		using LightingMode = DeferredScreenData::LightingMode;
+		using TileBucket = DeferredScreenData::TileBucket;
+
 		const auto &pipelineData = m_deferredScreenData.pipelineData;
 		const auto &descriptorData = m_deferredScreenData.descriptorData;
 
+		// subpasses: the whole frame is in the swapchain command buffers
+		if(DeferredScreenData::isSubpassLayout())
+		{
+			setupSwapchainFramebuffers();
+			recordSubpassCommands();
+			return;
+		}
+
+		std::function<void(const VkCommandBuffer&)> drawCallback = nullptr; // full-screen triangle
+		VkRenderPass renderPass = VK_NULL_HANDLE;	// Base's
+		const std::vector<VkFramebuffer> *framebuffers = nullptr;
+
+		switch(DeferredScreenData::s_lightingMode)
+		{
+			// one instance per light (LIGHT_SSBO), depth tested against the g-buffer's
+			case LightingMode::LIGHT_VOLUMES:
+				setupSwapchainFramebuffers();
+
+				renderPass		= m_deferredScreenData.volumeRenderPass;
+				framebuffers	= &m_deferredScreenData.swapchainFramebuffers;
+
+				drawCallback = [&](const VkCommandBuffer &_cmdBuffer)
+				{
+					vk::Command::bindVtxBuffers(_cmdBuffer, m_deferredScreenData.lightVolumeBuffer, 0);
+					vk::Command::draw(_cmdBuffer, m_deferredScreenData.lightVolumeVtxCount, 0, DeferredScreenData::s_lightCount);
+				};
+				break;
+
+			// one instance per classified tile (TILE_SSBO), counts written by the classification
+			case LightingMode::TILE_CLASSIFIED:
+				drawCallback = [&](const VkCommandBuffer &_cmdBuffer)
+				{
+					for(auto b = vk::toInt(TileBucket::UNLIT); b < DeferredScreenData::s_tileBucketCount; ++b)
+					{
+						const auto &pipeline = b == vk::toInt(TileBucket::COMPLEX)
+							? pipelineData.pipelines[PipelineType::COMPOSITION]
+							: m_deferredScreenData.tilePipelines[b];
+
+						vk::Command::bindPipeline(_cmdBuffer, pipeline);
+						vk::Command::drawIndirect(
+							_cmdBuffer, m_deferredScreenData.tileBuffer,
+							b * sizeof(VkDrawIndirectCommand), 1
+						);
+					}
+				};
+				break;
+
+			default: break;
+		}
+
 		Base::setupCommands(
 			pipelineData.pipelines[PipelineType::COMPOSITION],
 			pipelineData.layouts	[0],
-			&descriptorData.sets	[PipelineType::COMPOSITION]
+			&descriptorData.sets	[PipelineType::COMPOSITION],
+			1,
+			drawCallback,
+			renderPass, framebuffers
 		);
 	}
 
 	void Deferred::setupCommands() noexcept
 	{
-		const auto &deviceData = m_device->getData();
-		const auto &swapchainExtent = deviceData.swapchainData.extent;
-		const auto &framebufferData = m_deferredScreenData.framebufferData;
-
 		setupBaseCommands();
 
+		if(!DeferredScreenData::isSubpassLayout()) { recordOffscreenCommands(); }
+	}
+
+	// light culling, then a single render pass per swapchain image: g-buffer subpass & lighting subpass (input attachments)
+	void Deferred::recordSubpassCommands() noexcept
+	{
+		using PipelineType = vk::Pipeline::Type;
+
+		const auto &deviceData			= m_device->getData();
+		const auto &swapchainExtent	= deviceData.swapchainData.extent;
+		const auto &cmdBuffers			= deviceData.cmdData.drawCmdBuffers;
+		const auto &pipelineData		= m_deferredScreenData.pipelineData;
+		const auto &descriptorData	= m_deferredScreenData.descriptorData;
+
+		auto &framebufferData = m_deferredScreenData.framebufferData;
+
 		const auto &rpCallback = [&](const VkCommandBuffer &_cmdBuffer)
-		{ setupRenderPassCommands(_cmdBuffer); };
+		{
+			setupRenderPassCommands(_cmdBuffer);
+
+			vk::Command::nextSubpass(_cmdBuffer);
+
+			vk::Command::bindPipeline(_cmdBuffer, pipelineData.pipelines[PipelineType::COMPOSITION]);
+			vk::Command::bindDescSets(
+				_cmdBuffer,
+				&descriptorData.sets[PipelineType::COMPOSITION], 1,
+				nullptr, 0,
+				pipelineData.layouts[0]
+			);
+			vk::Command::draw(_cmdBuffer, 3);
+		};
 
 		const auto &recordCallback = [&](const VkCommandBuffer &_cmdBuffer)
 		{
+			recordLightCulling(_cmdBuffer);
+			resetStatsQuery(_cmdBuffer);
+
 			vk::Command::recordRenderPassCommands(
 				_cmdBuffer,
 				swapchainExtent,
@@ -553,30 +1681,279 @@ namespace renderer
 			);
 		};
 
+		for(auto i = 0u; i < cmdBuffers.size(); ++i)
+		{
+			framebufferData.framebuffer = m_deferredScreenData.swapchainFramebuffers[i];
+
+			vk::Command::record(cmdBuffers[i], recordCallback);
+		}
+
+		// owned by swapchainFramebuffers
+		framebufferData.framebuffer = VK_NULL_HANDLE;
+	}
+
+	// the frame graph's live passes, with the barriers between them (see setupFrameGraph)
+	void Deferred::recordOffscreenCommands() noexcept
+	{
+		const auto &recordCallback = [&](const VkCommandBuffer &_cmdBuffer)
+		{
+			vk::FrameGraph::execute(m_deferredScreenData.frameGraph, _cmdBuffer);
+		};
+
 		vk::Command::record(m_deferredScreenData.cmdBuffer, recordCallback);
 	}
 
+	// one invocation per meshlet (indirect draw command slot), ahead of the g-buffer draws reading the commands
+	void Deferred::recordMeshletCulling(const VkCommandBuffer &_cmdBuffer) noexcept
+	{
+		const auto &pipelineData	= m_deferredScreenData.pipelineData;
+		const auto &cullSets			= m_deferredScreenData.meshletCullSets;
+		const auto &modelsData		= m_screenData.modelsData;
+		const auto groupSize			= DeferredScreenData::s_meshletCullGroupSize;
+
+		vk::Command::bindPipeline(_cmdBuffer, m_deferredScreenData.meshletCullingPipeline, VK_PIPELINE_BIND_POINT_COMPUTE);
+
+		for(auto i = 0u; i < modelsData.size(); ++i)
+		{
+			if(cullSets[i] == VK_NULL_HANDLE) { continue; }
+
+			const auto meshletCount = static_cast<uint32_t>(modelsData[i].meshlets.size());
+
+			vk::Command::bindDescSets(
+				_cmdBuffer,
+				&cullSets[i], 1,
+				nullptr, 0,
+				pipelineData.layouts[0],
+				vk::toInt(vk::Descriptor::LayoutCategory::MESHLET_CULLING), VK_PIPELINE_BIND_POINT_COMPUTE
+			);
+
+			vk::Command::dispatch(_cmdBuffer, (meshletCount + groupSize - 1) / groupSize);
+		}
+
+		// draw commands written before they're read as indirect arguments
+		VkMemoryBarrier barrier = {};
+		barrier.sType					= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask	= VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask	= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+		vk::Command::insertBarriers(
+			_cmdBuffer, &barrier, 1, 0,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT
+		);
+	}
+
+	// one invocation per cluster, ahead of the g-buffer pass (the lists are only read by the composition pass)
+	void Deferred::recordLightCulling(const VkCommandBuffer &_cmdBuffer) noexcept
+	{
+		using PipelineType = vk::Pipeline::Type;
+
+		const auto &pipelineData	= m_deferredScreenData.pipelineData;
+		const auto &descSets			= m_deferredScreenData.descriptorData.sets;
+		const auto groupCount			= (DeferredScreenData::s_clusterCount + DeferredScreenData::s_clusterCullGroupSize - 1) /
+																	DeferredScreenData::s_clusterCullGroupSize;
+
+		vk::Command::bindPipeline(_cmdBuffer, m_deferredScreenData.lightCullingPipeline, VK_PIPELINE_BIND_POINT_COMPUTE);
+		vk::Command::bindDescSets(
+			_cmdBuffer,
+			&descSets[PipelineType::COMPOSITION], 1,
+			nullptr, 0,
+			pipelineData.layouts[0],
+			0, VK_PIPELINE_BIND_POINT_COMPUTE
+		);
+
+		vk::Command::dispatch(_cmdBuffer, groupCount);
+
+		// light lists written before they're read by the composition pass' fragments
+		VkBufferMemoryBarrier barrier = {};
+		barrier.sType								= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.srcAccessMask				= VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask				= VK_ACCESS_SHADER_READ_BIT;
+		barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		barrier.buffer							= m_deferredScreenData.clusterBuffer;
+		barrier.offset							= 0;
+		barrier.size								= VK_WHOLE_SIZE;
+
+		vk::Command::insertBarriers(
+			_cmdBuffer, &barrier, 1, 0,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+		);
+	}
+
+	// one workgroup per screen tile, after the g-buffer pass: appends the tile to its bucket's list & draw command
+	void Deferred::recordTileClassification(const VkCommandBuffer &_cmdBuffer) noexcept
+	{
+		using PipelineType = vk::Pipeline::Type;
+
+		const auto &pipelineData	= m_deferredScreenData.pipelineData;
+		const auto &descSets			= m_deferredScreenData.descriptorData.sets;
+		const auto &extent				= m_deferredScreenData.framebufferData.attachments.extent;
+		const auto &tileSize			= DeferredScreenData::s_tileSize;
+		const auto &tileBuffer		= m_deferredScreenData.tileBuffer;
+
+		// 6 vertices (tile quad) per instance, instance counts reset
+		vk::Array<VkDrawIndirectCommand, DeferredScreenData::s_tileBucketCount> drawCmds;
+
+		for(auto &drawCmd : drawCmds) { drawCmd = { 6, 0, 0, 0 }; }
+
+		vk::Command::updateBuffer(_cmdBuffer, tileBuffer, 0, sizeof(drawCmds), drawCmds.data());
+
+		// light lists & reset draw commands visible to the classification (g-buffer: frame graph)
+		VkMemoryBarrier barrier = {};
+		barrier.sType					= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask	= VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask	= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		vk::Command::insertBarriers(
+			_cmdBuffer, &barrier, 1, 0,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+		);
+
+		vk::Command::bindPipeline(_cmdBuffer, m_deferredScreenData.tileClassificationPipeline, VK_PIPELINE_BIND_POINT_COMPUTE);
+		vk::Command::bindDescSets(
+			_cmdBuffer,
+			&descSets[PipelineType::COMPOSITION], 1,
+			nullptr, 0,
+			pipelineData.layouts[0],
+			0, VK_PIPELINE_BIND_POINT_COMPUTE
+		);
+
+		vk::Command::dispatch(
+			_cmdBuffer,
+			(extent.width + tileSize - 1) / tileSize,
+			(extent.height + tileSize - 1) / tileSize
+		);
+
+		// bucket draws (composition pass)
+		barrier.srcAccessMask	= VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask	= VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+		vk::Command::insertBarriers(
+			_cmdBuffer, &barrier, 1, 0,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+		);
+	}
+
+	// one workgroup per screen tile, after the g-buffer pass: culls the lights against the tile's depth bounds into
+	// shared memory, then shades its pixels into the lit image (resolved by the composition pass), the g-buffer & lit
+	// image transitions are the frame graph's
+	void Deferred::recordComputeLighting(const VkCommandBuffer &_cmdBuffer) noexcept
+	{
+		using PipelineType = vk::Pipeline::Type;
+
+		const auto &pipelineData	= m_deferredScreenData.pipelineData;
+		const auto &descSets			= m_deferredScreenData.descriptorData.sets;
+		const auto &extent				= m_deferredScreenData.framebufferData.attachments.extent;
+		const auto &tileSize			= DeferredScreenData::s_tileSize;
+
+		vk::Command::bindPipeline(_cmdBuffer, m_deferredScreenData.lightingPipeline, VK_PIPELINE_BIND_POINT_COMPUTE);
+		vk::Command::bindDescSets(
+			_cmdBuffer,
+			&descSets[PipelineType::COMPOSITION], 1,
+			nullptr, 0,
+			pipelineData.layouts[0],
+			0, VK_PIPELINE_BIND_POINT_COMPUTE
+		);
+
+		vk::Command::dispatch(
+			_cmdBuffer,
+			(extent.width + tileSize - 1) / tileSize,
+			(extent.height + tileSize - 1) / tileSize
+		);
+	}
+
 	void Deferred::setupRenderPassCommands(const VkCommandBuffer &_offScreenCmdBuffer) noexcept
 	{
-		using Model = vk::Model;
+		using Model				= vk::Model;
+		using StatsQuery	= DeferredScreenData::StatsQuery;
 
 		const auto &deviceData = m_device->getData();
 		const auto &swapchainExtent = deviceData.swapchainData.extent;
 		const auto &descSets = m_deferredScreenData.descriptorData.sets;
 		const auto &pipelineData = m_deferredScreenData.pipelineData;
+		const auto &statsQueryPool = m_deferredScreenData.statsQueryPool;
 
 		vk::Command::setViewport(_offScreenCmdBuffer,	swapchainExtent);
 		vk::Command::setScissor (_offScreenCmdBuffer,	swapchainExtent);
 
-		Model::draw<Model::RenderingMode::PER_PRIMITIVE>(
-			_offScreenCmdBuffer,
-			m_screenData.modelsData,
-			m_deferredScreenData.bufferData,
-			pipelineData,
-			descSets,
-			1,	// 0: composition ubo set,	1+: offscreen ubo set + materials sets
-			1		// 0: composition pipeline, 1+: offscreen material pipelines
-		);
+		// same draws per pass: the depth pre-pass pipelines follow the material ones (see setupPipelines)
+		const auto &drawCallback = [&](StatsQuery _query, uint16_t _matFirstPipeIdx)
+		{
+			if(statsQueryPool != VK_NULL_HANDLE) { vk::Command::beginQuery(_offScreenCmdBuffer, statsQueryPool, vk::toInt(_query)); }
+
+			Model::draw<Model::RenderingMode::PER_PRIMITIVE>(
+				_offScreenCmdBuffer,
+				m_screenData.modelsData,
+				m_deferredScreenData.bufferData,
+				pipelineData,
+				descSets,
+				1,	// 0: composition ubo set,	1+: offscreen ubo set + materials sets
+				_matFirstPipeIdx
+			);
+
+			if(statsQueryPool != VK_NULL_HANDLE) { vk::Command::endQuery(_offScreenCmdBuffer, statsQueryPool, vk::toInt(_query)); }
+		};
+
+		if(DeferredScreenData::isDepthPrePass())
+		{
+			drawCallback(StatsQuery::DEPTH_PRE_PASS, m_deferredScreenData.prePassFirstPipeIdx);
+		}
+
+		drawCallback(StatsQuery::G_BUFFER, 1);	// 0: composition pipeline, 1+: offscreen material pipelines
+	}
+
+	// outside of the g-buffer render pass
+	void Deferred::resetStatsQuery(const VkCommandBuffer &_cmdBuffer) noexcept
+	{
+		using StatsQuery = DeferredScreenData::StatsQuery;
+
+		const auto &statsQueryPool = m_deferredScreenData.statsQueryPool;
+
+		if(statsQueryPool == VK_NULL_HANDLE) { return; }
+
+		vk::Command::resetQueryPool(_cmdBuffer, statsQueryPool, vk::toInt(StatsQuery::_count_));
+	}
+
+	// g-buffer fragment shader invocations per pixel of the last completed frame (1: no overdraw, full coverage)
+	void Deferred::logOverdrawStats() noexcept
+	{
+		using StatsQuery = DeferredScreenData::StatsQuery;
+
+		const auto &deviceData = m_device->getData();
+		const auto &swapchainExtent = deviceData.swapchainData.extent;
+		const auto &statsQueryPool = m_deferredScreenData.statsQueryPool;
+
+		if(statsQueryPool == VK_NULL_HANDLE) { return; }
+
+		// the pre-pass query is only issued with the pre-pass
+		const uint32_t queryCount = DeferredScreenData::isDepthPrePass() ? vk::toInt(StatsQuery::_count_) : 1;
+
+		uint64_t invocations[vk::toInt(StatsQuery::_count_)] = {};
+
+		if(!vk::Command::getQueryResults(
+			deviceData.logicalDevice, statsQueryPool,
+			queryCount, invocations, queryCount * sizeof(uint64_t)
+		)) { return; }
+
+		const auto pixelCount				= static_cast<double>(swapchainExtent.width) * swapchainExtent.height;
+		const auto gBufferOverdraw	= invocations[vk::toInt(StatsQuery::G_BUFFER)] / pixelCount;
+
+		// compile time switch: one configuration per run, labelled so the runs with the pre-pass on & off compare
+		if(DeferredScreenData::isDepthPrePass())
+		{
+			TRACE_LOG(
+				"Overdraw (depth pre-pass on): g-buffer %.2f fragments per pixel, pre-pass %.2f alpha tested fragments per pixel",
+				gBufferOverdraw, invocations[vk::toInt(StatsQuery::DEPTH_PRE_PASS)] / pixelCount
+			);
+		}
+		else
+		{
+			TRACE_LOG("Overdraw (depth pre-pass off): g-buffer %.2f fragments per pixel", gBufferOverdraw);
+		}
 	}
 
 	void Deferred::submitOffscreenToQueue() noexcept
@@ -607,6 +1984,35 @@ namespace renderer
 		auto &activeFbIndex = deviceData.swapchainData.activeFbIndex;
 
 		VkSubmitInfo submitInfo = {};
+
+		// subpasses: single submission (g-buffer & lighting), only the swapchain image is waited on
+		if(DeferredScreenData::isSubpassLayout())
+		{
+			vk::Command::setSubmitInfo(
+				&semaphores[vk::Sync::SemaphoreType::PRESENT_COMPLETE],
+				&semaphores[vk::Sync::SemaphoreType::RENDER_COMPLETE],
+				&cmdData.drawCmdBuffers[activeFbIndex],
+				submitInfo
+			);
+			vk::Command::submitToQueue(graphicsQueue, submitInfo, "Scene (Subpasses)");
+			return;
+		}
+
+		// single submission: offscreen then composition command buffers, in submission order
+		if(DeferredScreenData::isSingleSubmit())
+		{
+			const VkCommandBuffer cmdBuffers[2] = { m_deferredScreenData.cmdBuffer, cmdData.drawCmdBuffers[activeFbIndex] };
+
+			vk::Command::setSubmitInfo<1, 1, 2>(
+				&semaphores[vk::Sync::SemaphoreType::PRESENT_COMPLETE],
+				&semaphores[vk::Sync::SemaphoreType::RENDER_COMPLETE],
+				cmdBuffers,
+				submitInfo
+			);
+			vk::Command::submitToQueue(graphicsQueue, submitInfo, "Scene (Offscreen & Composition)");
+			return;
+		}
+
 		vk::Command::setSubmitInfo(
 			&m_deferredScreenData.semaphore,
 			&semaphores[vk::Sync::SemaphoreType::RENDER_COMPLETE],
@@ -615,7 +2021,10 @@ namespace renderer
 		);
 		vk::Command::submitToQueue(
 			graphicsQueue, submitInfo,
-			"Scene Composition"
+			"Scene Composition",
+			VK_NULL_HANDLE,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT	// tile draws, g-buffer & cluster light lists reads
 		);
 	}
 
@@ -623,8 +2032,11 @@ namespace renderer
 	{
 		beginFrame();
 
-		submitOffscreenToQueue();	// geometry/offscreen pass (g-buffer)
-		submitSceneToQueue();			// lighting/composition pass (deferred)
+		if(!DeferredScreenData::isSubpassLayout() && !DeferredScreenData::isSingleSubmit())
+		{
+			submitOffscreenToQueue();	// geometry/offscreen pass (g-buffer)
+		}
+		submitSceneToQueue();				// lighting/composition pass (deferred), + the offscreen pass if single submission
 
 		endFrame();
 	}
@@ -635,6 +2047,8 @@ namespace renderer
 
 		TIMER(start);
 
+		for(auto &modelData : m_screenData.modelsData) { vk::Model::updateInstances(modelData); }
+
 		draw();
 
 		if(!m_screenData.isPaused)
@@ -647,6 +2061,9 @@ namespace renderer
 		if(camera.isUpdated())
 		{
 			updateOffscreenUBO();
+			updateCompositionUBO();	// cluster bounds follow the view
+			updateVisibility();
+			logOverdrawStats();
 		}
 
 		TIMER(end);
@@ -654,8 +2071,151 @@ namespace renderer
 		camera.updateByKey(TIME_DIFF(start, end) / 1000.f);
 	}
 
+	// LOD selection & cluster culling write the cull records read by the meshlet culling pass, so the offscreen commands
+	// stay as recorded (previous frame's submission already completed, see Swapchain::queuePresentImage)
+	void Deferred::updateVisibility() noexcept
+	{
+		const auto &cameraData		= m_screenData.camera.getData();
+		const auto &matrices			= cameraData.matrices;
+		const auto &swapchainExtent	= m_device->getData().swapchainData.extent;
+
+		auto &modelsData	= m_screenData.modelsData;
+		auto &bvh					= m_screenData.bvh;
+		auto isChanged		= false;
+
+		for(auto &modelData : modelsData)
+		{
+			isChanged |= vk::Model::selectLods(
+				modelData,
+				matrices.view, matrices.perspective,
+				static_cast<float>(swapchainExtent.height)
+			);
+		}
+
+		// hierarchical (BVH) primitive culling, then per cluster culling of the visible ones (meshlet culling pass)
+		const auto frustum = vk::Model::getFrustum(matrices.view, matrices.perspective);
+		auto &visibleRefs				= m_deferredScreenData.visibleRefs;
+		auto &hiddenRefs				= m_deferredScreenData.hiddenRefs;
+		auto &occludedRefs			= m_deferredScreenData.occludedRefs;
+		auto &occlusionCuller		= m_screenData.occlusionCuller;
+
+		for(auto &modelData : modelsData) { vk::Model::setCullView(modelData, frustum); }
+
+		bvh.cull(frustum, visibleRefs, hiddenRefs);
+
+		// baked PVS of the camera's cell (a bit test per ref), then software occlusion culling of the rest
+		occludedRefs.clear();
+
+		auto pvsCells = std::vector<uint32_t>(modelsData.size());
+
+		for(auto m = 0u; m < modelsData.size(); ++m) { pvsCells[m] = modelsData[m].pvs.getCell(frustum.eye); }
+
+		const auto it = std::stable_partition(visibleRefs.begin(), visibleRefs.end(), [&](uint32_t _ref)
+		{
+			const auto &ref = bvh.getRef(_ref);
+
+			return modelsData[ref.modelIndex].pvs.isVisible(pvsCells[ref.modelIndex], ref.pvsIndex);
+		});
+		const auto pvsCulledCount = std::distance(it, visibleRefs.end());
+
+		occludedRefs.assign(it, visibleRefs.end());
+		visibleRefs.erase(it, visibleRefs.end());
+
+		occlusionCuller.render(matrices.perspective * matrices.view);
+		occlusionCuller.cull(bvh, visibleRefs, occludedRefs);
+
+		for(auto &modelData : modelsData) { vk::Model::resetInstances(modelData); }
+
+		for(const auto &[refs, isVisible] : {
+			std::make_pair(&hiddenRefs, false), std::make_pair(&occludedRefs, false), std::make_pair(&visibleRefs, true)
+		})
+		{
+			for(const auto r : *refs)
+			{
+				const auto &ref = bvh.getRef(r);
+				auto &modelData = modelsData[ref.modelIndex];
+
+				// instanced: a member is drawn if any of its primitives is visible
+				if(ref.node->instanceGroup > -1)
+				{
+					if(isVisible) { vk::Model::setInstanceVisible(modelData, *ref.node); }
+					continue;
+				}
+
+				vk::Model::cullPrimitive(
+					modelData, ref.worldMtx,
+					ref.node->mesh.primitives[ref.primitiveIndex],
+					frustum, isVisible
+				);
+			}
+		}
+
+		for(auto &modelData : modelsData) { vk::Model::cullInstances(modelData); }
+
+		if(m_screenData.isCullingStats)
+		{
+			const auto &occlusionStats = occlusionCuller.getStats();
+
+			TRACE_LOG("BVH culling: %zu/%zu primitives visible", visibleRefs.size(), bvh.getRefCount());
+			TRACE_LOG("PVS culling: %td primitives culled", pvsCulledCount);
+			TRACE_LOG(
+				"Occlusion culling: %u/%u primitives occluded (%u occluder triangles, raster %.3f ms, test %.3f ms)",
+				occlusionStats.culledCount, occlusionStats.testedCount, occlusionStats.occluderTriangleCount,
+				occlusionStats.rasterTime, occlusionStats.testTime
+			);
+		}
+
+		// primitives drawn directly (no meshlets) ONLY change with re-recording
+		if(isChanged)
+		{
+			if(DeferredScreenData::isSubpassLayout())	{ recordSubpassCommands(); }
+			else																			{ recordOffscreenCommands(); }
+		}
+	}
+
 	void Deferred::onWindowResize() noexcept
 	{
 		updateOffscreenUBO();
+		updateCompositionUBO();
+	}
+
+	// screen targets at the new swapchain extent, before Base re-records the swapchain command buffers: g-buffer
+	// attachments, frame graph & render pass (same formats: the pipelines stay compatible), tile lists, framebuffer, then
+	// the composition set & offscreen commands referencing them (subpasses: the swapchain framebuffers, in
+	// setupBaseCommands); the tile count reaches the UBO in onWindowResize
+	void Deferred::onSwapchainRecreate() noexcept
+	{
+		destroyScreenTargets();
+
+		setupRenderPass();
+		setupTiles();
+		setupFramebuffer();
+		updateCompositionDescriptors();
+
+		if(!DeferredScreenData::isSubpassLayout()) { recordOffscreenCommands(); }
+	}
+
+	void Deferred::destroyScreenTargets() noexcept
+	{
+		const auto &logicalDevice = m_device->getData().logicalDevice;
+
+		auto &fbData = getFbData(m_deferredScreenData);
+
+		vk::Attachment	::destroy(logicalDevice, fbData.attachments);
+		vk::Image				::destroyImageView(logicalDevice, m_deferredScreenData.depthView);
+		vk::RenderPass	::destroy(logicalDevice, fbData.renderPass);
+		vk::Framebuffer	::destroy(logicalDevice, fbData.framebuffer);
+		vk::FrameGraph	::destroy(logicalDevice, m_deferredScreenData.frameGraph);
+		vk::Buffer			::destroy(logicalDevice, m_deferredScreenData.tileBuffer);
+		vk::Device			::freeMemory(logicalDevice, m_deferredScreenData.tileMemory);
+
+		fbData.attachments	= {};
+		fbData.framebuffer	= VK_NULL_HANDLE;
+		fbData.renderPass		= VK_NULL_HANDLE;
+
+		m_deferredScreenData.depthView		= VK_NULL_HANDLE;
+		m_deferredScreenData.tileBuffer		= VK_NULL_HANDLE;
+		m_deferredScreenData.tileMemory		= VK_NULL_HANDLE;
+		m_deferredScreenData.litResource	= vk::FrameGraph::s_invalidResource;
 	}
 }
\ No newline at end of file
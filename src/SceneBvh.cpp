@@ -0,0 +1,421 @@
+#include "SceneBvh.h"
+
+static glm::mat4 getWorldMatrix(const vk::Model::Node *_node) noexcept
+{
+	auto worldMtx = _node->matrix;
+
+	for(auto parent = _node->parent; parent; parent = parent->parent)
+	{
+		worldMtx = parent->matrix * worldMtx;
+	}
+
+	return worldMtx;
+}
+
+void SceneBvh::build(const vk::Vector<Model::Data> &_modelsData) noexcept
+{
+	TIMER(start);
+
+	m_refs.clear();
+	m_nodes.clear();
+
+	auto modelIndex = 0u;
+
+	for(const auto &modelData : _modelsData)
+	{
+		auto pvsIndex = 0u;
+
+		Model::forEachNode(modelData.nodes, [&](const Model::NodePtr &_node)
+		{
+			const auto &primitives = _node->mesh.primitives;
+
+			for(auto p = 0u; p < primitives.size(); ++p, ++pvsIndex)
+			{
+				if(primitives[p].idxCount == 0) { continue; }
+
+				Ref ref;
+				ref.modelIndex			= modelIndex;
+				ref.node						= _node.get();
+				ref.primitiveIndex	= p;
+				ref.pvsIndex				= pvsIndex;
+
+				m_refs.push_back(ref);
+			}
+		});
+
+		modelIndex++;
+	}
+
+	const auto refCount = static_cast<uint32_t>(m_refs.size());
+
+	for(auto r = 0u; r < refCount; ++r) { updateRef(r); }
+
+	if(refCount > 0)
+	{
+		std::vector<BuildNode> binaryNodes;
+		binaryNodes.reserve(2 * refCount);
+
+		const auto root = buildBinary(binaryNodes, 0, refCount);
+
+		m_nodes.reserve(binaryNodes.size() / 2 + 1);
+		collapse(binaryNodes, root);
+	}
+
+	// everything is drawn until the first cull
+	m_visibleStamps.assign(refCount, m_frame);
+	m_prevVisible.resize(refCount);
+	std::iota(m_prevVisible.begin(), m_prevVisible.end(), 0u);
+
+	TIMER(end);
+
+	INFO_LOG(
+		"Scene BVH: %u primitives, %zu nodes (4-wide) in %.2f ms",
+		refCount, m_nodes.size(), TIME_DIFF(start, end)
+	);
+}
+
+int32_t SceneBvh::buildBinary(
+	std::vector<BuildNode>	&_nodes,
+	uint32_t								_first,
+	uint32_t								_count
+) noexcept
+{
+	const auto getCentroid = [](const Ref &_ref) { return (_ref.bounds.min + _ref.bounds.max) * 0.5f; };
+
+	BuildNode node;
+	Aabb centroidBounds;
+
+	for(auto r = _first; r < _first + _count; ++r)
+	{
+		node.bounds.grow(m_refs[r].bounds);
+		centroidBounds.grow(getCentroid(m_refs[r]));
+	}
+
+	const auto index = static_cast<int32_t>(_nodes.size());
+	_nodes.push_back(node);
+
+	if(_count <= s_maxLeafSize)
+	{
+		_nodes[index].first = _first;
+		_nodes[index].count = _count;
+
+		return index;
+	}
+
+	// binned SAH (Wald, "On fast Construction of SAH-based Bounding Volume Hierarchies", 2007)
+	struct Bin
+	{
+		Aabb			bounds;
+		uint32_t	count = 0;
+	};
+
+	auto bestCost		= std::numeric_limits<float>::max();
+	auto bestAxis		= -1;
+	auto bestSplit	= 0u;
+
+	const auto getBin = [&](const Ref &_ref, int _axis)
+	{
+		const auto extent = centroidBounds.max[_axis] - centroidBounds.min[_axis];
+		const auto bin = static_cast<uint32_t>((getCentroid(_ref)[_axis] - centroidBounds.min[_axis]) / extent * s_binCount);
+
+		return std::min(bin, s_binCount - 1);
+	};
+
+	for(auto axis = 0; axis < 3; ++axis)
+	{
+		if(centroidBounds.max[axis] - centroidBounds.min[axis] <= 0.0f) { continue; }
+
+		Bin bins[s_binCount];
+
+		for(auto r = _first; r < _first + _count; ++r)
+		{
+			auto &bin = bins[getBin(m_refs[r], axis)];
+
+			bin.bounds.grow(m_refs[r].bounds);
+			bin.count++;
+		}
+
+		// right to left sweep, then left to right evaluating each split plane
+		float			rightAreas	[s_binCount];
+		uint32_t	rightCounts	[s_binCount];
+		Aabb			rightBounds;
+		uint32_t	rightCount = 0;
+
+		for(auto b = s_binCount - 1; b > 0; --b)
+		{
+			rightBounds.grow(bins[b].bounds);
+			rightCount += bins[b].count;
+
+			rightAreas	[b] = rightBounds.getArea();
+			rightCounts	[b] = rightCount;
+		}
+
+		Aabb			leftBounds;
+		uint32_t	leftCount = 0;
+
+		for(auto split = 1u; split < s_binCount; ++split)
+		{
+			leftBounds.grow(bins[split - 1].bounds);
+			leftCount += bins[split - 1].count;
+
+			if(leftCount == 0 || rightCounts[split] == 0) { continue; }
+
+			const auto cost = leftBounds.getArea() * leftCount + rightAreas[split] * rightCounts[split];
+
+			if(cost < bestCost)
+			{
+				bestCost	= cost;
+				bestAxis	= axis;
+				bestSplit	= split;
+			}
+		}
+	}
+
+	auto mid = _first + _count / 2;
+
+	if(bestAxis > -1)
+	{
+		const auto it = std::partition(
+			m_refs.begin() + _first, m_refs.begin() + _first + _count,
+			[&](const Ref &_ref) { return getBin(_ref, bestAxis) < bestSplit; }
+		);
+
+		mid = static_cast<uint32_t>(it - m_refs.begin());
+	}
+
+	// coincident centroids: median split
+	if(mid == _first || mid == _first + _count) { mid = _first + _count / 2; }
+
+	const auto left		= buildBinary(_nodes, _first, mid - _first);
+	const auto right	= buildBinary(_nodes, mid, _first + _count - mid);
+
+	_nodes[index].left	= left;
+	_nodes[index].right	= right;
+
+	return index;
+}
+
+// binary -> 4-wide: repeatedly opens the largest (by area) inner child until 4 children are gathered
+int32_t SceneBvh::collapse(
+	const std::vector<BuildNode>	&_nodes,
+	int32_t												_binaryNode
+) noexcept
+{
+	const auto index = static_cast<int32_t>(m_nodes.size());
+
+	m_nodes.emplace_back();
+
+	std::vector<int32_t> children;
+	const auto &binaryNode = _nodes[_binaryNode];
+
+	if(binaryNode.isLeaf())	{ children = { _binaryNode }; }
+	else										{ children = { binaryNode.left, binaryNode.right }; }
+
+	while(children.size() < 4)
+	{
+		auto largest = -1;
+		auto largestArea = -1.0f;
+
+		for(auto c = 0u; c < children.size(); ++c)
+		{
+			const auto &child = _nodes[children[c]];
+
+			if(!child.isLeaf() && child.bounds.getArea() > largestArea)
+			{
+				largest			= static_cast<int32_t>(c);
+				largestArea	= child.bounds.getArea();
+			}
+		}
+
+		if(largest < 0) { break; }
+
+		const auto &opened = _nodes[children[largest]];
+
+		children[largest] = opened.left;
+		children.push_back(opened.right);
+	}
+
+	for(auto s = 0u; s < 4; ++s)
+	{
+		auto &node = m_nodes[index];
+
+		node.children	[s] = s_leaf;
+		node.firstRef	[s] = 0;
+		node.refCount	[s] = 0;
+
+		if(s >= children.size())
+		{
+			setSlotBounds(node, s, Aabb());
+			continue;
+		}
+
+		const auto &child = _nodes[children[s]];
+
+		setSlotBounds(node, s, child.bounds);
+
+		if(child.isLeaf())
+		{
+			node.firstRef[s] = child.first;
+			node.refCount[s] = child.count;
+		}
+		else
+		{
+			// m_nodes grows: no references held across the recursion
+			const auto childIndex = collapse(_nodes, children[s]);
+
+			m_nodes[index].children[s] = childIndex;
+		}
+	}
+
+	return index;
+}
+
+uint32_t SceneBvh::testNode(
+	const Node4		&_node,
+	const Frustum	&_frustum,
+	uint32_t			&_insideMask
+) noexcept
+{
+	// per plane: p-vertex (farthest along the normal) behind => outside, n-vertex behind => intersecting
+	uint32_t outsideMask = 0, intersectMask = 0;
+
+#ifdef USE_SSE
+	const auto minX = _mm_load_ps(_node.minX), minY = _mm_load_ps(_node.minY), minZ = _mm_load_ps(_node.minZ);
+	const auto maxX = _mm_load_ps(_node.maxX), maxY = _mm_load_ps(_node.maxY), maxZ = _mm_load_ps(_node.maxZ);
+	const auto zero = _mm_setzero_ps();
+
+	for(const auto &plane : _frustum.planes)
+	{
+		const auto nx = _mm_set1_ps(plane.x), ny = _mm_set1_ps(plane.y), nz = _mm_set1_ps(plane.z), w = _mm_set1_ps(plane.w);
+
+		const auto px = plane.x > 0.0f ? maxX : minX, nvx = plane.x > 0.0f ? minX : maxX;
+		const auto py = plane.y > 0.0f ? maxY : minY, nvy = plane.y > 0.0f ? minY : maxY;
+		const auto pz = plane.z > 0.0f ? maxZ : minZ, nvz = plane.z > 0.0f ? minZ : maxZ;
+
+		const auto pDist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, px),	_mm_mul_ps(ny, py)),	_mm_add_ps(_mm_mul_ps(nz, pz),	w));
+		const auto nDist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nvx),	_mm_mul_ps(ny, nvy)),	_mm_add_ps(_mm_mul_ps(nz, nvz),	w));
+
+		outsideMask		|= static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(pDist, zero)));
+		intersectMask	|= static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(nDist, zero)));
+	}
+#else
+	for(const auto &plane : _frustum.planes)
+	{
+		for(auto c = 0u; c < 4; ++c)
+		{
+			const auto pDist =
+				plane.x * (plane.x > 0.0f ? _node.maxX[c] : _node.minX[c]) +
+				plane.y * (plane.y > 0.0f ? _node.maxY[c] : _node.minY[c]) +
+				plane.z * (plane.z > 0.0f ? _node.maxZ[c] : _node.minZ[c]) + plane.w;
+			const auto nDist =
+				plane.x * (plane.x > 0.0f ? _node.minX[c] : _node.maxX[c]) +
+				plane.y * (plane.y > 0.0f ? _node.minY[c] : _node.maxY[c]) +
+				plane.z * (plane.z > 0.0f ? _node.minZ[c] : _node.maxZ[c]) + plane.w;
+
+			outsideMask		|= (pDist < 0.0f ? 1u : 0u) << c;
+			intersectMask	|= (nDist < 0.0f ? 1u : 0u) << c;
+		}
+	}
+#endif
+
+	const auto visibleMask = ~outsideMask & 0xFu;
+
+	_insideMask = visibleMask & ~intersectMask;
+
+	return visibleMask;
+}
+
+void SceneBvh::cull(
+	const Frustum					&_frustum,
+	std::vector<uint32_t>	&_visible,
+	std::vector<uint32_t>	&_hidden
+) noexcept
+{
+	_visible.clear();
+	_hidden.clear();
+
+	if(m_nodes.empty()) { return; }
+
+	m_frame++;
+
+	std::vector<uint32_t> stack = { 0 };
+
+	while(!stack.empty())
+	{
+		const auto &node = m_nodes[stack.back()];
+		stack.pop_back();
+
+		uint32_t insideMask;
+		const auto visibleMask = testNode(node, _frustum, insideMask);
+
+		for(auto s = 0u; s < 4; ++s)
+		{
+			if(!(visibleMask & (1u << s))) { continue; }
+
+			if(node.children[s] == s_leaf)
+			{
+				for(auto r = node.firstRef[s]; r < node.firstRef[s] + node.refCount[s]; ++r) { _visible.push_back(r); }
+			}
+			else if(insideMask & (1u << s))
+			{
+				collectRefs(node.children[s], _visible);
+			}
+			else
+			{
+				stack.push_back(node.children[s]);
+			}
+		}
+	}
+
+	for(const auto ref : _visible) { m_visibleStamps[ref] = m_frame; }
+
+	for(const auto ref : m_prevVisible)
+	{
+		if(m_visibleStamps[ref] != m_frame) { _hidden.push_back(ref); }
+	}
+
+	m_prevVisible = _visible;
+}
+
+void SceneBvh::collectRefs(uint32_t _node, std::vector<uint32_t> &_refs) const noexcept
+{
+	const auto &node = m_nodes[_node];
+
+	for(auto s = 0u; s < 4; ++s)
+	{
+		if(node.children[s] != s_leaf)
+		{
+			collectRefs(node.children[s], _refs);
+			continue;
+		}
+
+		for(auto r = node.firstRef[s]; r < node.firstRef[s] + node.refCount[s]; ++r) { _refs.push_back(r); }
+	}
+}
+
+void SceneBvh::updateRef(uint32_t _ref) noexcept
+{
+	auto &ref = m_refs[_ref];
+	const auto &primitive = ref.node->mesh.primitives[ref.primitiveIndex];
+
+	ref.worldMtx = getWorldMatrix(ref.node);
+
+	// box transform (Arvo): center & abs(rotation/scale) * extent
+	const auto center = glm::vec3(ref.worldMtx * glm::vec4(primitive.center, 1.0f));
+	auto extent = glm::vec3(0.0f);
+
+	for(auto c = 0; c < 3; ++c)
+	{
+		extent += glm::abs(glm::vec3(ref.worldMtx[c])) * primitive.extent[c];
+	}
+
+	ref.bounds.min = center - extent;
+	ref.bounds.max = center + extent;
+}
+
+void SceneBvh::setSlotBounds(Node4 &_node, uint32_t _slot, const Aabb &_bounds) noexcept
+{
+	_node.minX[_slot] = _bounds.min.x;	_node.maxX[_slot] = _bounds.max.x;
+	_node.minY[_slot] = _bounds.min.y;	_node.maxY[_slot] = _bounds.max.y;
+	_node.minZ[_slot] = _bounds.min.z;	_node.maxZ[_slot] = _bounds.max.z;
+}
@@ -0,0 +1,497 @@
+#include "SceneCache.h"
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+	// mmap fallback: plain file read
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+bool SceneCache::load(
+	const std::string					&_fileName,
+	float											_scale,
+	vk::Model::Data						&_modelData,
+	std::vector<std::string>	&_textureUris
+) noexcept
+{
+	using AlphaMode = Material::AlphaMode;
+
+	TIMER(start);
+
+	const auto cacheFileName = getCacheFileName(_fileName);
+	Mapping mapping;
+
+	if(!map(cacheFileName, mapping)) { return false; }
+
+	if(!validate(_fileName, _scale, mapping)) { return false; }
+
+	const auto data = static_cast<const char*>(mapping.data.get());
+	const auto &sections = reinterpret_cast<const Header*>(data)->sections;
+
+	readStrings(data, sections[vk::toInt(Section::TEXTURES)], _textureUris);
+
+	// Materials
+
+	const auto &matSection	= sections[vk::toInt(Section::MATERIALS)];
+	const auto matRecords		= getSection<MaterialRecord>(data, matSection);
+	auto &materials					= _modelData.materials;
+
+	materials.resize(matSection.count);
+
+	for(auto m = 0u; m < matSection.count; ++m)
+	{
+		const auto &record	= matRecords[m];
+		auto &material			= materials[m];
+
+		material.alphaMode		= Material::alphaModes[std::min<uint16_t>(record.alphaMode, vk::toInt(AlphaMode::BLEND_))];
+		material.alphaCutoff	= record.alphaCutoff;
+		material.doubleSided	= record.doubleSided != 0;
+
+		for(auto t = 0u; t < Material::descCount; ++t)
+		{ material.textureIndices[t] = record.textureIndices[t]; }
+
+		for(auto t = 0u; t < vk::toInt(Material::TexCoordSet::_count_); ++t)
+		{ material.texCoordSets[t] = record.texCoordSets[t]; }
+
+		for(auto f = 0u; f < vk::toInt(Material::FactorParam::_count_); ++f)
+		{ material.factors[f] = record.factors[f]; }
+
+		for(auto f = 0u; f < vk::toInt(Material::ColorFactorParam::_count_); ++f)
+		{ material.colorFactors[f] = record.colorFactors[f]; }
+	}
+
+	// Nodes & Primitives
+
+	const auto &nodeSection	= sections[vk::toInt(Section::NODES)];
+	const auto nodeRecords	= getSection<NodeRecord>(data, nodeSection);
+	const auto primitives		= getSection<PrimitiveRecord>(data, sections[vk::toInt(Section::PRIMITIVES)]);
+
+	std::vector<NodePtr> nodes(nodeSection.count);
+
+	for(auto n = 0u; n < nodeSection.count; ++n)
+	{
+		const auto &record = nodeRecords[n];
+		auto &node = nodes[n] = std::make_shared<Node>();
+
+		node->matrix		= record.matrix;
+		node->skinIndex	= record.skinIndex;
+		node->index			= n;
+		node->mesh.primitives.resize(record.primitiveCount);
+
+		for(auto p = 0u; p < record.primitiveCount; ++p)
+		{
+			const auto &primitiveRecord	= primitives[record.firstPrimitive + p];
+			auto &primitive							= node->mesh.primitives[p];
+
+			primitive.indexParams.firstIndex	= primitiveRecord.firstIndex;
+			primitive.indexParams.vtxOffset		= primitiveRecord.vtxOffset;
+			primitive.firstVertex							= primitiveRecord.firstVertex;
+			primitive.idxCount								= primitiveRecord.idxCount;
+			primitive.vtxCount								= primitiveRecord.vtxCount;
+			primitive.matIndex								= primitiveRecord.matIndex;
+			primitive.firstMeshlet						= primitiveRecord.firstMeshlet;
+			primitive.meshletCount						= primitiveRecord.meshletCount;
+			primitive.lodCount								= static_cast<uint16_t>(primitiveRecord.lodCount);
+			primitive.center									= primitiveRecord.center;
+			primitive.radius									= primitiveRecord.radius;
+			primitive.extent									= primitiveRecord.extent;
+
+			for(auto l = 0u; l < primitive.lods.size(); ++l) { primitive.lods[l] = primitiveRecord.lods[l]; }
+		}
+
+		if(record.parent > -1)
+		{
+			node->parent = nodes[record.parent];
+			node->parent->children.push_back(node);
+		}
+		else
+		{
+			_modelData.nodes.push_back(node);
+		}
+	}
+
+	// Meshlets
+
+	const auto &meshletSection	= sections[vk::toInt(Section::MESHLETS)];
+	const auto meshlets					= getSection<Meshlet>(data, meshletSection);
+
+	_modelData.meshlets.assign(meshlets, meshlets + meshletSection.count);
+
+	// PVS
+
+	const auto &pvsGridSection	= sections[vk::toInt(Section::PVS_GRID)];
+	const auto &pvsBitsSection	= sections[vk::toInt(Section::PVS_BITS)];
+	const auto pvsBits					= getSection<uint32_t>(data, pvsBitsSection);
+
+	if(pvsGridSection.count == 1)
+	{
+		_modelData.pvs.grid = *getSection<PvsGrid>(data, pvsGridSection);
+		_modelData.pvs.bits.assign(pvsBits, pvsBits + pvsBitsSection.count);
+	}
+
+	// Geometry (uploaded straight from the mapping)
+
+	const auto &vtxSection = sections[vk::toInt(Section::VERTICES)];
+	const auto &idxSection = sections[vk::toInt(Section::INDICES)];
+
+	_modelData.cacheView = {
+		getSection<Vertex>	(data, vtxSection),
+		getSection<uint32_t>(data, idxSection),
+		vtxSection.count,
+		idxSection.count
+	};
+	_modelData.cacheMapping = mapping.data;
+
+	TIMER(end);
+
+	INFO_LOG(
+		"Scene cache hit: %s (%llu vertices, %llu indices) in %.2f ms",
+		cacheFileName.c_str(),
+		static_cast<unsigned long long>(vtxSection.count),
+		static_cast<unsigned long long>(idxSection.count),
+		TIME_DIFF(start, end)
+	);
+
+	return true;
+}
+
+bool SceneCache::isValid(const std::string &_fileName, float _scale) noexcept
+{
+	Mapping mapping;
+
+	return map(getCacheFileName(_fileName), mapping) && validate(_fileName, _scale, mapping);
+}
+
+bool SceneCache::validate(
+	const std::string	&_fileName,
+	float							_scale,
+	const Mapping			&_mapping
+) noexcept
+{
+	const auto cacheFileName = getCacheFileName(_fileName);
+	const auto data = static_cast<const char*>(_mapping.data.get());
+
+	if(_mapping.size < sizeof(Header)) { return false; }
+
+	const auto &header = *reinterpret_cast<const Header*>(data);
+
+	if(
+		header.magic				!= s_magic		||
+		header.version			!= s_version	||
+		header.sectionCount	!= vk::toInt(Section::_count_)	||
+		header.scale				!= _scale
+	)
+	{
+		WARN_LOG("Scene cache %s is stale (version/scale mismatch), rebuilding...", cacheFileName.c_str());
+		return false;
+	}
+
+	for(const auto &section : header.sections)
+	{
+		if(section.offset + section.size > _mapping.size)
+		{
+			WARN_LOG("Scene cache %s is truncated, rebuilding...", cacheFileName.c_str());
+			return false;
+		}
+	}
+
+	std::vector<std::string> dependencies;
+
+	readStrings(data, header.sections[vk::toInt(Section::DEPENDENCIES)], dependencies);
+
+	if(hashSources(_fileName, dependencies) != header.sourceHash)
+	{
+		INFO_LOG("Scene cache %s is out of date, rebuilding...", cacheFileName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+void SceneCache::save(
+	const std::string								&_fileName,
+	float														_scale,
+	const std::vector<std::string>	&_dependencies,
+	const std::vector<std::string>	&_textureUris,
+	const vk::Model::Data						&_modelData
+) noexcept
+{
+	const auto cacheFileName	= getCacheFileName(_fileName);
+	const auto tempFileName		= cacheFileName + ".tmp";
+	const auto &materials			= _modelData.materials;
+	const auto &meshlets			= _modelData.meshlets;
+	const auto &pvs						= _modelData.pvs;
+	const uint64_t pvsGridCount	= pvs.bits.empty() ? 0 : 1;
+	const auto view						= _modelData.getView();
+
+	Header header;
+	std::vector<char>						depBlob, texBlob;
+	std::vector<MaterialRecord>	matRecords(materials.size());
+	std::vector<NodeRecord>			nodeRecords;
+	std::vector<PrimitiveRecord>	primitives;
+
+	header.sourceHash	= hashSources(_fileName, _dependencies);
+	header.scale			= _scale;
+
+	writeStrings(_dependencies, depBlob);
+	writeStrings(_textureUris, texBlob);
+
+	for(auto m = 0u; m < materials.size(); ++m)
+	{
+		const auto &material	= materials[m];
+		auto &record					= matRecords[m];
+		const auto &modes			= Material::alphaModes;
+
+		record.alphaMode		= static_cast<uint16_t>(
+			std::distance(modes.begin(), std::find(modes.begin(), modes.end(), material.alphaMode))
+		);
+		record.doubleSided	= material.doubleSided;
+		record.alphaCutoff	= material.alphaCutoff;
+
+		for(auto t = 0u; t < Material::descCount; ++t)
+		{ record.textureIndices[t] = material.textureIndices[t]; }
+
+		for(auto t = 0u; t < vk::toInt(Material::TexCoordSet::_count_); ++t)
+		{ record.texCoordSets[t] = material.texCoordSets[t]; }
+
+		for(auto f = 0u; f < vk::toInt(Material::FactorParam::_count_); ++f)
+		{ record.factors[f] = material.factors[f]; }
+
+		for(auto f = 0u; f < vk::toInt(Material::ColorFactorParam::_count_); ++f)
+		{ record.colorFactors[f] = material.colorFactors[f]; }
+	}
+
+	for(const auto &node : _modelData.nodes)
+	{
+		flattenNode(node, -1, nodeRecords, primitives);
+	}
+
+	using BlobEntry = std::pair<const void*, SectionInfo>;
+
+	const vk::Array<BlobEntry, vk::toInt(Section::_count_)> blobs = {
+		BlobEntry{ depBlob.data(),			{ 0, depBlob.size(),															_dependencies.size() } },
+		BlobEntry{ texBlob.data(),			{ 0, texBlob.size(),															_textureUris.size() } },
+		BlobEntry{ matRecords.data(),		{ 0, matRecords.size()	* sizeof(MaterialRecord),	matRecords.size() } },
+		BlobEntry{ nodeRecords.data(),	{ 0, nodeRecords.size()	* sizeof(NodeRecord),			nodeRecords.size() } },
+		BlobEntry{ primitives.data(),		{ 0, primitives.size()	* sizeof(PrimitiveRecord),	primitives.size() } },
+		BlobEntry{ view.vertices,				{ 0, view.vtxCount			* sizeof(Vertex),					view.vtxCount } },
+		BlobEntry{ view.indices,				{ 0, view.idxCount			* sizeof(uint32_t),				view.idxCount } },
+		BlobEntry{ meshlets.data(),			{ 0, meshlets.size()		* sizeof(Meshlet),				meshlets.size() } },
+		BlobEntry{ &pvs.grid,						{ 0, pvsGridCount				* sizeof(PvsGrid),				pvsGridCount } },
+		BlobEntry{ pvs.bits.data(),			{ 0, pvs.bits.size()		* sizeof(uint32_t),				pvs.bits.size() } }
+	};
+
+	// sections are 16-byte aligned so they can be used in place once mapped
+	const auto align = [](uint64_t _offset) { return (_offset + 15) & ~uint64_t(15); };
+	auto offset = align(sizeof(Header));
+
+	for(auto s = 0u; s < vk::toInt(Section::_count_); ++s)
+	{
+		header.sections[s]				= blobs[s].second;
+		header.sections[s].offset	= offset;
+
+		offset = align(offset + header.sections[s].size);
+	}
+
+	std::ofstream file(tempFileName, std::ios::binary | std::ios::trunc);
+
+	if(!file.is_open())
+	{
+		WARN_LOG("Failed to write scene cache %s", cacheFileName.c_str());
+		return;
+	}
+
+	const char padding[16] = {};
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	for(auto s = 0u; s < vk::toInt(Section::_count_); ++s)
+	{
+		const auto &section = header.sections[s];
+
+		file.write(padding, static_cast<std::streamsize>(section.offset - static_cast<uint64_t>(file.tellp())));
+		file.write(static_cast<const char*>(blobs[s].first), static_cast<std::streamsize>(section.size));
+	}
+
+	file.close();
+
+	// write-then-rename, so a crashed/partial write never shows up as a valid cache
+	std::remove(cacheFileName.c_str());
+
+	if(file.fail() || std::rename(tempFileName.c_str(), cacheFileName.c_str()) != 0)
+	{
+		WARN_LOG("Failed to write scene cache %s", cacheFileName.c_str());
+		std::remove(tempFileName.c_str());
+		return;
+	}
+
+	INFO_LOG("Scene cache written: %s (%llu bytes)", cacheFileName.c_str(), static_cast<unsigned long long>(offset));
+}
+
+uint64_t SceneCache::hashSources(
+	const std::string								&_fileName,
+	const std::vector<std::string>	&_dependencies
+) noexcept
+{
+	const auto baseDir = _fileName.substr(0, _fileName.find_last_of("/\\") + 1);
+
+	std::vector<char> data;
+	uint64_t hash = fnv1a(nullptr, 0);
+
+	if(readFile(_fileName, data))
+	{ hash = fnv1a(data.data(), data.size(), hash); }
+
+	for(const auto &dependency : _dependencies)
+	{
+		if(readFile(baseDir + dependency, data))
+		{ hash = fnv1a(data.data(), data.size(), hash); }
+
+		// dependency names are part of the key as well (renames invalidate)
+		hash = fnv1a(dependency.data(), dependency.size(), hash);
+	}
+
+	return hash;
+}
+
+bool SceneCache::map(const std::string &_fileName, Mapping &_mapping) noexcept
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+	std::vector<char> data;
+
+	if(!readFile(_fileName, data)) { return false; }
+
+	auto buffer = std::shared_ptr<char>(new char[data.size()], std::default_delete<char[]>());
+	memcpy(buffer.get(), data.data(), data.size());
+
+	_mapping.data = buffer;
+	_mapping.size = data.size();
+#else
+	const auto fd = open(_fileName.c_str(), O_RDONLY);
+
+	if(fd < 0) { return false; }
+
+	struct stat fileStat = {};
+
+	if(fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	const auto size = static_cast<size_t>(fileStat.st_size);
+	auto ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	close(fd);
+
+	if(ptr == MAP_FAILED) { return false; }
+
+	_mapping.data = std::shared_ptr<void>(ptr, [size](void *_ptr) { munmap(_ptr, size); });
+	_mapping.size = size;
+#endif
+
+	return true;
+}
+
+bool SceneCache::readFile(const std::string &_fileName, std::vector<char> &_data) noexcept
+{
+	std::ifstream file(_fileName, std::ios::binary | std::ios::ate);
+
+	if(!file.is_open()) { return false; }
+
+	const auto size = static_cast<size_t>(file.tellg());
+
+	_data.resize(size);
+
+	file.seekg(0);
+	file.read(_data.data(), static_cast<std::streamsize>(size));
+
+	return !file.fail();
+}
+
+void SceneCache::flattenNode(
+	const NodePtr						&_node,
+	int32_t									_parent,
+	std::vector<NodeRecord>				&_nodes,
+	std::vector<PrimitiveRecord>	&_primitives
+) noexcept
+{
+	const auto &nodePrimitives	= _node->mesh.primitives;
+	const auto nodeIndex				= static_cast<int32_t>(_nodes.size());
+
+	NodeRecord record;
+	record.parent					= _parent;
+	record.firstPrimitive	= static_cast<uint32_t>(_primitives.size());
+	record.primitiveCount	= static_cast<uint32_t>(nodePrimitives.size());
+	record.skinIndex			= _node->skinIndex;
+	record.matrix					= _node->matrix;
+
+	_nodes.push_back(record);
+
+	for(const auto &primitive : nodePrimitives)
+	{
+		PrimitiveRecord primitiveRecord;
+		primitiveRecord.firstIndex		= primitive.indexParams.firstIndex;
+		primitiveRecord.vtxOffset			= primitive.indexParams.vtxOffset;
+		primitiveRecord.firstVertex		= primitive.firstVertex;
+		primitiveRecord.idxCount			= primitive.idxCount;
+		primitiveRecord.vtxCount			= primitive.vtxCount;
+		primitiveRecord.matIndex			= primitive.matIndex;
+		primitiveRecord.firstMeshlet	= primitive.firstMeshlet;
+		primitiveRecord.meshletCount	= primitive.meshletCount;
+		primitiveRecord.lodCount			= primitive.lodCount;
+		primitiveRecord.center				= primitive.center;
+		primitiveRecord.radius				= primitive.radius;
+		primitiveRecord.extent				= primitive.extent;
+
+		for(auto l = 0u; l < primitive.lods.size(); ++l) { primitiveRecord.lods[l] = primitive.lods[l]; }
+
+		_primitives.push_back(primitiveRecord);
+	}
+
+	for(const auto &child : _node->children)
+	{
+		flattenNode(child, nodeIndex, _nodes, _primitives);
+	}
+}
+
+void SceneCache::readStrings(
+	const char								*_data,
+	const SectionInfo					&_section,
+	std::vector<std::string>	&_strings
+) noexcept
+{
+	auto ptr = _data + _section.offset;
+	const auto end = ptr + _section.size;
+
+	_strings.clear();
+	_strings.reserve(_section.count);
+
+	for(auto s = 0u; s < _section.count && ptr + sizeof(uint32_t) <= end; ++s)
+	{
+		uint32_t length;
+		memcpy(&length, ptr, sizeof(length));
+		ptr += sizeof(length);
+
+		if(ptr + length > end) { break; }
+
+		_strings.emplace_back(ptr, length);
+		ptr += length;
+	}
+}
+
+void SceneCache::writeStrings(
+	const std::vector<std::string>	&_strings,
+	std::vector<char>								&_blob
+) noexcept
+{
+	for(const auto &string : _strings)
+	{
+		const auto length = static_cast<uint32_t>(string.size());
+		const auto lengthBytes = reinterpret_cast<const char*>(&length);
+
+		_blob.insert(_blob.end(), lengthBytes, lengthBytes + sizeof(length));
+		_blob.insert(_blob.end(), string.begin(), string.end());
+	}
+}
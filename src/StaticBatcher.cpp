@@ -0,0 +1,247 @@
+#include "StaticBatcher.h"
+
+void StaticBatcher::batch(
+	vk::Model::Data							&_data,
+	const std::set<const Node*>	&_excludedNodes
+) noexcept
+{
+	using AlphaMode = vk::Material::AlphaMode;
+
+	TIMER(start);
+
+	auto &vertices	= _data.vertices;
+	auto &indices		= _data.indices;
+
+	const auto srcDrawCount	= getDrawCount(_data);
+	const auto &blendMode		= vk::Material::alphaModes[AlphaMode::BLEND_];
+
+	std::vector<Candidate>	candidates;
+	std::vector<glm::vec3>	centers;
+
+	auto boundsMin = glm::vec3( std::numeric_limits<float>::max());
+	auto boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+
+	vk::Model::forEachNode(_data.nodes, [&](const NodePtr &_node)
+	{
+		if(_node->skinIndex > -1 || _excludedNodes.count(_node.get())) { return; }
+
+		const auto worldMtx		= vk::Model::getNodeMatrix(_node);
+		const auto &primitives	= _node->mesh.primitives;
+
+		for(auto p = 0u; p < primitives.size(); ++p)
+		{
+			const auto &primitive = primitives[p];
+
+			if(
+				primitive.idxCount == 0 || primitive.idxCount > s_maxSrcIdxCount || primitive.idxCount % 3 != 0 ||
+				primitive.vtxCount > s_maxBatchVtxCount
+			) { continue; }
+
+			if(
+				primitive.matIndex > -1 && primitive.matIndex < static_cast<int>(_data.materials.size()) &&
+				_data.materials[primitive.matIndex].alphaMode == blendMode
+			) { continue; }
+
+			auto posMin = glm::vec3( std::numeric_limits<float>::max());
+			auto posMax = glm::vec3(-std::numeric_limits<float>::max());
+
+			for(auto v = primitive.firstVertex; v < primitive.firstVertex + primitive.vtxCount; ++v)
+			{
+				posMin = glm::min(posMin, vertices[v].position);
+				posMax = glm::max(posMax, vertices[v].position);
+			}
+
+			const auto center = glm::vec3(worldMtx * glm::vec4((posMin + posMax) * 0.5f, 1.0f));
+
+			boundsMin = glm::min(boundsMin, center);
+			boundsMax = glm::max(boundsMax, center);
+
+			candidates.push_back({ _node.get(), p, worldMtx, glm::ivec3(0) });
+			centers.push_back(center);
+		}
+	});
+
+	if(candidates.size() < 2) { return; }
+
+	// spatial chunks (over the candidates' centers), so batches are still culled locally
+
+	const auto chunkSize = glm::max(boundsMax - boundsMin, glm::vec3(1e-3f)) / static_cast<float>(s_chunkCount);
+
+	for(auto c = 0u; c < candidates.size(); ++c)
+	{
+		candidates[c].chunk = glm::clamp(
+			glm::ivec3(glm::floor((centers[c] - boundsMin) / chunkSize)),
+			glm::ivec3(0), glm::ivec3(s_chunkCount - 1)
+		);
+	}
+
+	const auto getMatIndex = [](const Candidate &_candidate)
+	{ return _candidate.node->mesh.primitives[_candidate.primitiveIndex].matIndex; };
+
+	const auto getKey = [&](const Candidate &_candidate)
+	{ return std::make_tuple(getMatIndex(_candidate), _candidate.chunk.x, _candidate.chunk.y, _candidate.chunk.z); };
+
+	std::stable_sort(
+		candidates.begin(), candidates.end(),
+		[&](const Candidate &_a, const Candidate &_b) { return getKey(_a) < getKey(_b); }
+	);
+
+	// merge runs of the same material & chunk
+
+	auto batchNode = std::make_shared<Node>();
+
+	batchNode->matrix	= glm::mat4(1.0f);
+	batchNode->index	= vk::Model::s_noNode;
+
+	auto &batches = batchNode->mesh.primitives;
+	auto mergedCount = 0u;
+
+	for(auto r0 = 0u, r1 = 0u; r0 < candidates.size(); r0 = r1)
+	{
+		for(r1 = r0 + 1; r1 < candidates.size() && getKey(candidates[r1]) == getKey(candidates[r0]); ++r1) {}
+
+		if(r1 - r0 < 2) { continue; }
+
+		Primitive batch;
+
+		const auto beginBatch = [&]()
+		{
+			batch = Primitive();
+			batch.firstVertex							= static_cast<uint32_t>(vertices.size());
+			batch.indexParams.firstIndex	= static_cast<uint32_t>(indices.size());
+			batch.matIndex								= getMatIndex(candidates[r0]);
+		};
+
+		beginBatch();
+
+		for(auto c = r0; c < r1; ++c)
+		{
+			const auto &candidate	= candidates[c];
+			auto &primitive				= candidate.node->mesh.primitives[candidate.primitiveIndex];
+
+			if(batch.vtxCount + primitive.vtxCount > s_maxBatchVtxCount)
+			{
+				batches.push_back(batch);
+				beginBatch();
+			}
+
+			const auto &worldMtx	= candidate.worldMtx;
+			const auto normalMtx	= glm::transpose(glm::inverse(glm::mat3(worldMtx)));
+			const auto isMirrored	= glm::determinant(glm::mat3(worldMtx)) < 0.0f;
+			const auto vtxBase		= batch.firstVertex + batch.vtxCount;
+
+			for(auto v = primitive.firstVertex; v < primitive.firstVertex + primitive.vtxCount; ++v)
+			{
+				auto vertex = vertices[v];
+
+				vertex.position	= glm::vec3(worldMtx * glm::vec4(vertex.position, 1.0f));
+				vertex.normal		= glm::normalize(normalMtx * vertex.normal);
+				// mirrored: the bitangent (cross(normal, tangent) * w) flips with the handedness
+				vertex.tangent	= glm::vec4(
+					glm::normalize(glm::mat3(worldMtx) * glm::vec3(vertex.tangent)),
+					isMirrored ? -vertex.tangent.w : vertex.tangent.w
+				);
+
+				vertices.push_back(vertex);
+			}
+
+			for(auto i = primitive.indexParams.firstIndex; i < primitive.indexParams.firstIndex + primitive.idxCount; i += 3)
+			{
+				const auto i1 = isMirrored ? i + 2 : i + 1;
+				const auto i2 = isMirrored ? i + 1 : i + 2;
+
+				indices.push_back(indices[i]	- primitive.firstVertex + vtxBase);
+				indices.push_back(indices[i1]	- primitive.firstVertex + vtxBase);
+				indices.push_back(indices[i2]	- primitive.firstVertex + vtxBase);
+			}
+
+			batch.vtxCount += primitive.vtxCount;
+			batch.idxCount += primitive.idxCount;
+
+			// merged: dropped from its node (and its source range by the compaction)
+			primitive.idxCount = 0;
+			primitive.vtxCount = 0;
+
+			mergedCount++;
+		}
+
+		batches.push_back(batch);
+	}
+
+	if(batches.empty()) { return; }
+
+	vk::Model::forEachNode(_data.nodes, [](const NodePtr &_node)
+	{
+		auto &primitives = _node->mesh.primitives;
+
+		primitives.erase(
+			std::remove_if(
+				primitives.begin(), primitives.end(),
+				[](const Primitive &_primitive) { return _primitive.idxCount == 0 && _primitive.vtxCount == 0; }
+			),
+			primitives.end()
+		);
+	});
+
+	_data.nodes.push_back(batchNode);
+
+	compact(_data);
+
+	TIMER(end);
+
+	INFO_LOG(
+		"Static batching: %u primitives merged into %zu batches, %u -> %u draws in %.2f ms",
+		mergedCount, batches.size(), srcDrawCount, getDrawCount(_data), TIME_DIFF(start, end)
+	);
+}
+
+void StaticBatcher::compact(vk::Model::Data &_data) noexcept
+{
+	std::vector<Vertex>		vertices;
+	std::vector<uint32_t>	indices;
+
+	vertices.reserve(_data.vertices.size());
+	indices.reserve(_data.indices.size());
+
+	vk::Model::forEachNode(_data.nodes, [&](const NodePtr &_node)
+	{
+		for(auto &primitive : _node->mesh.primitives)
+		{
+			const auto firstVtx = static_cast<uint32_t>(vertices.size());
+			const auto firstIdx = static_cast<uint32_t>(indices.size());
+			const auto srcIdx		= _data.indices.begin() + primitive.indexParams.firstIndex;
+
+			vertices.insert(
+				vertices.end(),
+				_data.vertices.begin() + primitive.firstVertex,
+				_data.vertices.begin() + primitive.firstVertex + primitive.vtxCount
+			);
+
+			for(auto i = srcIdx; i < srcIdx + primitive.idxCount; ++i)
+			{
+				indices.push_back(*i - primitive.firstVertex + firstVtx);
+			}
+
+			primitive.firstVertex						= firstVtx;
+			primitive.indexParams.firstIndex	= firstIdx;
+		}
+	});
+
+	_data.vertices	= std::move(vertices);
+	_data.indices		= std::move(indices);
+}
+
+uint32_t StaticBatcher::getDrawCount(const vk::Model::Data &_data) noexcept
+{
+	auto drawCount = 0u;
+
+	vk::Model::forEachNode(_data.nodes, [&](const NodePtr &_node)
+	{
+		for(const auto &primitive : _node->mesh.primitives)
+		{
+			drawCount += primitive.idxCount > 0 ? 1 : 0;
+		}
+	});
+
+	return drawCount;
+}
@@ -71,6 +71,57 @@ namespace vk
 		vkDestroyCommandPool(_logicalDevice, _cmdPool, _pAllocator);
 	}
 
+	void Command::createQueryPool(
+		const VkDevice												&_logicalDevice,
+		const VkQueryPipelineStatisticFlags		&_statistics,
+		uint32_t															_queryCount,
+		VkQueryPool														&_queryPool
+	) noexcept
+	{
+		VkQueryPoolCreateInfo info	= {};
+		info.sType									= VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		info.queryType							= VK_QUERY_TYPE_PIPELINE_STATISTICS;
+		info.queryCount							= _queryCount;
+		info.pipelineStatistics			= _statistics;
+
+		auto result = vkCreateQueryPool(
+			_logicalDevice,
+			&info,
+			nullptr,
+			&_queryPool
+		);
+		ASSERT_VK(result, "Failed to create a Query Pool!");
+	}
+
+	void Command::destroyQueryPool(
+		const VkDevice							&_logicalDevice,
+		const VkQueryPool						&_queryPool,
+		const VkAllocationCallbacks	*_pAllocator
+	) noexcept
+	{
+		vkDestroyQueryPool(_logicalDevice, _queryPool, _pAllocator);
+	}
+
+	bool Command::getQueryResults(
+		const VkDevice			&_logicalDevice,
+		const VkQueryPool		&_queryPool,
+		uint32_t						_queryCount,
+		uint64_t						*_pResults,
+		size_t							_resultsSize
+	) noexcept
+	{
+		const auto result = vkGetQueryPoolResults(
+			_logicalDevice,
+			_queryPool,
+			0, _queryCount,
+			_resultsSize, _pResults,
+			_resultsSize / _queryCount,
+			VK_QUERY_RESULT_64_BIT
+		);
+
+		return result == VK_SUCCESS;
+	}
+
 	void Command::record(
 		const VkCommandBuffer															&_cmdBuffer,
 		const std::function<void(const VkCommandBuffer&)>	&_recordCallback,
@@ -135,8 +186,8 @@ namespace vk
 
 	void Command::insertBarriers(
 		const VkCommandBuffer					&_cmdBuffer,
-		const VkPipelineStageFlagBits	&_srcStageMask,
-		const VkPipelineStageFlagBits	&_dstStageMask,
+		const VkPipelineStageFlags		&_srcStageMask,
+		const VkPipelineStageFlags		&_dstStageMask,
 		const VkDependencyFlags				&_dependencyFlags,
 		uint32_t											_memoryBarrierCount,
 		const VkMemoryBarrier					*_pMemoryBarriers,
@@ -222,6 +273,14 @@ namespace vk
 		);
 	}
 
+	void Command::nextSubpass(
+		const VkCommandBuffer			&_cmdBuffer,
+		const VkSubpassContents		&_contents
+	) noexcept
+	{
+		vkCmdNextSubpass(_cmdBuffer, _contents);
+	}
+
 	void Command::draw(
 		const VkCommandBuffer			&_cmdBuffer,
 		uint32_t									_vtxCount,
@@ -257,6 +316,100 @@ namespace vk
 		);
 	}
 
+	void Command::drawIndexedIndirect(
+		const VkCommandBuffer			&_cmdBuffer,
+		const VkBuffer						&_buffer,
+		VkDeviceSize							_offset,
+		uint32_t									_drawCount,
+		uint32_t									_stride
+	) noexcept
+	{
+		vkCmdDrawIndexedIndirect(
+			_cmdBuffer,
+			_buffer,
+			_offset,
+			_drawCount,
+			_stride
+		);
+	}
+
+	void Command::drawIndirect(
+		const VkCommandBuffer			&_cmdBuffer,
+		const VkBuffer						&_buffer,
+		VkDeviceSize							_offset,
+		uint32_t									_drawCount,
+		uint32_t									_stride
+	) noexcept
+	{
+		vkCmdDrawIndirect(
+			_cmdBuffer,
+			_buffer,
+			_offset,
+			_drawCount,
+			_stride
+		);
+	}
+
+	void Command::updateBuffer(
+		const VkCommandBuffer			&_cmdBuffer,
+		const VkBuffer						&_buffer,
+		VkDeviceSize							_offset,
+		VkDeviceSize							_size,
+		const void								*_pData
+	) noexcept
+	{
+		vkCmdUpdateBuffer(
+			_cmdBuffer,
+			_buffer,
+			_offset,
+			_size,
+			_pData
+		);
+	}
+
+	void Command::resetQueryPool(
+		const VkCommandBuffer			&_cmdBuffer,
+		const VkQueryPool					&_queryPool,
+		uint32_t									_queryCount,
+		uint32_t									_firstQuery
+	) noexcept
+	{
+		vkCmdResetQueryPool(_cmdBuffer, _queryPool, _firstQuery, _queryCount);
+	}
+
+	void Command::beginQuery(
+		const VkCommandBuffer			&_cmdBuffer,
+		const VkQueryPool					&_queryPool,
+		uint32_t									_query
+	) noexcept
+	{
+		vkCmdBeginQuery(_cmdBuffer, _queryPool, _query, 0);
+	}
+
+	void Command::endQuery(
+		const VkCommandBuffer			&_cmdBuffer,
+		const VkQueryPool					&_queryPool,
+		uint32_t									_query
+	) noexcept
+	{
+		vkCmdEndQuery(_cmdBuffer, _queryPool, _query);
+	}
+
+	void Command::dispatch(
+		const VkCommandBuffer			&_cmdBuffer,
+		uint32_t									_groupCountX,
+		uint32_t									_groupCountY,
+		uint32_t									_groupCountZ
+	) noexcept
+	{
+		vkCmdDispatch(
+			_cmdBuffer,
+			_groupCountX,
+			_groupCountY,
+			_groupCountZ
+		);
+	}
+
 	void Command::bindPipeline(
 		const VkCommandBuffer			&_cmdBuffer,
 		const VkPipeline 					&_pipeline,
@@ -293,12 +446,13 @@ namespace vk
 	void Command::bindVtxBuffers(
 		const VkCommandBuffer &_cmdBuffer,
 		const VkBuffer				&_vtxBuffer,
-		const VkDeviceSize 		&_offsets
+		const VkDeviceSize 		&_offsets,
+		uint32_t							_firstBinding
 	) noexcept
 	{
 		vkCmdBindVertexBuffers(
 			_cmdBuffer,
-			0, 1,
+			_firstBinding, 1,
 			&_vtxBuffer,
 			&_offsets
 		);
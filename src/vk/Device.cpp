@@ -175,7 +175,8 @@ namespace vk
 					m_data.physicalDevice, &m_data.features
 				);
 
-				if(m_data.features.samplerAnisotropy)
+				// instanced draws (direct & indirect) start at their instances' slot: drawIndirectFirstInstance
+				if(m_data.features.samplerAnisotropy && m_data.features.drawIndirectFirstInstance)
 				{ break; }
 				else
 				{ continue; }
@@ -210,8 +211,18 @@ namespace vk
 			queueInfos.push_back(queueInfo);
 		}
 
-		VkPhysicalDeviceFeatures deviceFeatures	= {};
-		deviceFeatures.samplerAnisotropy				= VK_TRUE;
+		if(!m_data.features.drawIndirectFirstInstance)
+		{
+			FATAL_ERROR_LOG("drawIndirectFirstInstance is not supported (indirect draws of instanced nodes)!");
+		}
+
+		VkPhysicalDeviceFeatures deviceFeatures		= {};
+		deviceFeatures.samplerAnisotropy					= VK_TRUE;
+		deviceFeatures.drawIndirectFirstInstance	= VK_TRUE; // indirect commands' firstInstance: the instance slot (required)
+		deviceFeatures.multiDrawIndirect					= m_data.features.multiDrawIndirect; // cluster culling draws (optional)
+		deviceFeatures.pipelineStatisticsQuery		= m_data.features.pipelineStatisticsQuery; // overdraw stats (optional)
+
+		m_data.enabledFeatures = deviceFeatures;
 
 		VkDeviceCreateInfo deviceInfo				= {};
 
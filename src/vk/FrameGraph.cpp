@@ -0,0 +1,487 @@
+#include "vk/Device.h"
+#include "vk/Command.h"
+#include "vk/FrameGraph.h"
+
+namespace vk
+{
+	uint16_t FrameGraph::createImage(
+		Data								&_data,
+		const char					*_name,
+		const VkFormat			&_format,
+		const VkExtent2D		&_extent,
+		VkImageUsageFlags		_usage,
+		VkImageAspectFlags	_aspectMask
+	) noexcept
+	{
+		Resource resource;
+		resource.name				= _name;
+		resource.format			= _format;
+		resource.extent			= _extent;
+		resource.usage			= _usage;
+		resource.aspectMask	= _aspectMask;
+
+		_data.resources.push_back(resource);
+
+		return static_cast<uint16_t>(_data.resources.size() - 1);
+	}
+
+	void FrameGraph::compile(
+		const VkDevice													&_logicalDevice,
+		const VkPhysicalDeviceMemoryProperties	&_memProps,
+		Data																		&_data
+	) noexcept
+	{
+		auto &resources	= _data.resources;
+		auto &passes		= _data.passes;
+
+		const auto passCount = static_cast<int32_t>(passes.size());
+
+		// culling: backwards from the outputs, a pass is live if it has side effects or writes a needed resource
+		auto isNeeded = std::vector<bool>(resources.size(), false);
+
+		for(const auto &output : _data.outputs) { isNeeded[output.resource] = true; }
+
+		for(auto p = passCount - 1; p >= 0; --p)
+		{
+			auto &pass = passes[p];
+
+			pass.isCulled = !pass.hasSideEffects && std::none_of(
+				pass.writes.begin(), pass.writes.end(),
+				[&](const Use &_use) { return isNeeded[_use.resource]; }
+			);
+
+			if(pass.isCulled)
+			{
+				TRACE_LOG("Frame graph: pass %s culled", pass.name);
+				continue;
+			}
+
+			for(const auto &use : pass.reads) { isNeeded[use.resource] = true; }
+		}
+
+		// lifetimes & usage of the live passes' accesses, outputs live past the last pass (never aliased)
+		auto livePassCount = 0u;
+
+		for(auto p = 0; p < passCount; ++p)
+		{
+			const auto &pass = passes[p];
+
+			if(pass.isCulled) { continue; }
+
+			livePassCount++;
+
+			for(const auto *uses : { &pass.reads, &pass.writes })
+			{
+				for(const auto &use : *uses)
+				{
+					auto &resource = resources[use.resource];
+
+					if(resource.firstPass < 0) { resource.firstPass = p; }
+
+					resource.lastPass	= p;
+					resource.usage		|= getUsage(use.access);
+				}
+			}
+		}
+
+		for(const auto &output : _data.outputs)
+		{
+			auto &resource = resources[output.resource];
+
+			if(resource.firstPass < 0) { resource.firstPass = passCount; }
+
+			resource.lastPass	= passCount;
+			resource.usage		|= getUsage(output.access);
+		}
+
+		// owned images of the live passes
+		std::vector<uint16_t>							owned;
+		std::vector<VkMemoryRequirements>	memReqs(resources.size());
+
+		for(auto r = 0u; r < resources.size(); ++r)
+		{
+			auto &resource = resources[r];
+
+			if(resource.firstPass < 0) { continue; }
+
+			Image::create(
+				_logicalDevice,
+				resource.extent, resource.format,
+				VK_IMAGE_TILING_OPTIMAL,
+				resource.usage,
+				resource.image
+			);
+			vkGetImageMemoryRequirements(_logicalDevice, resource.image, &memReqs[r]);
+
+			resource.size = memReqs[r].size;
+			owned.push_back(static_cast<uint16_t>(r));
+		}
+
+		// largest first, each into the first allocation whose resources are all dead during its lifetime (bound at 0)
+		struct Allocation
+		{
+			VkDeviceSize					size;
+			uint32_t							typeBits;
+			std::vector<uint16_t>	resources;
+		};
+
+		std::vector<Allocation> allocations;
+		VkDeviceSize ownedSize = 0, allocatedSize = 0;
+
+		std::stable_sort(owned.begin(), owned.end(), [&](uint16_t _a, uint16_t _b)
+		{
+			return resources[_a].size > resources[_b].size;
+		});
+
+		for(const auto r : owned)
+		{
+			const auto &resource	= resources[r];
+			const auto &reqs			= memReqs[r];
+
+			const auto isOverlapping = [&](uint16_t _other)
+			{
+				const auto &other = resources[_other];
+
+				return other.firstPass <= resource.lastPass && resource.firstPass <= other.lastPass;
+			};
+
+			auto it = std::find_if(allocations.begin(), allocations.end(), [&](const Allocation &_allocation)
+			{
+				return (_allocation.typeBits & reqs.memoryTypeBits) != 0 && _allocation.size >= reqs.size &&
+							 std::none_of(_allocation.resources.begin(), _allocation.resources.end(), isOverlapping);
+			});
+
+			if(it == allocations.end())
+			{
+				allocations.push_back({ reqs.size, reqs.memoryTypeBits, {} });
+				it = std::prev(allocations.end());
+
+				allocatedSize += reqs.size;
+			}
+
+			it->typeBits &= reqs.memoryTypeBits;
+			it->resources.push_back(r);
+
+			ownedSize += reqs.size;
+		}
+
+		_data.memories.resize(allocations.size());
+
+		for(auto a = 0u; a < allocations.size(); ++a)
+		{
+			auto &allocation = allocations[a];
+
+			Device::allocMemory(
+				_logicalDevice,
+				allocation.size,
+				Device::getMemoryType(allocation.typeBits, _memProps, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+				_data.memories[a]
+			);
+
+			// lifetime order: the first use of each resource waits on the last use of the previous one
+			std::sort(allocation.resources.begin(), allocation.resources.end(), [&](uint16_t _a, uint16_t _b)
+			{
+				return resources[_a].firstPass < resources[_b].firstPass;
+			});
+
+			for(auto i = 0u; i < allocation.resources.size(); ++i)
+			{
+				auto &resource = resources[allocation.resources[i]];
+
+				resource.memoryIndex	= static_cast<int32_t>(a);
+				resource.aliasedIndex	= i > 0 ? allocation.resources[i - 1] : -1;
+
+				const auto &result = vkBindImageMemory(_logicalDevice, resource.image, _data.memories[a], 0);
+				ASSERT_VK(result, "Failed to bind Frame Graph Image Memory!");
+
+				Image::createImageView(
+					_logicalDevice,
+					resource.image, resource.format,
+					resource.view,
+					1, 1, 0,
+					resource.aspectMask
+				);
+			}
+		}
+
+		INFO_LOG(
+			"Frame graph: %u/%zu passes, %zu images in %zu allocations (%.1f MB, %.1f MB without aliasing)",
+			livePassCount, passes.size(), owned.size(), allocations.size(),
+			float(allocatedSize) / float(1 << 20), float(ownedSize) / float(1 << 20)
+		);
+	}
+
+	void FrameGraph::getDependencies(
+		Data								&_data,
+		uint16_t						_pass,
+		VkSubpassDependency	&_in,
+		VkSubpassDependency	&_out
+	) noexcept
+	{
+		const auto &resources	= _data.resources;
+		const auto &passes		= _data.passes;
+
+		_in		= {};
+		_out	= {};
+
+		_in.srcSubpass	= VK_SUBPASS_EXTERNAL;
+		_in.dstSubpass	= 0;
+		_out.srcSubpass	= 0;
+		_out.dstSubpass	= VK_SUBPASS_EXTERNAL;
+
+		const auto &isSameMemory = [&](uint16_t _a, uint16_t _b)
+		{
+			return _a == _b || (resources[_a].memoryIndex >= 0 && resources[_a].memoryIndex == resources[_b].memoryIndex);
+		};
+
+		// another use of an attachment's memory: in, its last frame's; out, this frame's (later uses of the attachment)
+		const auto &addUse = [&](uint16_t _attachment, uint16_t _resource, const State &_state, bool _isLater)
+		{
+			if(!isSameMemory(_attachment, _resource)) { return; }
+
+			_in.srcStageMask	|= _state.stages;
+			_in.srcAccessMask	|= _state.access & s_writeAccess;
+
+			if(_isLater && _resource == _attachment)
+			{
+				_out.dstStageMask		|= _state.stages;
+				_out.dstAccessMask	|= _state.access;
+			}
+		};
+
+		for(const auto &write : passes[_pass].writes)
+		{
+			const auto state = getState(write.access, passes[_pass].shaderStages);
+
+			_in.dstStageMask		|= state.stages;
+			_in.dstAccessMask		|= state.access;
+			_out.srcStageMask		|= state.stages;
+			_out.srcAccessMask	|= state.access & s_writeAccess;
+
+			for(auto p = 0u; p < passes.size(); ++p)
+			{
+				const auto &pass = passes[p];
+
+				if(pass.isCulled) { continue; }
+
+				for(const auto *uses : { &pass.reads, &pass.writes })
+				{
+					for(const auto &use : *uses)
+					{
+						addUse(write.resource, use.resource, getState(use.access, pass.shaderStages), p > _pass);
+					}
+				}
+			}
+
+			for(const auto &output : _data.outputs)
+			{
+				addUse(write.resource, output.resource, getState(output.access, output.stages), true);
+			}
+		}
+
+		// nothing reads the attachments past the render pass
+		if(_out.dstStageMask == 0) { _out.dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT; }
+
+		_data.passes[_pass].visibleStages = _out.dstStageMask;
+	}
+
+	void FrameGraph::execute(
+		const Data						&_data,
+		const VkCommandBuffer	&_cmdBuffer
+	) noexcept
+	{
+		const auto &resources = _data.resources;
+
+		// per resource: last write & the stages its result is visible to
+		struct Tracking
+		{
+			State									write;
+			VkPipelineStageFlags	readStages	= 0;
+			VkImageLayout					layout			= VK_IMAGE_LAYOUT_UNDEFINED;
+			bool									isUsed			= false;
+		};
+
+		auto trackings = std::vector<Tracking>(resources.size());
+
+		std::vector<VkImageMemoryBarrier> barriers;
+		VkPipelineStageFlags srcStages = 0, dstStages = 0;
+
+		const auto &addUse = [&](uint16_t _resource, const State &_state, bool _isAttachment, VkImageLayout _finalLayout)
+		{
+			const auto &resource	= resources[_resource];
+			auto &tracking				= trackings[_resource];
+
+			// first use of an aliased allocation: after the last use of its previous resource
+			const auto &previous = !tracking.isUsed && resource.aliasedIndex >= 0
+				? trackings[resource.aliasedIndex]
+				: tracking;
+
+			const auto isWrite				= (_state.access & s_writeAccess) != 0;
+			const auto isLayoutChange	= !_isAttachment && tracking.layout != _state.layout;	// attachments: render pass'
+			const auto isHazard				= isWrite
+				? (previous.write.stages | previous.readStages) != 0
+				: previous.write.access != 0 && (previous.readStages & _state.stages) != _state.stages;
+
+			if(isLayoutChange || isHazard)
+			{
+				// already in the batch (e.g. depth sampled & tested): one barrier, the readers' access combined
+				auto it = std::find_if(barriers.begin(), barriers.end(), [&](const VkImageMemoryBarrier &_barrier)
+				{
+					return _barrier.image == resource.image;
+				});
+
+				if(it != barriers.end())
+				{
+					ASSERT(it->newLayout == _state.layout, "Frame Graph accesses of a barrier batch need the same layout!");
+
+					it->dstAccessMask |= _state.access;
+				}
+				else
+				{
+					VkImageMemoryBarrier barrier = {};
+					barrier.sType								= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+					barrier.srcAccessMask				= previous.write.access;
+					barrier.dstAccessMask				= _state.access;
+					barrier.oldLayout						= tracking.layout;
+					barrier.newLayout						= _state.layout;
+					barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+					barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+					barrier.image								= resource.image;
+					barrier.subresourceRange		= { resource.aspectMask, 0, 1, 0, 1 };
+
+					barriers.push_back(barrier);
+				}
+
+				srcStages	|= previous.write.stages | (isWrite || isLayoutChange ? previous.readStages : 0);
+				dstStages	|= _state.stages;
+
+				tracking.layout = _state.layout;
+			}
+
+			if(isWrite)
+			{
+				tracking.write			= _state;
+				tracking.readStages	= 0;
+			}
+			else
+			{
+				tracking.readStages = (isLayoutChange ? 0 : tracking.readStages) | _state.stages;
+			}
+
+			tracking.layout = _isAttachment
+				? (_finalLayout != VK_IMAGE_LAYOUT_UNDEFINED ? _finalLayout : _state.layout)
+				: _state.layout;
+			tracking.isUsed = true;
+		};
+
+		const auto &flush = [&]()
+		{
+			if(barriers.empty()) { return; }
+
+			Command::insertBarriers(
+				_cmdBuffer, barriers.data(), static_cast<uint32_t>(barriers.size()), 0,
+				srcStages != 0 ? srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+				dstStages
+			);
+
+			barriers.clear();
+			srcStages = dstStages = 0;
+		};
+
+		for(const auto &pass : _data.passes)
+		{
+			if(pass.isCulled) { continue; }
+
+			for(const auto *uses : { &pass.reads, &pass.writes })
+			{
+				for(const auto &use : *uses)
+				{
+					const auto isAttachment = use.access == Access::COLOR_ATTACHMENT || use.access == Access::DEPTH_ATTACHMENT;
+
+					addUse(use.resource, getState(use.access, pass.shaderStages), isAttachment, use.finalLayout);
+				}
+			}
+
+			flush();
+
+			if(pass.record) { pass.record(_cmdBuffer); }
+
+			// render pass: its writes already visible to the later uses (out dependency, see getDependencies)
+			for(const auto &use : pass.writes) { trackings[use.resource].readStages |= pass.visibleStages; }
+		}
+
+		for(const auto &output : _data.outputs)
+		{
+			addUse(output.resource, getState(output.access, output.stages), false, VK_IMAGE_LAYOUT_UNDEFINED);
+		}
+
+		flush();
+	}
+
+	void FrameGraph::destroy(
+		const VkDevice	&_logicalDevice,
+		Data						&_data
+	) noexcept
+	{
+		for(const auto &resource : _data.resources)
+		{
+			Image::destroyImageView	(_logicalDevice, resource.view);
+			Image::destroyImage			(_logicalDevice, resource.image);
+		}
+
+		for(const auto &memory : _data.memories) { Device::freeMemory(_logicalDevice, memory); }
+
+		_data = {};
+	}
+
+	FrameGraph::State FrameGraph::getState(Access _access, VkPipelineStageFlags _shaderStages) noexcept
+	{
+		switch(_access)
+		{
+			case Access::COLOR_ATTACHMENT:
+				return {
+					VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+					VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+					VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+				};
+			case Access::DEPTH_ATTACHMENT:
+				return {
+					VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+					VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+					VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+				};
+			case Access::SAMPLED:
+				return { _shaderStages, VK_ACCESS_SHADER_READ_BIT,	VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL				};
+			case Access::DEPTH_SAMPLED:
+				return { _shaderStages, VK_ACCESS_SHADER_READ_BIT,	VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL	};
+			case Access::STORAGE_READ:
+				return { _shaderStages, VK_ACCESS_SHADER_READ_BIT,	VK_IMAGE_LAYOUT_GENERAL													};
+			case Access::STORAGE_WRITE:
+				return { _shaderStages, VK_ACCESS_SHADER_WRITE_BIT,	VK_IMAGE_LAYOUT_GENERAL													};
+			case Access::DEPTH_TEST:
+				return {
+					VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+					VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+					VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+				};
+			default:
+				ASSERT(false, "Unknown Frame Graph access!");
+				return {};
+		}
+	}
+
+	VkImageUsageFlags FrameGraph::getUsage(Access _access) noexcept
+	{
+		switch(_access)
+		{
+			case Access::COLOR_ATTACHMENT:	return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+			case Access::DEPTH_ATTACHMENT:
+			case Access::DEPTH_TEST:				return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+			case Access::SAMPLED:
+			case Access::DEPTH_SAMPLED:			return VK_IMAGE_USAGE_SAMPLED_BIT;
+			case Access::STORAGE_READ:
+			case Access::STORAGE_WRITE:			return VK_IMAGE_USAGE_STORAGE_BIT;
+			default:												return 0;
+		}
+	}
+}
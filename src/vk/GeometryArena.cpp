@@ -0,0 +1,82 @@
+#include "vk/GeometryArena.h"
+
+namespace vk
+{
+	GeometryArena::Range GeometryArena::allocate(
+		Data					&_data,
+		Buffer::Type	_type,
+		VkDeviceSize	_size,
+		VkDeviceSize	_alignment
+	) noexcept
+	{
+		auto &freeRanges = _data.freeRanges[_type];
+
+		_alignment = std::max(_alignment, VkDeviceSize(1));
+
+		// first fit: the alignment padding stays a free range of its own
+		for(auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+		{
+			const auto offset		= (it->offset + _alignment - 1) / _alignment * _alignment;
+			const auto padding	= offset - it->offset;
+
+			if(it->size < padding + _size) { continue; }
+
+			const auto tail = Range { offset + _size, it->size - padding - _size };
+
+			if(padding > 0)
+			{
+				it->size = padding;
+
+				if(tail.size > 0) { freeRanges.insert(it + 1, tail); }
+			}
+			else if(tail.size > 0)	{ *it = tail; }
+			else										{ freeRanges.erase(it); }
+
+			_data.usedSizes[_type] += _size;
+
+			return Range { offset, _size };
+		}
+
+		ERROR_LOG(
+			"Geometry arena: no free range for %llu bytes (type: %u, %llu/%llu bytes used)",
+			static_cast<unsigned long long>(_size), toInt(_type),
+			static_cast<unsigned long long>(_data.usedSizes[_type]), static_cast<unsigned long long>(_data.capacities[_type])
+		);
+
+		return Range {};
+	}
+
+	void GeometryArena::free(
+		Data					&_data,
+		Buffer::Type	_type,
+		Range					&_range
+	) noexcept
+	{
+		if(!_range.isValid() || _range.size == 0) { _range = {}; return; }
+
+		auto &freeRanges = _data.freeRanges[_type];
+
+		auto it = std::lower_bound(
+			freeRanges.begin(), freeRanges.end(), _range.offset,
+			[](const Range &_freeRange, VkDeviceSize _offset) { return _freeRange.offset < _offset; }
+		);
+
+		it = freeRanges.insert(it, _range);
+
+		// coalesce with the neighbours
+		if(it + 1 != freeRanges.end() && it->offset + it->size == (it + 1)->offset)
+		{
+			it->size += (it + 1)->size;
+			freeRanges.erase(it + 1);
+		}
+
+		if(it != freeRanges.begin() && (it - 1)->offset + (it - 1)->size == it->offset)
+		{
+			(it - 1)->size += it->size;
+			freeRanges.erase(it);
+		}
+
+		_data.usedSizes[_type] -= _range.size;
+		_range = {};
+	}
+}
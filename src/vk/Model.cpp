@@ -0,0 +1,446 @@
+#include "vk/Device.h"
+#include "vk/Model.h"
+
+namespace vk
+{
+	void Model::createCullBuffers(const std::unique_ptr<Device> &_device, Data &_data) noexcept
+	{
+		const auto &deviceData		= _device->getData();
+		const auto &logicalDevice	= deviceData.logicalDevice;
+		const auto meshletCount		= _data.meshlets.size();
+
+		if(meshletCount == 0) { return; }
+
+		const auto &hostPropFlags	= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+																VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+		const auto &createBuffer = [&](
+			VkDeviceSize								_size,
+			const VkBufferUsageFlags		&_usageFlags,
+			const VkMemoryPropertyFlags	&_memPropFlags,
+			VkBuffer										&_buffer,
+			VkDeviceMemory							&_memory
+		)
+		{
+			VkDeviceSize alignment;
+
+			Buffer::create(logicalDevice, _size, _usageFlags, _buffer);
+			Buffer::createMemory(
+				logicalDevice, _usageFlags,
+				deviceData.memProps, _memPropFlags,
+				_buffer, alignment, _memory
+			);
+		};
+
+		// record 0: meshlets of no drawn primitive (zero draws), then one per distinct meshlet range (instance groups'
+		// copies share theirs)
+		auto cullMeshlets = std::vector<CullMeshlet>(meshletCount);
+
+		_data.cullRecordCount = 1;
+
+		forEachNode(_data.nodes, [&](const NodePtr &_node)
+		{
+			for(auto &primitive : _node->mesh.primitives)
+			{
+				if(primitive.meshletCount == 0) { continue; }
+
+				auto &firstMeshlet = cullMeshlets[primitive.firstMeshlet];
+
+				if(firstMeshlet.record == 0)
+				{
+					for(auto m = primitive.firstMeshlet; m < primitive.firstMeshlet + primitive.meshletCount; ++m)
+					{
+						const auto &meshlet = _data.meshlets[m];
+
+						cullMeshlets[m] = {
+							glm::vec4(meshlet.center, meshlet.radius), glm::vec4(meshlet.coneAxis, meshlet.coneCutoff),
+							meshlet.firstIndex, meshlet.idxCount, _data.cullRecordCount
+						};
+					}
+
+					_data.cullRecordCount++;
+				}
+
+				primitive.cullIndex = firstMeshlet.record;
+			}
+		});
+
+		void *mappedData = nullptr;
+
+		createBuffer(
+			meshletCount * sizeof(CullMeshlet), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostPropFlags,
+			_data.meshletBuffer, _data.meshletMemory
+		);
+		Device::mapMemory(logicalDevice, _data.meshletMemory, &mappedData);
+		memcpy(mappedData, cullMeshlets.data(), meshletCount * sizeof(CullMeshlet));
+		Device::unmapMemory(logicalDevice, _data.meshletMemory);
+
+		createBuffer(
+			sizeof(CullView) + _data.cullRecordCount * sizeof(CullRecord), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostPropFlags,
+			_data.cullRecordBuffer, _data.cullRecordMemory
+		);
+		Device::mapMemory(logicalDevice, _data.cullRecordMemory, &mappedData);
+
+		_data.cullView		= static_cast<CullView*>(mappedData);
+		_data.cullRecords	= reinterpret_cast<CullRecord*>(_data.cullView + 1);
+
+		// written by the meshlet culling pass only
+		createBuffer(
+			meshletCount * sizeof(VkDrawIndexedIndirectCommand),
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			_data.drawCmdBuffer, _data.drawCmdMemory
+		);
+
+		_data.isMultiDrawIndirect = deviceData.enabledFeatures.multiDrawIndirect == VK_TRUE;
+
+		// until the first cull: everything visible (a single draw per primitive)
+		*_data.cullView = {};
+		std::fill(_data.cullRecords, _data.cullRecords + _data.cullRecordCount, CullRecord {});
+
+		forEachNode(_data.nodes, [&](const NodePtr &_node)
+		{
+			for(const auto &primitive : _node->mesh.primitives)
+			{
+				if(primitive.meshletCount == 0) { continue; }
+
+				setCullRecord(_data, primitive, CullMode::RANGE, glm::mat4(1.0f), primitive.indexParams.instanceCount);
+			}
+		});
+	}
+
+	void Model::createInstanceBuffer(const std::unique_ptr<Device> &_device, Data &_data) noexcept
+	{
+		const auto &deviceData		= _device->getData();
+		const auto &logicalDevice	= deviceData.logicalDevice;
+
+		const auto &usageFlags		= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+		const auto &memPropFlags	= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+																VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+		VkDeviceSize alignment;
+		void *instances = nullptr;
+
+		Buffer::create(logicalDevice, _data.instanceCount * sizeof(glm::mat4), usageFlags, _data.instanceBuffer);
+		Buffer::createMemory(
+			logicalDevice, usageFlags,
+			deviceData.memProps, memPropFlags,
+			_data.instanceBuffer, alignment, _data.instanceMemory
+		);
+		Device::mapMemory(logicalDevice, _data.instanceMemory, &instances);
+
+		_data.instances = static_cast<glm::mat4*>(instances);
+
+		// until the first cull: every member visible
+		updateInstances(_data);
+	}
+
+	void Model::updateInstances(Data &_data) noexcept
+	{
+		if(!_data.instances) { return; }
+
+		// parents first: a single matrix product per node
+		const std::function<void(const NodePtr&, const glm::mat4&)> update = [&](const NodePtr &_node, const glm::mat4 &_parentMtx)
+		{
+			const auto worldMtx = _parentMtx * _node->matrix;
+
+			if(_node->instanceIndex != s_noInstance)
+			{
+				_data.instances[_node->instanceIndex] = worldMtx * _data.dequantization;
+			}
+
+			for(const auto &child : _node->children) { update(child, worldMtx); }
+		};
+
+		_data.instances[0] = _data.dequantization;
+
+		for(const auto &node : _data.nodes) { update(node, glm::mat4(1.0f)); }
+	}
+
+	void Model::buildInstanceGroups(Data &_data) noexcept
+	{
+		using Signature = std::vector<std::tuple<uint32_t, uint32_t, int>>;
+
+		std::map<Signature, uint32_t> groupIndices;
+		auto &groups = _data.instanceGroups;
+
+		groups.clear();
+
+		// nodes drawing the same source ranges with the same materials
+		forEachNode(_data.nodes, [&](const NodePtr &_node)
+		{
+			const auto &primitives = _node->mesh.primitives;
+
+			_node->instanceGroup	= -1;
+			_node->instanceMember	= 0;
+			_node->instanceIndex	= s_noInstance;
+
+			if(primitives.empty() || _node->skinIndex > -1) { return; }
+
+			Signature signature;
+
+			for(const auto &primitive : primitives)
+			{
+				signature.emplace_back(primitive.indexParams.firstIndex, primitive.idxCount, primitive.matIndex);
+			}
+
+			const auto [it, isNew] = groupIndices.emplace(signature, static_cast<uint32_t>(groups.size()));
+
+			if(isNew) { groups.emplace_back(); }
+
+			groups[it->second].nodes.push_back(_node.get());
+		});
+
+		// single nodes stay regular draws (own instance slot)
+		groups.erase(
+			std::remove_if(groups.begin(), groups.end(), [](const InstanceGroup &_group) { return _group.nodes.size() < 2; }),
+			groups.end()
+		);
+
+		_data.instanceCount = 1;
+
+		auto srcDrawCount = 0u, drawCount = 0u;
+
+		for(auto g = 0u; g < groups.size(); ++g)
+		{
+			auto &group = groups[g];
+
+			group.firstInstance = _data.instanceCount;
+			group.isVisible.assign(group.nodes.size(), 1);
+
+			for(auto m = 0u; m < group.nodes.size(); ++m)
+			{
+				group.nodes[m]->instanceGroup		= static_cast<int32_t>(g);
+				group.nodes[m]->instanceMember	= m;
+				group.nodes[m]->instanceIndex		= group.firstInstance + m;
+			}
+
+			for(auto &primitive : group.nodes[0]->mesh.primitives)
+			{
+				primitive.indexParams.instanceCount	= static_cast<uint32_t>(group.nodes.size());
+				primitive.indexParams.firstInstance	= group.firstInstance;
+			}
+
+			const auto primitiveCount = static_cast<uint32_t>(group.nodes[0]->mesh.primitives.size());
+
+			srcDrawCount				+= primitiveCount * static_cast<uint32_t>(group.nodes.size());
+			drawCount						+= primitiveCount;
+			_data.instanceCount	+= static_cast<uint32_t>(group.nodes.size());
+		}
+
+		if(!groups.empty())
+		{
+			INFO_LOG(
+				"Instancing: %zu group(s) of %u instances, %u -> %u draws",
+				groups.size(), _data.instanceCount - 1, srcDrawCount, drawCount
+			);
+		}
+
+		// regular nodes: one slot each, drawn as a single instance (the slot is the draws' firstInstance, indirect draws
+		// included: Device requires & enables drawIndirectFirstInstance)
+		forEachNode(_data.nodes, [&](const NodePtr &_node)
+		{
+			if(_node->instanceGroup > -1 || _node->mesh.primitives.empty()) { return; }
+
+			_node->instanceIndex = _data.instanceCount++;
+
+			for(auto &primitive : _node->mesh.primitives)
+			{
+				primitive.indexParams.instanceCount	= 1;
+				primitive.indexParams.firstInstance	= _node->instanceIndex;
+			}
+		});
+	}
+
+	void Model::setCullRecord(
+		Data						&_data,
+		const Primitive	&_primitive,
+		CullMode				_mode,
+		const glm::mat4	&_nodeMtx,
+		uint32_t				_instanceCount
+	) noexcept
+	{
+		const auto &idxParams	= _primitive.indexParams;
+		const auto lod				= _primitive.getLod();
+		const auto isTwoSided	= _primitive.matIndex < static_cast<int>(_data.materials.size()) &&
+														_data.materials[_primitive.matIndex].doubleSided;
+
+		_data.cullRecords[_primitive.cullIndex] = {
+			_nodeMtx, _mode,
+			lod.firstIndex, lod.idxCount, idxParams.vtxOffset,
+			_instanceCount, idxParams.firstInstance,
+			_primitive.firstMeshlet, isTwoSided ? 1u : 0u
+		};
+	}
+
+	uint32_t Model::cullInstances(Data &_data) noexcept
+	{
+		if(!_data.instances) { return 0; }
+
+		auto drawCount = 0u;
+
+		for(const auto &group : _data.instanceGroups)
+		{
+			auto &primitives		= group.nodes[0]->mesh.primitives;
+			auto visibleCount		= 0u;
+
+			// directly drawn primitives (recorded instance count): the buffer keeps every member
+			const auto isIndirect = _data.cullRecords && std::all_of(
+				primitives.begin(), primitives.end(), [](const Primitive &_primitive) { return _primitive.meshletCount > 0; }
+			);
+
+			if(!isIndirect) { continue; }
+
+			// hidden members keep no slot (matrices written by updateInstances)
+			for(auto m = 0u; m < group.nodes.size(); ++m)
+			{
+				group.nodes[m]->instanceIndex = group.isVisible[m] ? group.firstInstance + visibleCount++ : s_noInstance;
+			}
+
+			// whole (LOD) range: clusters can't be culled per instance with shared draw commands
+			for(const auto &primitive : primitives)
+			{
+				if(visibleCount == 0)
+				{
+					setCullRecord(_data, primitive, CullMode::CULLED);
+					continue;
+				}
+
+				setCullRecord(_data, primitive, CullMode::RANGE, glm::mat4(1.0f), visibleCount);
+
+				drawCount++;
+			}
+		}
+
+		return drawCount;
+	}
+
+	Model::Frustum Model::getFrustum(const glm::mat4 &_view, const glm::mat4 &_perspective) noexcept
+	{
+		const auto viewProj = _perspective * _view;
+
+		// frustum planes (Gribb & Hartmann), depth range [0, 1]
+		const auto row = [&](int _r) { return glm::vec4(viewProj[0][_r], viewProj[1][_r], viewProj[2][_r], viewProj[3][_r]); };
+
+		Frustum frustum;
+
+		frustum.planes = {
+			row(3) + row(0), row(3) - row(0),
+			row(3) + row(1), row(3) - row(1),
+			row(2),					 row(3) - row(2)
+		};
+		frustum.eye = glm::vec3(glm::inverse(_view)[3]);
+
+		for(auto &plane : frustum.planes) { plane /= glm::length(glm::vec3(plane)); }
+
+		return frustum;
+	}
+
+	void Model::setCullView(Data &_data, const Frustum &_frustum) noexcept
+	{
+		if(!_data.cullView) { return; }
+
+		*_data.cullView = { _frustum.planes, glm::vec4(_frustum.eye, 1.0f) };
+	}
+
+	void Model::cullClusters(
+		Data						&_data,
+		const Frustum		&_frustum
+	) noexcept
+	{
+		if(!_data.cullRecords) { return; }
+
+		uint32_t drawCount = 0;
+
+		setCullView(_data, _frustum);
+		resetInstances(_data);
+
+		forEachNode(_data.nodes, [&](const NodePtr &_node)
+		{
+			const auto nodeMtx = getNodeMatrix(_node);
+
+			for(const auto &primitive : _node->mesh.primitives)
+			{
+				if(_node->instanceGroup < 0)
+				{
+					drawCount += cullPrimitive(_data, nodeMtx, primitive, _frustum);
+				}
+				else if(_frustum.isInside(glm::vec3(nodeMtx * glm::vec4(primitive.center, 1.0f)), primitive.radius * getMaxScale(nodeMtx)))
+				{
+					setInstanceVisible(_data, *_node);
+				}
+			}
+		});
+
+		drawCount += cullInstances(_data);
+
+		TRACE_LOG("Cluster culling: %u primitives drawn (%zu meshlets)", drawCount, _data.meshlets.size());
+	}
+
+	uint32_t Model::cullPrimitive(
+		Data						&_data,
+		const glm::mat4	&_nodeMtx,
+		const Primitive	&_primitive,
+		const Frustum		&_frustum,
+		bool						_isVisible
+	) noexcept
+	{
+		if(!_data.cullRecords || _primitive.meshletCount == 0) { return 0; }
+
+		const auto isCulled = !_isVisible ||
+			!_frustum.isInside(glm::vec3(_nodeMtx * glm::vec4(_primitive.center, 1.0f)), _primitive.radius * getMaxScale(_nodeMtx));
+
+		if(isCulled)
+		{
+			setCullRecord(_data, _primitive, CullMode::CULLED);
+			return 0;
+		}
+
+		// LOD 0: per meshlet culling (meshlet_culling.comp)
+		setCullRecord(
+			_data, _primitive,
+			_primitive.lodIndex > 0 ? CullMode::RANGE : CullMode::MESHLETS,
+			_nodeMtx, _primitive.indexParams.instanceCount
+		);
+
+		return 1;
+	}
+
+	void Model::destroy(const VkDevice &_logicalDevice, Data &_data, GeometryArena::Data &_arena) noexcept
+	{
+		GeometryArena::free(_arena, Buffer::Type::VERTEX,	_data.vtxRange);
+		GeometryArena::free(_arena, Buffer::Type::INDEX,	_data.idxRange);
+
+		if(_data.instanceBuffer != VK_NULL_HANDLE)
+		{
+			Device::unmapMemory(_logicalDevice, _data.instanceMemory);
+
+			Buffer::destroy		(_logicalDevice, _data.instanceBuffer);
+			Device::freeMemory(_logicalDevice, _data.instanceMemory);
+
+			_data.instanceBuffer	= VK_NULL_HANDLE;
+			_data.instanceMemory	= VK_NULL_HANDLE;
+			_data.instances				= nullptr;
+		}
+
+		if(_data.drawCmdBuffer == VK_NULL_HANDLE) { return; }
+
+		Device::unmapMemory(_logicalDevice, _data.cullRecordMemory);
+
+		Buffer::destroy		(_logicalDevice, _data.meshletBuffer);
+		Buffer::destroy		(_logicalDevice, _data.cullRecordBuffer);
+		Buffer::destroy		(_logicalDevice, _data.drawCmdBuffer);
+		Device::freeMemory(_logicalDevice, _data.meshletMemory);
+		Device::freeMemory(_logicalDevice, _data.cullRecordMemory);
+		Device::freeMemory(_logicalDevice, _data.drawCmdMemory);
+
+		_data.meshletBuffer			= VK_NULL_HANDLE;
+		_data.meshletMemory			= VK_NULL_HANDLE;
+		_data.cullRecordBuffer	= VK_NULL_HANDLE;
+		_data.cullRecordMemory	= VK_NULL_HANDLE;
+		_data.cullView					= nullptr;
+		_data.cullRecords				= nullptr;
+		_data.drawCmdBuffer			= VK_NULL_HANDLE;
+		_data.drawCmdMemory			= VK_NULL_HANDLE;
+	}
+}
@@ -3,6 +3,30 @@
 
 namespace vk
 {
+	void Pipeline::createComputePipeline(
+		const VkDevice													&_logicalDevice,
+		const VkPipelineCache										&_cache,
+		const VkPipelineLayout									&_layout,
+		const VkPipelineShaderStageCreateInfo		&_shaderStage,
+		VkPipeline															&_pipeline
+	) noexcept
+	{
+		VkComputePipelineCreateInfo pipelineInfo = {};
+		pipelineInfo.sType	= VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.stage	= _shaderStage;
+		pipelineInfo.layout	= _layout;
+
+		auto result = vkCreateComputePipelines(
+			_logicalDevice,
+			_cache,
+			1,
+			&pipelineInfo,
+			nullptr,
+			&_pipeline
+		);
+		ASSERT_VK(result, "Failed to create compute pipeline");
+	}
+
 	void Pipeline::destroy(
 		const VkDevice							&_logicalDevice,
 		const VkPipeline						&_pipeline,
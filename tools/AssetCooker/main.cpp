@@ -0,0 +1,246 @@
+#include <thread>
+#include <atomic>
+#include <filesystem>
+
+#include "AssetHelper.h"
+
+// Offline Asset Cooker
+// glTF + source images -> scene cache bundles (flattened/processed geometry, deduplicated materials)
+// + mipmapped ktx textures. Incremental by content hash, cooks in parallel.
+
+namespace fs = std::filesystem;
+
+struct CookJob
+{
+	std::string								fileName;
+	std::string								textureDir;
+	vk::Model::Data						modelData;
+	std::vector<std::string>	textureUris;
+	std::vector<std::string>	dependencies;
+	std::map<std::string, uint64_t>	manifest; // texture source uri -> content hash (last cook)
+};
+
+static const auto TEXTURE_MANIFEST = ".cooked";
+
+static void runJobs(size_t _jobCount, unsigned _threadCount, const std::function<void(size_t)> &_job) noexcept
+{
+	std::atomic<size_t>				next { 0 };
+	std::vector<std::thread>	workers;
+
+	const auto worker = [&]()
+	{
+		for(auto j = next++; j < _jobCount; j = next++) { _job(j); }
+	};
+
+	for(auto t = 1u; t < std::min<size_t>(_threadCount, _jobCount); ++t)
+	{
+		workers.emplace_back(worker);
+	}
+
+	worker();
+
+	for(auto &thread : workers) { thread.join(); }
+}
+
+static void readManifest(const std::string &_textureDir, std::map<std::string, uint64_t> &_manifest) noexcept
+{
+	std::ifstream file(_textureDir + TEXTURE_MANIFEST);
+	std::string		uri;
+	uint64_t			hash;
+
+	while(file >> hash >> uri) { _manifest[uri] = hash; }
+}
+
+static void writeManifest(const std::string &_textureDir, const std::map<std::string, uint64_t> &_manifest) noexcept
+{
+	std::ofstream file(_textureDir + TEXTURE_MANIFEST, std::ios::trunc);
+
+	for(const auto &[uri, hash] : _manifest) { file << hash << " " << uri << "\n"; }
+}
+
+// every texture of the last cook still matches its source (the scene cache only hashes the glTF & its buffers); empty:
+// never cooked (or no texture at all, recooked every time)
+static bool isManifestValid(const std::string &_textureDir, const std::map<std::string, uint64_t> &_manifest) noexcept
+{
+	return !_manifest.empty() && std::all_of(_manifest.begin(), _manifest.end(), [&](const auto &_entry)
+	{
+		const auto &[uri, hash] = _entry;
+		const auto cookedUri = fs::path(uri).replace_extension(".ktx").generic_string();
+
+		return hash != 0 && fs::exists(_textureDir + cookedUri) &&
+					 SceneCache::hashSources(_textureDir + uri, {}) == hash;
+	});
+}
+
+// non-ktx source images -> mipmapped ktx (RGBA, matching the runtime upload format)
+static bool cookTexture(
+	const std::string	&_textureDir,
+	const std::string	&_sourceUri,
+	uint64_t					&_hash,
+	std::string				&_cookedUri
+) noexcept
+{
+	const auto sourceFile = _textureDir + _sourceUri;
+
+	_cookedUri = fs::path(_sourceUri).replace_extension(".ktx").generic_string();
+
+	const auto prevHash = _hash;
+	_hash = SceneCache::hashSources(sourceFile, {});
+
+	if(_hash == prevHash && fs::exists(_textureDir + _cookedUri)) { return true; }
+
+	const auto toktx = std::getenv("TOKTX") ? std::getenv("TOKTX") : "toktx";
+	const auto command =
+		std::string(toktx) + " --genmipmap --target_type RGBA " +
+		"\"" + _textureDir + _cookedUri + "\" \"" + sourceFile + "\"";
+
+	INFO_LOG("Cooking texture %s...", sourceFile.c_str());
+
+	if(std::system(command.c_str()) != 0)
+	{
+		ERROR_LOG("Failed to cook texture %s (is toktx installed?)", sourceFile.c_str());
+		_hash = 0;
+
+		return false;
+	}
+
+	return true;
+}
+
+// AssetCooker [asset path] [thread count] [scale]
+int main(int _argc, char *_argv[])
+{
+	auto assetPath = std::string(_argc > 1 ? _argv[1] : constants::ASSET_PATH);
+	const auto threadCount = _argc > 2
+		? static_cast<unsigned>(std::max(1, std::atoi(_argv[2])))
+		: std::max(1u, std::thread::hardware_concurrency());
+
+	// part of the scene caches' key: the scale the renderer loads the models with (Base::loadAsset's, 1 by default)
+	const auto scale = _argc > 3 ? static_cast<float>(std::atof(_argv[3])) : 1.0f;
+
+	if(assetPath.back() != '/') { assetPath += '/'; }
+
+	const auto modelsPath		= assetPath + "models/";
+	const auto texturesPath	= assetPath + "textures/";
+
+	if(scale <= 0.0f)
+	{
+		FATAL_ERROR_LOG("Invalid scale: %s", _argv[3]);
+	}
+
+	if(!fs::is_directory(modelsPath))
+	{
+		FATAL_ERROR_LOG("Models directory not found: %s", modelsPath.c_str());
+	}
+
+	TIMER(start);
+
+	std::vector<CookJob> jobs;
+
+	for(const auto &entry : fs::directory_iterator(modelsPath))
+	{
+		const auto &path = entry.path();
+
+		if(path.extension() != ".gltf") { continue; }
+
+		const auto fileName		= path.generic_string();
+		const auto textureDir	= texturesPath + path.stem().generic_string() + "/";
+
+		if(SceneCache::isValid(fileName, scale))
+		{
+			std::map<std::string, uint64_t> manifest;
+			readManifest(textureDir, manifest);
+
+			if(isManifestValid(textureDir, manifest))
+			{
+				INFO_LOG("%s is up to date", fileName.c_str());
+				continue;
+			}
+
+			INFO_LOG("%s textures changed", fileName.c_str());
+		}
+
+		CookJob job;
+		job.fileName		= fileName;
+		job.textureDir	= textureDir;
+
+		jobs.push_back(std::move(job));
+	}
+
+	// Geometry, nodes & materials
+
+	runJobs(jobs.size(), threadCount, [&](size_t _j)
+	{
+		auto &job = jobs[_j];
+
+		INFO_LOG("Cooking %s...", job.fileName.c_str());
+
+		AssetHelper::loadScene(job.fileName, scale, job.modelData, job.textureUris, job.dependencies);
+		readManifest(job.textureDir, job.manifest);
+	});
+
+	// Textures
+
+	std::vector<std::pair<size_t, size_t>>	textureJobs;	// job, texture index
+	std::vector<uint64_t>										textureHashes;
+
+	for(auto j = 0u; j < jobs.size(); ++j)
+	{
+		auto &job = jobs[j];
+
+		for(auto t = 0u; t < job.textureUris.size(); ++t)
+		{
+			// already ktx: loaded as is, tracked for the next cook's validity check only
+			if(vk::Texture::isKtx(job.textureUris[t]))
+			{
+				job.manifest[job.textureUris[t]] = SceneCache::hashSources(job.textureDir + job.textureUris[t], {});
+				continue;
+			}
+
+			const auto cached = job.manifest.find(job.textureUris[t]);
+
+			textureJobs.emplace_back(j, t);
+			textureHashes.push_back(cached != job.manifest.end() ? cached->second : 0);
+		}
+	}
+
+	std::vector<std::string> cookedUris(textureJobs.size());
+
+	runJobs(textureJobs.size(), threadCount, [&](size_t _t)
+	{
+		const auto &[j, t] = textureJobs[_t];
+		const auto &job = jobs[j];
+
+		cookTexture(job.textureDir, job.textureUris[t], textureHashes[_t], cookedUris[_t]);
+	});
+
+	for(auto t = 0u; t < textureJobs.size(); ++t)
+	{
+		const auto &[j, tex] = textureJobs[t];
+		auto &job = jobs[j];
+
+		job.manifest[job.textureUris[tex]] = textureHashes[t];
+
+		if(textureHashes[t] != 0) { job.textureUris[tex] = cookedUris[t]; }
+	}
+
+	// Bundles
+
+	runJobs(jobs.size(), threadCount, [&](size_t _j)
+	{
+		const auto &job = jobs[_j];
+
+		if(!job.manifest.empty()) { writeManifest(job.textureDir, job.manifest); }
+
+		SceneCache::save(job.fileName, scale, job.dependencies, job.textureUris, job.modelData);
+	});
+
+	TIMER(end);
+
+	INFO_LOG(
+		"Cooked %zu model(s) & %zu texture(s) in %.2f ms (%u threads)",
+		jobs.size(), textureJobs.size(), TIME_DIFF(start, end), threadCount
+	);
+
+	return EXIT_SUCCESS;
+}